@@ -0,0 +1,50 @@
+// Circle Shader
+// Circles are drawn as quads and shaped in the fragment shader by the distance from their center
+
+#type vertex
+#version 450 core
+
+layout(location = 0) in vec3 a_WorldPosition;
+layout(location = 1) in vec4 a_Color;
+layout(location = 2) in vec2 a_LocalPosition;
+layout(location = 3) in float a_Thickness;
+layout(location = 4) in float a_Fade;
+
+out vec4 v_Color;
+out vec2 v_LocalPosition;
+out float v_Thickness;
+out float v_Fade;
+
+#include "include/Camera.glsl"
+
+void main()
+{
+	v_Color = a_Color;
+	v_LocalPosition = a_LocalPosition;
+	v_Thickness = a_Thickness;
+	v_Fade = a_Fade;
+	gl_Position = u_ViewProjection * vec4(a_WorldPosition, 1.f);
+}
+
+#type fragment
+#version 450 core
+
+in vec4 v_Color;
+in vec2 v_LocalPosition;
+in float v_Thickness;
+in float v_Fade;
+
+layout(location = 0) out vec4 color;
+
+void main()
+{
+	// Distance to the outer edge relative to the radius, positive inside
+	float distance = 1.f - length(v_LocalPosition);
+	// Never fade over less than a pixel so that edges stay antialiased
+	float fade = max(v_Fade, fwidth(distance));
+	float alpha = smoothstep(0.f, fade, distance) * (1.f - smoothstep(v_Thickness, v_Thickness + fade, distance));
+	if (alpha == 0.f)
+		discard;
+
+	color = vec4(v_Color.rgb, v_Color.a * alpha);
+}
@@ -1,12 +1,12 @@
 // Float Color Shader
 
 #type vertex
-#version 330 core
+#version 450 core
 
 layout(location = 0) in vec3 a_Position;
 
-uniform mat4 u_ViewProjection;
-uniform mat4 u_Transform;
+#include "include/Camera.glsl"
+#include "include/Draw.glsl"
 
 void main()
 {
@@ -14,11 +14,14 @@ void main()
 }
 
 #type fragment
-#version 330 core
+#version 450 core
 
 layout(location = 0) out vec4 color;
 
-uniform vec4 u_Color;
+layout(std140, binding = 2) uniform Material
+{
+	vec4 u_Color;
+};
 
 void main()
 {
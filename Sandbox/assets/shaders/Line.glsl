@@ -0,0 +1,29 @@
+// Line Shader
+
+#type vertex
+#version 450 core
+
+layout(location = 0) in vec3 a_Position;
+layout(location = 1) in vec4 a_Color;
+
+out vec4 v_Color;
+
+#include "include/Camera.glsl"
+
+void main()
+{
+	v_Color = a_Color;
+	gl_Position = u_ViewProjection * vec4(a_Position, 1.f);
+}
+
+#type fragment
+#version 450 core
+
+in vec4 v_Color;
+
+layout(location = 0) out vec4 color;
+
+void main()
+{
+	color = v_Color;
+}
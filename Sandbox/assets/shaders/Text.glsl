@@ -0,0 +1,51 @@
+// Text Shader
+// Glyphs are sampled from a signed distance field atlas, see Font
+
+#type vertex
+#version 450 core
+
+layout(location = 0) in vec3 a_Position;
+layout(location = 1) in vec4 a_Color;
+layout(location = 2) in vec2 a_TexCoord;
+layout(location = 3) in float a_TexIndex;
+layout(location = 4) in float a_TilingFactor;
+
+out vec4 v_Color;
+out vec2 v_TexCoord;
+// Every vertex of a quad has the same index, it must not be interpolated
+flat out int v_TexIndex;
+
+#include "include/Camera.glsl"
+
+void main()
+{
+	v_Color = a_Color;
+	v_TexCoord = a_TexCoord;
+	v_TexIndex = int(round(a_TexIndex));
+	gl_Position = u_ViewProjection * vec4(a_Position, 1.f);
+}
+
+#type fragment
+#version 450 core
+
+in vec4 v_Color;
+in vec2 v_TexCoord;
+flat in int v_TexIndex;
+
+layout(location = 0) out vec4 color;
+
+// ZE_MAX_TEXTURE_SLOTS is injected by the engine
+layout(binding = 0) uniform sampler2D u_Textures[ZE_MAX_TEXTURE_SLOTS];
+
+void main()
+{
+	// Distance to the outline is stored in alpha with 0.5 on the outline
+	float distance = texture(u_Textures[v_TexIndex], v_TexCoord).a;
+	// Smooth over about a pixel on screen whatever the text size is
+	float smoothing = max(0.5f * fwidth(distance), 1e-4f);
+	float alpha = smoothstep(0.5f - smoothing, 0.5f + smoothing, distance);
+	if (alpha == 0.f)
+		discard;
+
+	color = vec4(v_Color.rgb, v_Color.a * alpha);
+}
@@ -1,34 +1,46 @@
 // Basic Texture Shader
 
 #type vertex
-#version 330 core
+#version 450 core
 
 layout(location = 0) in vec3 a_Position;
-layout(location = 1) in vec2 a_TexCoord;
+layout(location = 1) in vec4 a_Color;
+layout(location = 2) in vec2 a_TexCoord;
+layout(location = 3) in float a_TexIndex;
+layout(location = 4) in float a_TilingFactor;
 
+out vec4 v_Color;
 out vec2 v_TexCoord;
+// Every vertex of a quad has the same index, it must not be interpolated
+flat out int v_TexIndex;
+out float v_TilingFactor;
 
-uniform mat4 u_ViewProjection;
-uniform mat4 u_Transform;
+#include "include/Camera.glsl"
 
 void main()
 {
-	gl_Position = u_ViewProjection * u_Transform * vec4(a_Position, 1.f);
+	v_Color = a_Color;
 	v_TexCoord = a_TexCoord;
+	v_TexIndex = int(round(a_TexIndex));
+	v_TilingFactor = a_TilingFactor;
+	gl_Position = u_ViewProjection * vec4(a_Position, 1.f);
 }
 
 #type fragment
-#version 330 core
+#version 450 core
 
+in vec4 v_Color;
 in vec2 v_TexCoord;
+flat in int v_TexIndex;
+in float v_TilingFactor;
 
 layout(location = 0) out vec4 color;
 
-uniform vec4 u_Color;
-uniform float u_TilingFactor;
-uniform sampler2D u_Texture;
+// ZE_MAX_TEXTURE_SLOTS is injected by the engine
+// Samplers are bound to texture units in the shader so that they survive hot-reloading
+layout(binding = 0) uniform sampler2D u_Textures[ZE_MAX_TEXTURE_SLOTS];
 
 void main()
 {
-	color = texture(u_Texture, v_TexCoord * u_TilingFactor) * u_Color;
+	color = texture(u_Textures[v_TexIndex], v_TexCoord * v_TilingFactor) * v_Color;
 }
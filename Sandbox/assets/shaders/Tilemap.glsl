@@ -0,0 +1,40 @@
+// Tilemap Shader
+// Vertices of a chunk are in tile units of the whole tilemap, placed in the world by u_Transform, see Tilemap
+
+#type vertex
+#version 450 core
+
+layout(location = 0) in vec2 a_Position;
+layout(location = 1) in vec2 a_TexCoord;
+
+out vec2 v_TexCoord;
+
+#include "include/Camera.glsl"
+#include "include/Draw.glsl"
+
+void main()
+{
+	v_TexCoord = a_TexCoord;
+	gl_Position = u_ViewProjection * u_Transform * vec4(a_Position, 0.f, 1.f);
+}
+
+#type fragment
+#version 450 core
+
+in vec2 v_TexCoord;
+
+layout(location = 0) out vec4 color;
+
+layout(binding = 0) uniform sampler2D u_Tileset;
+
+layout(std140, binding = 2) uniform Material
+{
+	vec4 u_TintColor;
+};
+
+void main()
+{
+	color = texture(u_Tileset, v_TexCoord) * u_TintColor;
+	if (color.a == 0.f)
+		discard;
+}
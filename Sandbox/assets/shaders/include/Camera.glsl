@@ -0,0 +1,6 @@
+// Camera data shared by all shaders, uploaded once per scene
+
+layout(std140, binding = 0) uniform Camera
+{
+	mat4 u_ViewProjection;
+};
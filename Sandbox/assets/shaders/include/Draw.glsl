@@ -0,0 +1,6 @@
+// Per-draw data pushed by Renderer::Submit()
+
+layout(std140, binding = 1) uniform Draw
+{
+	mat4 u_Transform;
+};
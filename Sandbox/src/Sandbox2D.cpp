@@ -4,11 +4,13 @@
 
 #include <imgui/imgui.h>
 
+#include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
 Sandbox2D::Sandbox2D()
 	: Layer("Sandbox2D")
 	, m_CameraController(1280.0f / 720.0f)
+	, m_ParticleSystem(500000)
 {
 }
 
@@ -17,6 +19,112 @@ void Sandbox2D::OnAttach()
 	ZE_PROFILE_FUNCTION();
 
 	m_CheckerboardTexture = ZeoEngine::Texture2D::Create("assets/textures/Checkerboard_Alpha.png");
+	m_Font = ZeoEngine::Font::Create("assets/fonts/Lato-Regular.ttf");
+
+	// A fountain of sparks fading from yellow to orange
+	m_ParticleProps.Position = { 0.0f, -1.5f };
+	m_ParticleProps.Velocity = { 0.0f, 2.0f };
+	m_ParticleProps.VelocityVariation = { 3.0f, 1.0f };
+	m_ParticleProps.ColorBegin = { 254 / 255.0f, 212 / 255.0f, 123 / 255.0f, 1.0f };
+	m_ParticleProps.ColorEnd = { 254 / 255.0f, 109 / 255.0f, 41 / 255.0f, 0.0f };
+	m_ParticleProps.SizeBegin = 0.05f;
+	m_ParticleProps.SizeVariation = 0.03f;
+	m_ParticleProps.SizeEnd = 0.0f;
+	m_ParticleProps.LifeTime = 1.0f;
+	// Treat the checkerboard as a 8x8 sprite sheet and pick a 2x2 region of it
+	m_CheckerboardCell = ZeoEngine::SubTexture2D::CreateFromCoords(m_CheckerboardTexture, { 3.0f, 3.0f }, { 128.0f, 128.0f }, { 2.0f, 2.0f });
+
+	{
+		auto background = m_Scene.CreateEntity("Background");
+		auto& transform = background.GetComponent<ZeoEngine::TransformComponent>();
+		transform.SetTranslation({ 0.0f, 0.0f, -0.1f });
+		transform.SetScale({ 10.0f, 10.0f });
+		auto& sprite = background.AddComponent<ZeoEngine::SpriteRendererComponent>();
+		sprite.Texture = m_CheckerboardTexture;
+		sprite.TilingFactor = 10.0f;
+	}
+	{
+		// A 1024x1024 tile world costs only a few draws, one per chunk in view
+		auto tilemap = ZeoEngine::Tilemap::Create(1024, 1024, m_CheckerboardTexture, { 128.0f, 128.0f });
+		for (uint32_t y = 0; y < tilemap->GetHeight(); ++y)
+		{
+			for (uint32_t x = 0; x < tilemap->GetWidth(); ++x)
+			{
+				tilemap->SetTile(x, y, static_cast<uint16_t>((x * 7 + y * 13) % tilemap->GetTileCount()));
+			}
+		}
+		auto world = m_Scene.CreateEntity("Tilemap");
+		auto& transform = world.GetComponent<ZeoEngine::TransformComponent>();
+		transform.SetTranslation({ -128.0f, -128.0f, -0.2f });
+		transform.SetScale({ 0.25f, 0.25f });
+		world.AddComponent<ZeoEngine::TilemapComponent>().Map = tilemap;
+	}
+	{
+		auto rotatedSquare = m_Scene.CreateEntity("Rotated Square");
+		auto& transform = rotatedSquare.GetComponent<ZeoEngine::TransformComponent>();
+		transform.SetTranslation({ -0.75f, 0.0f, 0.0f });
+		transform.SetRotation(glm::radians(45.0f));
+		transform.SetScale({ 0.5f, 0.5f });
+		rotatedSquare.AddComponent<ZeoEngine::SpriteRendererComponent>().Color = { 0.1f, 0.2f, 0.3f, 1.0f };
+		m_LabelledEntities.push_back(rotatedSquare);
+	}
+	{
+		m_SquareEntity = m_Scene.CreateEntity("Square");
+		m_SquareEntity.GetComponent<ZeoEngine::TransformComponent>().SetTranslation({ 0.75f, 0.0f, 0.0f });
+		m_SquareEntity.AddComponent<ZeoEngine::SpriteRendererComponent>().Color = m_SquareColor;
+		m_LabelledEntities.push_back(m_SquareEntity);
+	}
+	{
+		auto cell = m_Scene.CreateEntity("Checkerboard Cell");
+		auto& transform = cell.GetComponent<ZeoEngine::TransformComponent>();
+		transform.SetTranslation({ 0.0f, -1.0f, 0.0f });
+		transform.SetScale({ 0.5f, 0.5f });
+		cell.AddComponent<ZeoEngine::SpriteRendererComponent>().SubTexture = m_CheckerboardCell;
+	}
+	{
+		// Only the pivot is rotated every frame, the satellite follows through the transform hierarchy
+		auto pivot = m_Scene.CreateEntity("Orbit Pivot");
+		pivot.GetComponent<ZeoEngine::TransformComponent>().SetTranslation({ 0.75f, 0.0f, 0.0f });
+		pivot.AddComponent<SpinComponent>().Speed = 1.0f;
+
+		auto satellite = m_Scene.CreateEntity("Satellite");
+		auto& transform = satellite.GetComponent<ZeoEngine::TransformComponent>();
+		transform.SetTranslation({ 0.8f, 0.0f, 0.01f });
+		transform.SetScale({ 0.2f, 0.2f });
+		satellite.AddComponent<ZeoEngine::SpriteRendererComponent>().Color = { 0.9f, 0.8f, 0.2f, 1.0f };
+		m_Scene.SetParent(satellite, pivot);
+		m_LabelledEntities.push_back(satellite);
+	}
+	{
+		auto ground = m_Scene.CreateEntity("Ground");
+		auto& transform = ground.GetComponent<ZeoEngine::TransformComponent>();
+		transform.SetTranslation({ 0.0f, -4.9f, 0.0f });
+		transform.SetScale({ 10.0f, 0.2f });
+		ground.AddComponent<ZeoEngine::SpriteRendererComponent>().Color = { 0.4f, 0.3f, 0.2f, 1.0f };
+		ground.AddComponent<ZeoEngine::Rigidbody2DComponent>();
+		ground.AddComponent<ZeoEngine::BoxCollider2DComponent>();
+	}
+
+	// These two systems touch different components so they run concurrently, and each of them splits its view across workers
+	m_Scene.AddSystem("Spin", ZeoEngine::SystemAccess().Read<SpinComponent>().Write<ZeoEngine::TransformComponent>(),
+		[](ZeoEngine::Registry& registry, ZeoEngine::DeltaTime dt)
+		{
+			ZeoEngine::ParallelEach(registry.View<const SpinComponent, ZeoEngine::TransformComponent>(),
+				[dt](ZeoEngine::EntityId entity, const SpinComponent& spin, ZeoEngine::TransformComponent& transform)
+				{
+					transform.SetRotation(transform.GetRotation() + spin.Speed * dt);
+				});
+		});
+	m_Scene.AddSystem("Pulse", ZeoEngine::SystemAccess().Read<SpinComponent>().Write<ZeoEngine::SpriteRendererComponent>(),
+		[time = 0.0f](ZeoEngine::Registry& registry, ZeoEngine::DeltaTime dt) mutable
+		{
+			time += dt;
+			ZeoEngine::ParallelEach(registry.View<const SpinComponent, ZeoEngine::SpriteRendererComponent>(),
+				[time](ZeoEngine::EntityId entity, const SpinComponent& spin, ZeoEngine::SpriteRendererComponent& sprite)
+				{
+					sprite.Color.g = 0.4f + 0.3f * glm::sin(time * spin.Speed);
+				});
+		});
 }
 
 void Sandbox2D::OnDetach()
@@ -32,6 +140,15 @@ void Sandbox2D::OnUpdate(ZeoEngine::DeltaTime dt)
 	// Update
 	m_CameraController.OnUpdate(dt);
 
+	ZeoEngine::Renderer2D::ResetStats();
+
+	{
+		ZE_PROFILE_SCOPE("Particles");
+
+		m_ParticleSystem.Emit(m_ParticleProps, static_cast<uint32_t>(m_ParticlesPerFrame));
+		m_ParticleSystem.OnUpdate(dt);
+	}
+
 	// Render
 	{
 		ZE_PROFILE_SCOPE("Renderer Prep");
@@ -43,12 +160,37 @@ void Sandbox2D::OnUpdate(ZeoEngine::DeltaTime dt)
 	{
 		ZE_PROFILE_SCOPE("Renderer Draw");
 
-		ZeoEngine::Renderer2D::BeginScene(m_CameraController.GetCamera());
+		m_Scene.OnUpdate(dt, m_CameraController.GetCamera());
+
+		if (m_ParticleSystem.GetCount() > 0)
+		{
+			ZeoEngine::Renderer2D::BeginScene(m_CameraController.GetCamera());
+			m_ParticleSystem.OnRender(0.2f);
+			ZeoEngine::Renderer2D::EndScene();
+		}
+	}
 
-		ZeoEngine::Renderer2D::DrawRotatedQuad({ -0.75f, 0.0f }, { 0.5f, 0.5f }, glm::radians(45.0f), { 0.1f, 0.2f, 0.3f, 1.0f });
-		ZeoEngine::Renderer2D::DrawQuad({ 0.75f, 0.0f }, { 1.0f, 1.0f }, { 0.3f, 0.2f, 0.1f, 1.0f });
-		ZeoEngine::Renderer2D::DrawQuad({ 0.0f, 0.0f, -0.1f }, { 10.0f, 10.0f }, m_CheckerboardTexture, 10.f);
+	if (m_bShowText)
+	{
+		UpdateText(dt);
+	}
 
+	if (m_bShowDebugOverlay)
+	{
+		ZE_PROFILE_SCOPE("Debug Overlay");
+
+		ZeoEngine::Renderer2D::BeginScene(m_CameraController.GetCamera());
+		// One unit grid over the background
+		const glm::vec4 gridColor = { 0.3f, 0.8f, 0.3f, 1.0f };
+		for (int i = -5; i <= 5; ++i)
+		{
+			const float offset = static_cast<float>(i);
+			ZeoEngine::Renderer2D::DrawLine({ offset, -5.0f, 0.5f }, { offset, 5.0f, 0.5f }, gridColor);
+			ZeoEngine::Renderer2D::DrawLine({ -5.0f, offset, 0.5f }, { 5.0f, offset, 0.5f }, gridColor);
+		}
+		ZeoEngine::Renderer2D::DrawRect(glm::vec3(0.75f, 0.0f, 0.5f), { 1.0f, 1.0f }, { 1.0f, 0.5f, 0.0f, 1.0f });
+		// Orbit of the satellite
+		ZeoEngine::Renderer2D::DrawCircle({ 0.75f, 0.0f, 0.5f }, 0.8f, { 0.9f, 0.8f, 0.2f, 1.0f }, 0.02f);
 		ZeoEngine::Renderer2D::EndScene();
 	}
 }
@@ -59,9 +201,185 @@ void Sandbox2D::OnImGuiRender()
 
 	ImGui::Begin("Settings");
 
-	ImGui::ColorEdit4("SquareColor", glm::value_ptr(m_SquareColor));
+	auto stats = ZeoEngine::Renderer2D::GetStats();
+	ImGui::Text("Renderer2D Stats:");
+	ImGui::Text("Draw Calls: %d", stats.DrawCalls);
+	ImGui::Text("Quads: %d", stats.QuadCount);
+	ImGui::Text("Culled Quads: %d", stats.CulledQuadCount);
+	ImGui::Text("Translucent Quads: %d", stats.TranslucentQuadCount);
+	ImGui::Text("Circles: %d", stats.CircleCount);
+	ImGui::Text("Lines: %d (%d culled)", stats.LineCount, stats.CulledLineCount);
+	ImGui::Text("Tiles: %d in %d chunks", stats.TileCount, stats.TilemapChunkCount);
+	ImGui::Text("Vertices: %d", stats.GetTotalVertexCount());
+	ImGui::Text("Indices: %d", stats.GetTotalIndexCount());
+	ImGui::Text("State Changes: %d issued, %d skipped", stats.StateChangesIssued, stats.StateChangesSkipped);
+
+	ImGui::Text("Entities: %d", m_Scene.GetEntityCount());
+
+	bool bUseSpatialIndex = m_Scene.IsSpatialIndexEnabled();
+	if (ImGui::Checkbox("Use Spatial Index", &bUseSpatialIndex))
+	{
+		m_Scene.SetSpatialIndexEnabled(bUseSpatialIndex);
+	}
+	const auto& spatialIndex = m_Scene.GetSpatialIndex();
+	ImGui::Text("Indexed: %d static, %d dynamic", spatialIndex.GetStaticCount(), spatialIndex.GetDynamicCount());
+
+	// Unproject mouse position to pick the sprite under the cursor
+	{
+		auto [mouseX, mouseY] = ZeoEngine::Input::GetMousePosition();
+		auto& window = ZeoEngine::Application::Get().GetWindow();
+		const glm::vec4 ndcPosition = { 2.0f * mouseX / window.GetWidth() - 1.0f, 1.0f - 2.0f * mouseY / window.GetHeight(), 0.0f, 1.0f };
+		const glm::vec4 worldPosition = glm::inverse(m_CameraController.GetCamera().GetViewProjectionMatrix()) * ndcPosition;
+		ZeoEngine::Entity hoveredEntity = m_Scene.PickEntity(glm::vec2(worldPosition));
+		ImGui::Text("Hovered: %s", hoveredEntity ? hoveredEntity.GetComponent<ZeoEngine::TagComponent>().Name.c_str() : "None");
+	}
+
+	if (ImGui::ColorEdit4("SquareColor", glm::value_ptr(m_SquareColor)))
+	{
+		m_SquareEntity.GetComponent<ZeoEngine::SpriteRendererComponent>().Color = m_SquareColor;
+	}
+
+	ImGui::Checkbox("Show Debug Overlay", &m_bShowDebugOverlay);
+	ImGui::Checkbox("Show Labels And Damage Numbers", &m_bShowText);
+	ImGui::Text("Glyphs: %d", stats.GlyphCount);
+
+	// Particles live for a second, so 500k live particles take about 8000 per frame at 60 fps
+	ImGui::SliderInt("Particles Per Frame", &m_ParticlesPerFrame, 0, 10000);
+	ImGui::Text("Particles: %d / %d", m_ParticleSystem.GetCount(), m_ParticleSystem.GetMaxCount());
+
+	// Settled pyramids fall asleep, so they cost nothing but the broadphase sweep until something hits them
+	int physicsPyramidRows = m_PhysicsPyramidRows;
+	if (ImGui::SliderInt("Physics Pyramid Rows", &physicsPyramidRows, 0, 40))
+	{
+		RebuildPhysicsPyramid(physicsPyramidRows);
+	}
+	const auto& physicsStats = m_Scene.GetPhysicsWorld().GetStats();
+	ImGui::Text("Bodies: %d (%d awake in %d islands)", physicsStats.BodyCount, physicsStats.AwakeBodyCount, physicsStats.IslandCount);
+	ImGui::Text("Pairs: %d, Contacts: %d, Steps: %d", physicsStats.PairCount, physicsStats.ContactCount, physicsStats.StepCount);
+
+	int stressGridSize = m_StressGridSize;
+	if (ImGui::SliderInt("Stress Grid Size", &stressGridSize, 0, 400))
+	{
+		RebuildStressGrid(stressGridSize);
+	}
 
 	ImGui::End();
+
+	ZeoEngine::MemoryPanel::OnImGuiRender();
+}
+
+void Sandbox2D::RebuildStressGrid(int gridSize)
+{
+	ZE_PROFILE_FUNCTION();
+
+	for (auto entity : m_StressGridEntities)
+	{
+		m_Scene.DestroyEntity(entity);
+	}
+	m_StressGridEntities.clear();
+
+	m_StressGridSize = gridSize;
+	const float step = 0.1f;
+	const float start = -0.5f * step * gridSize;
+	for (int y = 0; y < gridSize; ++y)
+	{
+		for (int x = 0; x < gridSize; ++x)
+		{
+			auto entity = m_Scene.CreateEntity("Stress Quad");
+			auto& transform = entity.GetComponent<ZeoEngine::TransformComponent>();
+			transform.SetTranslation({ start + x * step, start + y * step, -0.05f });
+			transform.SetScale({ 0.9f * step, 0.9f * step });
+			glm::vec4 color = { static_cast<float>(x) / gridSize, 0.4f, static_cast<float>(y) / gridSize, 0.7f };
+			entity.AddComponent<ZeoEngine::SpriteRendererComponent>().Color = color;
+			entity.AddComponent<SpinComponent>().Speed = 0.5f + static_cast<float>((x + y) % 5);
+			m_StressGridEntities.push_back(entity);
+		}
+	}
+}
+
+void Sandbox2D::UpdateText(ZeoEngine::DeltaTime dt)
+{
+	ZE_PROFILE_FUNCTION();
+
+	// A few hits per second on the square, each number drifting up and fading out over a second
+	const glm::vec2 squarePosition = glm::vec2(m_SquareEntity.GetComponent<ZeoEngine::TransformComponent>().GetWorldTransform()[3]);
+	m_DamageNumberTimer -= dt;
+	if (m_DamageNumberTimer <= 0.0f)
+	{
+		m_DamageNumberTimer += 0.25f;
+		std::uniform_real_distribution<float> offset(-0.4f, 0.4f);
+		std::uniform_int_distribution<int> damage(1, 999);
+		m_DamageNumbers.push_back({ std::to_string(damage(m_DamageRandom)), squarePosition + glm::vec2(offset(m_DamageRandom), offset(m_DamageRandom)), 1.0f });
+	}
+	for (auto& number : m_DamageNumbers)
+	{
+		number.Position.y += 0.5f * dt;
+		number.LifeRemaining -= dt;
+	}
+	m_DamageNumbers.erase(std::remove_if(m_DamageNumbers.begin(), m_DamageNumbers.end(), [](const DamageNumber& number) { return number.LifeRemaining <= 0.0f; }),
+		m_DamageNumbers.end());
+
+	ZeoEngine::Renderer2D::BeginScene(m_CameraController.GetCamera());
+	for (const auto& number : m_DamageNumbers)
+	{
+		ZeoEngine::Renderer2D::DrawString(number.Text, m_Font, { number.Position, 0.4f }, 0.2f, { 1.0f, 0.3f, 0.2f, number.LifeRemaining });
+	}
+	// Labels follow the whole transform of their entity, so the one of the rotated square is rotated and the satellite's orbits with it
+	const float labelSize = 0.3f;
+	for (auto entity : m_LabelledEntities)
+	{
+		const std::string& name = entity.GetComponent<ZeoEngine::TagComponent>().Name;
+		const ZeoEngine::TextLayout& layout = m_Font->GetLayout(name);
+		const glm::vec3 labelOffset = { -0.5f * labelSize * (layout.Min.x + layout.Max.x), 0.6f, 0.4f };
+		const glm::mat4 labelTransform = entity.GetComponent<ZeoEngine::TransformComponent>().GetWorldTransform() *
+			glm::translate(glm::mat4(1.0f), labelOffset) * glm::scale(glm::mat4(1.0f), glm::vec3(labelSize));
+		ZeoEngine::Renderer2D::DrawString(name, m_Font, labelTransform);
+	}
+	ZeoEngine::Renderer2D::EndScene();
+}
+
+void Sandbox2D::RebuildPhysicsPyramid(int rowCount)
+{
+	ZE_PROFILE_FUNCTION();
+
+	for (auto entity : m_PhysicsEntities)
+	{
+		m_Scene.DestroyEntity(entity);
+	}
+	m_PhysicsEntities.clear();
+
+	m_PhysicsPyramidRows = rowCount;
+	if (rowCount == 0)
+		return;
+
+	const float size = 0.2f;
+	const float groundTop = -4.8f;
+	for (int row = 0; row < rowCount; ++row)
+	{
+		for (int i = 0; i < rowCount - row; ++i)
+		{
+			auto entity = m_Scene.CreateEntity("Physics Box");
+			auto& transform = entity.GetComponent<ZeoEngine::TransformComponent>();
+			transform.SetTranslation({ (i - 0.5f * (rowCount - row - 1)) * size * 1.05f, groundTop + (row + 0.5f) * size, 0.02f });
+			transform.SetScale({ size, size });
+			entity.AddComponent<ZeoEngine::SpriteRendererComponent>().Color = { 0.8f, 0.3f + 0.5f * row / rowCount, 0.2f, 1.0f };
+			entity.AddComponent<ZeoEngine::Rigidbody2DComponent>().Type = ZeoEngine::BodyType2D::Dynamic;
+			entity.AddComponent<ZeoEngine::BoxCollider2DComponent>();
+			m_PhysicsEntities.push_back(entity);
+		}
+	}
+	{
+		auto ball = m_Scene.CreateEntity("Physics Ball");
+		auto& transform = ball.GetComponent<ZeoEngine::TransformComponent>();
+		transform.SetTranslation({ 0.3f * size, groundTop + (rowCount + 4.0f) * size, 0.02f });
+		transform.SetScale({ 2.0f * size, 2.0f * size });
+		ball.AddComponent<ZeoEngine::SpriteRendererComponent>().SubTexture = m_CheckerboardCell;
+		ball.AddComponent<ZeoEngine::Rigidbody2DComponent>().Type = ZeoEngine::BodyType2D::Dynamic;
+		auto& collider = ball.AddComponent<ZeoEngine::CircleCollider2DComponent>();
+		collider.Density = 4.0f;
+		collider.Restitution = 0.3f;
+		m_PhysicsEntities.push_back(ball);
+	}
 }
 
 void Sandbox2D::OnEvent(ZeoEngine::Event& event)
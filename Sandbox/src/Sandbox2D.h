@@ -1,7 +1,24 @@
 #pragma once
 
+#include <random>
+
 #include "ZeoEngine.h"
 
+/** Makes stress test quads rotate and pulse. */
+struct SpinComponent
+{
+	/** In radians per second */
+	float Speed = 1.0f;
+};
+
+/** Rises from where it spawned and fades out. */
+struct DamageNumber
+{
+	std::string Text;
+	glm::vec2 Position;
+	float LifeRemaining;
+};
+
 class Sandbox2D : public ZeoEngine::Layer
 {
 public:
@@ -15,13 +32,42 @@ public:
 	virtual void OnImGuiRender() override;
 	virtual void OnEvent(ZeoEngine::Event& event) override;
 
+private:
+	/** Replace the stress test grid with gridSize * gridSize sprites. */
+	void RebuildStressGrid(int gridSize);
+	/** Spawn, move and draw damage numbers, and draw name labels over a few entities. */
+	void UpdateText(ZeoEngine::DeltaTime dt);
+	/** Replace the physics pyramid with one of rowCount rows of boxes, with a ball dropped on top. */
+	void RebuildPhysicsPyramid(int rowCount);
+
 private:
 	ZeoEngine::OrthographicCameraController m_CameraController;
 
+	ZeoEngine::Scene m_Scene;
+	ZeoEngine::Entity m_SquareEntity;
+	std::vector<ZeoEngine::Entity> m_StressGridEntities;
+	int m_StressGridSize = 0;
+	bool m_bShowDebugOverlay = false;
+	std::vector<ZeoEngine::Entity> m_PhysicsEntities;
+	int m_PhysicsPyramidRows = 0;
+
+	ZeoEngine::Ref<ZeoEngine::Font> m_Font;
+	/** Entities with their name drawn above them */
+	std::vector<ZeoEngine::Entity> m_LabelledEntities;
+	std::vector<DamageNumber> m_DamageNumbers;
+	float m_DamageNumberTimer = 0.0f;
+	std::mt19937 m_DamageRandom;
+	bool m_bShowText = true;
+
+	ZeoEngine::ParticleSystem m_ParticleSystem;
+	ZeoEngine::ParticleProps m_ParticleProps;
+	int m_ParticlesPerFrame = 0;
+
 	ZeoEngine::Ref<ZeoEngine::VertexArray> m_SquareVAO;
 	ZeoEngine::Ref<ZeoEngine::Shader> m_FlatColorShader;
 
 	ZeoEngine::Ref<ZeoEngine::Texture2D> m_CheckerboardTexture;
+	ZeoEngine::Ref<ZeoEngine::SubTexture2D> m_CheckerboardCell;
 	
 	glm::vec4 m_SquareColor = { 0.2f, 0.3f, 0.8f, 1.0f };
 };
@@ -67,13 +67,20 @@ public:
 		m_SquareVAO->SetIndexBuffer(squareIBO);
 
 		const std::string vertexSrc = R"(
-			#version 330 core
+			#version 450 core
 
 			layout(location = 0) in vec3 a_Position;
 			layout(location = 1) in vec4 a_Color;
 
-			uniform mat4 u_ViewProjection;
-			uniform mat4 u_Transform;
+			layout(std140, binding = 0) uniform Camera
+			{
+				mat4 u_ViewProjection;
+			};
+
+			layout(std140, binding = 1) uniform Draw
+			{
+				mat4 u_Transform;
+			};
 
 			out vec4 v_Color;
 			
@@ -86,7 +93,7 @@ public:
 		)";
 
 		const std::string fragmentSrc = R"(
-			#version 330 core
+			#version 450 core
 
 			layout(location = 0) out vec4 color;
 			
@@ -101,12 +108,19 @@ public:
 		m_Shader = ZeoEngine::Shader::Create("VertexPosColor", vertexSrc, fragmentSrc);
 
 		const std::string flatColorShaderVertexSrc = R"(
-			#version 330 core
+			#version 450 core
 
 			layout(location = 0) in vec3 a_Position;
 
-			uniform mat4 u_ViewProjection;
-			uniform mat4 u_Transform;
+			layout(std140, binding = 0) uniform Camera
+			{
+				mat4 u_ViewProjection;
+			};
+
+			layout(std140, binding = 1) uniform Draw
+			{
+				mat4 u_Transform;
+			};
 			
 			void main()
 			{
@@ -115,11 +129,14 @@ public:
 		)";
 
 		const std::string flatColorShaderFragmentSrc = R"(
-			#version 330 core
+			#version 450 core
 
 			layout(location = 0) out vec4 color;
 
-			uniform vec4 u_Color;
+			layout(std140, binding = 2) uniform Material
+			{
+				vec4 u_Color;
+			};
 			
 			void main()
 			{
@@ -128,15 +145,56 @@ public:
 		)";
 
 		m_FlatColorShader = ZeoEngine::Shader::Create("FlatColor", flatColorShaderVertexSrc, flatColorShaderFragmentSrc);
+		m_FlatColorMaterial = ZeoEngine::UniformBlock({
+			{ ZeoEngine::ShaderDataType::Float4, "u_Color" }
+		});
 
-		auto textureShader = m_ShaderLibrary.Load("assets/shaders/Texture.glsl");
+		// Texture.glsl is the Renderer2D batch shader which expects batched quad vertices, so this layer has its own one for the plain square
+		const std::string textureShaderVertexSrc = R"(
+			#version 450 core
+
+			layout(location = 0) in vec3 a_Position;
+			layout(location = 1) in vec2 a_TexCoord;
+
+			layout(std140, binding = 0) uniform Camera
+			{
+				mat4 u_ViewProjection;
+			};
+
+			layout(std140, binding = 1) uniform Draw
+			{
+				mat4 u_Transform;
+			};
+
+			out vec2 v_TexCoord;
+
+			void main()
+			{
+				v_TexCoord = a_TexCoord;
+				gl_Position = u_ViewProjection * u_Transform * vec4(a_Position, 1.0f);
+			}
+		)";
+
+		const std::string textureShaderFragmentSrc = R"(
+			#version 450 core
+
+			layout(location = 0) out vec4 color;
+
+			in vec2 v_TexCoord;
+
+			layout(binding = 0) uniform sampler2D u_Texture;
+
+			void main()
+			{
+				color = texture(u_Texture, v_TexCoord);
+			}
+		)";
+
+		m_ShaderLibrary.Add(ZeoEngine::Shader::Create("SquareTexture", textureShaderVertexSrc, textureShaderFragmentSrc));
+		m_ShaderLibrary.LoadAsync({ "assets/shaders/FlatColor.glsl" });
 
 		m_Texture = ZeoEngine::Texture2D::Create("assets/textures/Checkerboard_Alpha.png");
 		m_LogoTexture = ZeoEngine::Texture2D::Create("assets/textures/Logo_Trans_D.png");
-		
-		textureShader->Bind();
-		textureShader->SetInt("u_Texture", 0);
-
 	}
 
 	virtual void OnUpdate(ZeoEngine::DeltaTime dt) override
@@ -155,8 +213,7 @@ public:
 
 		static glm::mat4 scale = glm::scale(glm::mat4(1.0f), glm::vec3(0.1f));
 
-		m_FlatColorShader->Bind();
-		m_FlatColorShader->SetFloat4("u_Color", m_SquareColor);
+		m_FlatColorMaterial.SetFloat4("u_Color", m_SquareColor);
 
 		for (int x = 0; x < 10; ++x)
 		{
@@ -164,11 +221,11 @@ public:
 			{
 				glm::vec3 pos(x * 0.11f - 5 * 0.11f + 0.055f, y * 0.11f - 5 * 0.11f + 0.055f, 0.0f);
 				glm::mat4 transform = glm::translate(glm::mat4(1.0f), pos) * scale;
-				ZeoEngine::Renderer::Submit(m_FlatColorShader, m_SquareVAO, transform);
+				ZeoEngine::Renderer::Submit(m_FlatColorShader, m_SquareVAO, transform, &m_FlatColorMaterial);
 			}		
 		}
 
-		auto textureShader = m_ShaderLibrary.Get("Texture");
+		auto textureShader = m_ShaderLibrary.Get("SquareTexture");
 
 		m_Texture->Bind();
 		ZeoEngine::Renderer::Submit(textureShader, m_SquareVAO);
@@ -205,6 +262,7 @@ private:
 
 	ZeoEngine::Ref<ZeoEngine::VertexArray> m_SquareVAO;
 	ZeoEngine::Ref<ZeoEngine::Shader> m_FlatColorShader;
+	ZeoEngine::UniformBlock m_FlatColorMaterial;
 
 	ZeoEngine::Ref<ZeoEngine::Texture2D> m_Texture;
 	ZeoEngine::Ref<ZeoEngine::Texture2D> m_LogoTexture;
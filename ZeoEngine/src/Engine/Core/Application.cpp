@@ -2,8 +2,11 @@
 #include "Engine/Core/Application.h"
 
 #include "Engine/Core/Log.h"
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Core/FrameAllocator.h"
 
 #include "Engine/Renderer/Renderer.h"
+#include "Engine/Renderer/HotReloader.h"
 
 #include <GLFW/glfw3.h>
 
@@ -17,6 +20,11 @@ namespace ZeoEngine {
 
 		ZE_CORE_ASSERT(!s_Instance, "Application already exists!");
 		s_Instance = this;
+
+		// Workers are required before any subsystem starts scheduling jobs
+		JobSystem::Init();
+		FrameAllocator::Init();
+
 		m_Window = Window::Create();
 		m_Window->SetEventCallback(ZE_BIND_EVENT_FUNC(Application::OnEvent));
 
@@ -34,11 +42,14 @@ namespace ZeoEngine {
 		ZE_PROFILE_FUNCTION();
 
 		Renderer::Shutdown();
+		JobSystem::Shutdown();
+		FrameAllocator::Shutdown();
 	}
 
 	void Application::OnEvent(Event& e)
 	{
 		ZE_PROFILE_FUNCTION();
+		ZE_MEMORY_TAG(Events);
 
 		EventDispatcher dispatcher(e);
 		dispatcher.Dispatch<WindowCloseEvent>(ZE_BIND_EVENT_FUNC(Application::OnWindowClose));
@@ -56,6 +67,7 @@ namespace ZeoEngine {
 	void Application::PushLayer(Layer* layer)
 	{
 		ZE_PROFILE_FUNCTION();
+		ZE_MEMORY_TAG(Layers);
 
 		m_LayerStack.PushLayer(layer);
 		layer->OnAttach();
@@ -64,6 +76,7 @@ namespace ZeoEngine {
 	void Application::PushOverlay(Layer* layer)
 	{
 		ZE_PROFILE_FUNCTION();
+		ZE_MEMORY_TAG(Layers);
 
 		m_LayerStack.PushOverlay(layer);
 		layer->OnAttach();
@@ -77,16 +90,24 @@ namespace ZeoEngine {
 		{
 			ZE_PROFILE_SCOPE("RunLoop");
 
+			// Everything allocated from frame arenas during last frame is released here
+			FrameAllocator::Reset();
+			MemoryTracker::BeginFrame();
+
 			// Platform::GetTime();
 			float time = (float)glfwGetTime();
 			DeltaTime dt = time - m_LastFrameTime;
 			m_LastFrameTime = time;
 
+			// Swap in reloaded assets before anything of this frame uses them
+			HotReloader::Update();
+
 			// Stop updating layers if window is minimized
 			if (!m_bMinimized)
 			{
 				{
 					ZE_PROFILE_SCOPE("LayerStack OnUpdate");
+					ZE_MEMORY_TAG(Layers);
 
 					for (Layer* layer : m_LayerStack)
 					{
@@ -99,6 +120,7 @@ namespace ZeoEngine {
 				m_ImGuiLayer->Begin();
 				{
 					ZE_PROFILE_SCOPE("LayerStack OnImGuiRender");
+					ZE_MEMORY_TAG(ImGui);
 
 					for (Layer* layer : m_LayerStack)
 					{
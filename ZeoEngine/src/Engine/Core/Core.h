@@ -21,6 +21,26 @@
 	#define ZE_ENABLE_ASSERTS
 #endif // ZE_DEBUG
 
+#ifndef ZE_DIST
+	#define ZE_ENABLE_HOT_RELOAD
+#endif // ZE_DIST
+
+// Memory tracking replaces global operator new/delete, so it is opt-in by defining ZE_TRACK_MEMORY (premake5 --track-memory)
+
+// SIMD code paths are selected at compile time: SSE paths only use SSE2, AVX2 paths require building with /arch:AVX2
+#ifndef ZE_DISABLE_SIMD
+	#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define ZE_SIMD_SSE
+	#endif
+	#if defined(__AVX2__)
+		#define ZE_SIMD_AVX2
+	#endif
+	// Every AVX2 CPU has F16C, MSVC enables it with /arch:AVX2 while GCC and Clang need -mf16c
+	#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+		#define ZE_SIMD_F16C
+	#endif
+#endif // ZE_DISABLE_SIMD
+
 #ifdef ZE_ENABLE_ASSERTS
 	#define ZE_ASSERT(x, ...) { if(!(x)) { ZE_ERROR("Assertion Failed: {0}", __VA_ARGS__); __debugbreak(); } }
 	#define ZE_CORE_ASSERT(x, ...) { if(!(x)) { ZE_CORE_ERROR("Assertion Failed: {0}", __VA_ARGS__); __debugbreak(); } }
@@ -42,12 +62,6 @@ namespace ZeoEngine {
 	{
 		return std::make_unique<T>(std::forward<Args>(args)...);
 	}
-
-	template<typename T>
-	using Ref = std::shared_ptr<T>;
-	template<typename T, typename ... Args>
-	constexpr Ref<T> CreateRef(Args&& ... args)
-	{
-		return std::make_shared<T>(std::forward<Args>(args)...);
-	}
 }
+
+#include "Engine/Core/Ref.h"
@@ -18,6 +18,7 @@ int main(int argc, char** argv)
 
 	ZE_PROFILE_BEGIN_SESSION("Shutdown", "ZeoEngineProfile_Shutdown.json");
 	delete app;
+	ZeoEngine::PoolAllocator::ShutdownTypePools();
 	ZE_PROFILE_END_SESSION();
 }
 #else
@@ -0,0 +1,20 @@
+#include "ZEpch.h"
+#include "Engine/Core/FileWatcher.h"
+
+#ifdef ZE_PLATFORM_WINDOWS
+	#include "Platform/Windows/WindowsFileWatcher.h"
+#endif
+
+namespace ZeoEngine {
+
+	Scope<FileWatcher> FileWatcher::Create(const std::string& directory, const FileChangedCallback& callback)
+	{
+#ifdef ZE_PLATFORM_WINDOWS
+		return CreateScope<WindowsFileWatcher>(directory, callback);
+#else
+		ZE_CORE_ASSERT(false, "FileWatcher is not supported on this platform!");
+		return nullptr;
+#endif
+	}
+
+}
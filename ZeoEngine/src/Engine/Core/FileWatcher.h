@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Engine/Core/Core.h"
+
+namespace ZeoEngine {
+
+	/** Watches a directory and all of its sub-directories for file modifications on a background thread. */
+	class FileWatcher
+	{
+	public:
+		/** Called on the watcher thread with the path of the changed file, e.g. "assets/shaders/Texture.glsl". */
+		using FileChangedCallback = std::function<void(const std::string& filePath)>;
+
+		virtual ~FileWatcher() = default;
+
+		static Scope<FileWatcher> Create(const std::string& directory, const FileChangedCallback& callback);
+
+	};
+
+}
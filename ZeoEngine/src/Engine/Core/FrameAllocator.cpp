@@ -0,0 +1,135 @@
+#include "ZEpch.h"
+#include "Engine/Core/FrameAllocator.h"
+
+#include <thread>
+
+#include "Engine/Core/JobSystem.h"
+
+namespace ZeoEngine {
+
+	static uint8_t* AlignPointer(uint8_t* ptr, size_t alignment)
+	{
+		uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+		return reinterpret_cast<uint8_t*>((address + alignment - 1) & ~(alignment - 1));
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// LinearArena ///////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////////
+
+	LinearArena::LinearArena(size_t capacity)
+		: m_Buffer(new uint8_t[capacity])
+		, m_Capacity(capacity)
+	{
+	}
+
+	LinearArena::~LinearArena()
+	{
+		Reset();
+		delete[] m_Buffer;
+	}
+
+	void* LinearArena::Allocate(size_t size, size_t alignment)
+	{
+		ZE_CORE_ASSERT((alignment & (alignment - 1)) == 0, "Alignment must be a power of two!");
+
+		uint8_t* ptr = AlignPointer(m_Buffer + m_Offset, alignment);
+		size_t newOffset = (ptr - m_Buffer) + size;
+		if (newOffset <= m_Capacity)
+		{
+			m_Offset = newOffset;
+			return ptr;
+		}
+
+		uint8_t* block = new uint8_t[size + alignment];
+		m_OverflowBlocks.push_back(block);
+		m_OverflowSize += size + alignment;
+		return AlignPointer(block, alignment);
+	}
+
+	void LinearArena::Reset()
+	{
+		if (!m_OverflowBlocks.empty())
+		{
+			for (uint8_t* block : m_OverflowBlocks)
+			{
+				delete[] block;
+			}
+			m_OverflowBlocks.clear();
+
+			size_t newCapacity = m_Capacity + m_OverflowSize;
+			ZE_CORE_WARN("Linear arena overflowed, growing from {0} to {1} bytes", m_Capacity, newCapacity);
+			delete[] m_Buffer;
+			m_Buffer = new uint8_t[newCapacity];
+			m_Capacity = newCapacity;
+			m_OverflowSize = 0;
+		}
+		m_Offset = 0;
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// FrameAllocator ////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////////
+
+	struct FrameAllocatorData
+	{
+		/** Indexed by JobSystem::GetThreadIndex() */
+		std::vector<Scope<LinearArena>> Arenas;
+		std::thread::id MainThreadId;
+	};
+
+	static FrameAllocatorData s_FrameData;
+
+	void FrameAllocator::Init(size_t arenaSize)
+	{
+		ZE_PROFILE_FUNCTION();
+
+		const uint32_t threadCount = JobSystem::GetWorkerCount() + 1;
+		s_FrameData.Arenas.reserve(threadCount);
+		for (uint32_t i = 0; i < threadCount; ++i)
+		{
+			s_FrameData.Arenas.push_back(CreateScope<LinearArena>(arenaSize));
+		}
+		s_FrameData.MainThreadId = std::this_thread::get_id();
+	}
+
+	void FrameAllocator::Shutdown()
+	{
+		ZE_PROFILE_FUNCTION();
+
+		s_FrameData.Arenas.clear();
+	}
+
+	void FrameAllocator::Reset()
+	{
+		ZE_PROFILE_FUNCTION();
+
+		for (auto& arena : s_FrameData.Arenas)
+		{
+			arena->Reset();
+		}
+	}
+
+	void* FrameAllocator::Allocate(size_t size, size_t alignment)
+	{
+		const uint32_t threadIndex = JobSystem::GetThreadIndex();
+		// Threads not owned by JobSystem also report index 0 but must not share the main thread's arena
+		ZE_CORE_ASSERT(threadIndex != 0 || std::this_thread::get_id() == s_FrameData.MainThreadId, "Frame memory can only be allocated on the main thread or job workers!");
+		ZE_CORE_ASSERT(threadIndex < s_FrameData.Arenas.size(), "FrameAllocator is not initialized!");
+		// The arena may be reset by the main thread while a background job is still running
+		ZE_CORE_ASSERT(!JobSystem::IsInBackgroundJob(), "Frame memory cannot be allocated by background jobs!");
+
+		return s_FrameData.Arenas[threadIndex]->Allocate(size, alignment);
+	}
+
+	size_t FrameAllocator::GetUsedSize()
+	{
+		size_t usedSize = 0;
+		for (const auto& arena : s_FrameData.Arenas)
+		{
+			usedSize += arena->GetUsedSize();
+		}
+		return usedSize;
+	}
+
+}
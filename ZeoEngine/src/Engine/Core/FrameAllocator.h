@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+
+namespace ZeoEngine {
+
+	/** A bump allocator over a single buffer. Individual allocations cannot be freed, the whole arena is released at once. */
+	class LinearArena
+	{
+	public:
+		explicit LinearArena(size_t capacity);
+		~LinearArena();
+
+		LinearArena(const LinearArena&) = delete;
+		LinearArena& operator=(const LinearArena&) = delete;
+
+		/** If the buffer is full, memory is taken from the heap until next Reset(). */
+		void* Allocate(size_t size, size_t alignment);
+		/** Release all allocations. If the buffer has overflowed, it grows to fit the peak usage so that it will not overflow again. */
+		void Reset();
+
+		inline size_t GetUsedSize() const { return m_Offset + m_OverflowSize; }
+		inline size_t GetCapacity() const { return m_Capacity; }
+
+	private:
+		uint8_t* m_Buffer;
+		size_t m_Capacity;
+		size_t m_Offset = 0;
+
+		std::vector<uint8_t*> m_OverflowBlocks;
+		size_t m_OverflowSize = 0;
+
+	};
+
+	/**
+	 * Scratch memory which lives until the end of the current frame.
+	 *
+	 * Each thread of JobSystem allocates from its own arena, so no locking is involved.
+	 * All arenas are reset by the main thread at the start of each frame,
+	 * so jobs using frame memory must be waited on within the frame they are scheduled in.
+	 * Jobs which may outlive a frame must be scheduled with JobSystem::ExecuteBackground() and allocate from the heap instead.
+	 * Destructors of objects created here are never called.
+	 */
+	class FrameAllocator
+	{
+	public:
+		/** Must be called after JobSystem::Init() as one arena is created per thread. */
+		static void Init(size_t arenaSize = 1024 * 1024);
+		static void Shutdown();
+
+		/** Release memory allocated during last frame. Called by Application at the start of every frame. */
+		static void Reset();
+
+		static void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+		template<typename T, typename ... Args>
+		static T* New(Args&& ... args)
+		{
+			static_assert(std::is_trivially_destructible<T>::value, "Destructors of frame allocated objects are never called!");
+			return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+		}
+
+		template<typename T>
+		static T* NewArray(size_t count)
+		{
+			static_assert(std::is_trivially_destructible<T>::value, "Destructors of frame allocated objects are never called!");
+			return new (Allocate(sizeof(T) * count, alignof(T))) T[count];
+		}
+
+		/** Returns bytes allocated during current frame across all threads. */
+		static size_t GetUsedSize();
+	};
+
+	/** Adapter for STL containers. Deallocation does nothing, memory is reclaimed at the start of next frame. */
+	template<typename T>
+	class FrameStlAllocator
+	{
+	public:
+		using value_type = T;
+
+		FrameStlAllocator() = default;
+		template<typename U>
+		FrameStlAllocator(const FrameStlAllocator<U>&) {}
+
+		T* allocate(size_t count)
+		{
+			return static_cast<T*>(FrameAllocator::Allocate(count * sizeof(T), alignof(T)));
+		}
+
+		void deallocate(T*, size_t) {}
+
+		template<typename U>
+		bool operator==(const FrameStlAllocator<U>&) const { return true; }
+		template<typename U>
+		bool operator!=(const FrameStlAllocator<U>&) const { return false; }
+	};
+
+	template<typename T>
+	using FrameVector = std::vector<T, FrameStlAllocator<T>>;
+	using FrameString = std::basic_string<char, std::char_traits<char>, FrameStlAllocator<char>>;
+
+}
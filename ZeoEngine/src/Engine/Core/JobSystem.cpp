@@ -0,0 +1,205 @@
+#include "ZEpch.h"
+#include "Engine/Core/JobSystem.h"
+
+#include <thread>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+
+namespace ZeoEngine {
+
+	struct Job
+	{
+		std::function<void()> Func;
+		JobCounter* Counter;
+		bool bBackground;
+	};
+
+	struct JobSystemData
+	{
+		std::vector<std::thread> Workers;
+		std::deque<Job> Queue;
+		std::mutex QueueMutex;
+		std::condition_variable WakeCondition;
+		bool bRunning = false;
+	};
+
+	static JobSystemData s_JobData;
+	static thread_local uint32_t s_ThreadIndex = 0;
+	static thread_local bool s_bInBackgroundJob = false;
+
+	static void RunJob(Job& job)
+	{
+		// Waiting inside a job runs other queued jobs on the same thread, so the flag is restored afterwards
+		const bool bWasInBackgroundJob = s_bInBackgroundJob;
+		s_bInBackgroundJob = job.bBackground;
+		job.Func();
+		s_bInBackgroundJob = bWasInBackgroundJob;
+
+		if (job.Counter)
+		{
+			job.Counter->Pending.fetch_sub(1, std::memory_order_release);
+		}
+	}
+
+	void JobSystem::Init(uint32_t threadCount)
+	{
+		ZE_PROFILE_FUNCTION();
+
+		ZE_CORE_ASSERT(!s_JobData.bRunning, "JobSystem already initialized!");
+
+		if (threadCount == 0)
+		{
+			uint32_t hardwareThreads = std::thread::hardware_concurrency();
+			threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+		}
+
+		s_JobData.bRunning = true;
+		s_JobData.Workers.reserve(threadCount);
+		for (uint32_t i = 0; i < threadCount; ++i)
+		{
+			s_JobData.Workers.emplace_back(&JobSystem::WorkerLoop, i + 1);
+		}
+		ZE_CORE_TRACE("Initialized job system with {0} workers", threadCount);
+	}
+
+	void JobSystem::Shutdown()
+	{
+		ZE_PROFILE_FUNCTION();
+
+		{
+			std::lock_guard<std::mutex> lock(s_JobData.QueueMutex);
+			s_JobData.bRunning = false;
+		}
+		s_JobData.WakeCondition.notify_all();
+
+		for (auto& worker : s_JobData.Workers)
+		{
+			worker.join();
+		}
+		s_JobData.Workers.clear();
+		s_JobData.Queue.clear();
+	}
+
+	void JobSystem::Execute(std::function<void()> job, JobCounter* counter)
+	{
+		Schedule(std::move(job), counter, false);
+	}
+
+	void JobSystem::ExecuteBackground(std::function<void()> job, JobCounter* counter)
+	{
+		Schedule(std::move(job), counter, true);
+	}
+
+	void JobSystem::Schedule(std::function<void()> job, JobCounter* counter, bool bBackground)
+	{
+		if (counter)
+		{
+			counter->Pending.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		// Run inline if there is no worker to pick it up
+		if (s_JobData.Workers.empty())
+		{
+			Job inlineJob{ std::move(job), counter, bBackground };
+			RunJob(inlineJob);
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(s_JobData.QueueMutex);
+			s_JobData.Queue.push_back({ std::move(job), counter, bBackground });
+		}
+		s_JobData.WakeCondition.notify_one();
+	}
+
+	void JobSystem::ParallelFor(uint32_t count, uint32_t minChunkSize, const std::function<void(uint32_t begin, uint32_t end)>& func)
+	{
+		if (count == 0)
+			return;
+
+		// Split into roughly one chunk per thread but never smaller than minChunkSize
+		const uint32_t threadCount = GetWorkerCount() + 1;
+		uint32_t chunkSize = std::max((count + threadCount - 1) / threadCount, std::max(minChunkSize, 1u));
+		if (chunkSize >= count)
+		{
+			func(0, count);
+			return;
+		}
+
+		JobCounter counter;
+		// Keep the first chunk for the calling thread
+		for (uint32_t begin = chunkSize; begin < count; begin += chunkSize)
+		{
+			uint32_t end = std::min(begin + chunkSize, count);
+			Execute([&func, begin, end]() { func(begin, end); }, &counter);
+		}
+		func(0, chunkSize);
+
+		Wait(counter);
+	}
+
+	void JobSystem::Wait(const JobCounter& counter)
+	{
+		while (!counter.IsDone())
+		{
+			if (!RunPendingJob())
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	uint32_t JobSystem::GetWorkerCount()
+	{
+		return static_cast<uint32_t>(s_JobData.Workers.size());
+	}
+
+	uint32_t JobSystem::GetThreadIndex()
+	{
+		return s_ThreadIndex;
+	}
+
+	bool JobSystem::IsInBackgroundJob()
+	{
+		return s_bInBackgroundJob;
+	}
+
+	bool JobSystem::RunPendingJob()
+	{
+		Job job;
+		{
+			std::lock_guard<std::mutex> lock(s_JobData.QueueMutex);
+			if (s_JobData.Queue.empty())
+				return false;
+
+			job = std::move(s_JobData.Queue.front());
+			s_JobData.Queue.pop_front();
+		}
+
+		RunJob(job);
+		return true;
+	}
+
+	void JobSystem::WorkerLoop(uint32_t threadIndex)
+	{
+		s_ThreadIndex = threadIndex;
+
+		while (true)
+		{
+			Job job;
+			{
+				std::unique_lock<std::mutex> lock(s_JobData.QueueMutex);
+				s_JobData.WakeCondition.wait(lock, []() { return !s_JobData.bRunning || !s_JobData.Queue.empty(); });
+				if (!s_JobData.bRunning && s_JobData.Queue.empty())
+					return;
+
+				job = std::move(s_JobData.Queue.front());
+				s_JobData.Queue.pop_front();
+			}
+
+			RunJob(job);
+		}
+	}
+
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <future>
+
+namespace ZeoEngine {
+
+	/** Tracks a group of jobs so that the caller can wait for all of them to complete. */
+	struct JobCounter
+	{
+		std::atomic<uint32_t> Pending{ 0 };
+
+		bool IsDone() const { return Pending.load(std::memory_order_acquire) == 0; }
+	};
+
+	/**
+	 * A simple worker thread pool shared by the whole engine.
+	 *
+	 * Waiting threads (including workers waiting for nested jobs) keep executing queued jobs
+	 * instead of blocking, so jobs are free to schedule and wait for other jobs.
+	 */
+	class JobSystem
+	{
+	public:
+		/** If threadCount is 0, one worker is created per hardware thread except the main thread. */
+		static void Init(uint32_t threadCount = 0);
+		static void Shutdown();
+
+		/** Schedule a job and returns a future holding its result. */
+		template<typename Func>
+		static auto Submit(Func&& func) -> std::future<decltype(func())>
+		{
+			using ResultType = decltype(func());
+			auto task = std::make_shared<std::packaged_task<ResultType()>>(std::forward<Func>(func));
+			std::future<ResultType> result = task->get_future();
+			Execute([task]() { (*task)(); });
+			return result;
+		}
+
+		/** Schedule a job, if counter is provided, it will be decremented when the job completes. */
+		static void Execute(std::function<void()> job, JobCounter* counter = nullptr);
+		/**
+		 * Schedule a job which is allowed to outlive the current frame, e.g. file IO for hot reloading.
+		 * Frame memory is reset while such jobs may still be running, so FrameAllocator refuses to allocate inside them.
+		 */
+		static void ExecuteBackground(std::function<void()> job, JobCounter* counter = nullptr);
+
+		/**
+		 * Split [0, count) into chunks of at least minChunkSize elements and process them concurrently.
+		 * The calling thread takes part in processing and this function returns after all chunks are done.
+		 */
+		static void ParallelFor(uint32_t count, uint32_t minChunkSize, const std::function<void(uint32_t begin, uint32_t end)>& func);
+
+		/** Execute queued jobs on the calling thread until all jobs tracked by the counter are done. */
+		static void Wait(const JobCounter& counter);
+
+		/** Returns the number of worker threads, not including the main thread. */
+		static uint32_t GetWorkerCount();
+		/** Returns 0 for the main thread (or any thread not owned by JobSystem) and [1, GetWorkerCount()] for workers. */
+		static uint32_t GetThreadIndex();
+		/** Returns true if the calling thread is currently running a job scheduled by ExecuteBackground(). */
+		static bool IsInBackgroundJob();
+
+	private:
+		static void Schedule(std::function<void()> job, JobCounter* counter, bool bBackground);
+		/** Pop and run a single job, returns false if the queue is empty. */
+		static bool RunPendingJob();
+		static void WorkerLoop(uint32_t threadIndex);
+
+	};
+
+}
@@ -0,0 +1,106 @@
+#include "ZEpch.h"
+#include "Engine/Core/PoolAllocator.h"
+
+namespace ZeoEngine {
+
+	// Type pools are registered during dynamic initialization of other objects, so these must be constant-initialized
+	static PoolAllocator* s_TypePools = nullptr;
+	static std::mutex s_TypePoolMutex;
+
+	PoolAllocator::PoolAllocator(size_t blockSize, size_t blockAlignment, uint32_t blocksPerChunk)
+		: m_BlockAlignment(std::max(blockAlignment, alignof(FreeBlock)))
+		, m_BlocksPerChunk(blocksPerChunk)
+	{
+		// Free blocks store the free list link in place
+		blockSize = std::max(blockSize, sizeof(FreeBlock));
+		m_BlockSize = (blockSize + m_BlockAlignment - 1) / m_BlockAlignment * m_BlockAlignment;
+	}
+
+	PoolAllocator::~PoolAllocator()
+	{
+		for (void* chunk : m_Chunks)
+		{
+			::operator delete(chunk, std::align_val_t(m_BlockAlignment));
+		}
+	}
+
+	PoolAllocator* PoolAllocator::RegisterTypePool(PoolAllocator* pool)
+	{
+		std::lock_guard<std::mutex> lock(s_TypePoolMutex);
+		pool->m_NextTypePool = s_TypePools;
+		s_TypePools = pool;
+		return pool;
+	}
+
+	void PoolAllocator::ShutdownTypePools()
+	{
+		std::lock_guard<std::mutex> lock(s_TypePoolMutex);
+		for (PoolAllocator* pool = s_TypePools; pool; pool = pool->m_NextTypePool)
+		{
+			if (!pool->ReleaseChunks())
+			{
+				ZE_CORE_WARN("Pool of {0} byte objects still has {1} live objects at shutdown", pool->m_BlockSize, pool->m_LiveBlockCount);
+			}
+		}
+	}
+
+	void* PoolAllocator::Allocate()
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		if (!m_FreeList)
+		{
+			AllocateChunk();
+		}
+
+		FreeBlock* block = m_FreeList;
+		m_FreeList = block->Next;
+		++m_LiveBlockCount;
+		return block;
+	}
+
+	void PoolAllocator::Deallocate(void* block)
+	{
+		if (!block)
+			return;
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		FreeBlock* freeBlock = static_cast<FreeBlock*>(block);
+		freeBlock->Next = m_FreeList;
+		m_FreeList = freeBlock;
+		--m_LiveBlockCount;
+	}
+
+	bool PoolAllocator::ReleaseChunks()
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		if (m_LiveBlockCount > 0)
+			return false;
+
+		for (void* chunk : m_Chunks)
+		{
+			::operator delete(chunk, std::align_val_t(m_BlockAlignment));
+		}
+		// Release the capacity as well, the pool itself may never be destroyed
+		std::vector<void*>().swap(m_Chunks);
+		m_FreeList = nullptr;
+		return true;
+	}
+
+	void PoolAllocator::AllocateChunk()
+	{
+		uint8_t* chunk = static_cast<uint8_t*>(::operator new(m_BlockSize * m_BlocksPerChunk, std::align_val_t(m_BlockAlignment)));
+		m_Chunks.push_back(chunk);
+
+		// Link blocks in address order so that consecutive allocations are adjacent
+		for (uint32_t i = m_BlocksPerChunk; i > 0; --i)
+		{
+			FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + (i - 1) * m_BlockSize);
+			block->Next = m_FreeList;
+			m_FreeList = block;
+		}
+	}
+
+}
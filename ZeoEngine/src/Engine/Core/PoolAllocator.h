@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace ZeoEngine {
+
+	/**
+	 * Hands out fixed-size blocks carved from large chunks, so objects of the same type end up next to each other in memory.
+	 * Freed blocks are kept in a free list and reused, chunks are only released when the pool is destroyed.
+	 */
+	class PoolAllocator
+	{
+	public:
+		PoolAllocator(size_t blockSize, size_t blockAlignment, uint32_t blocksPerChunk = 64);
+		~PoolAllocator();
+
+		PoolAllocator(const PoolAllocator&) = delete;
+		PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+		void* Allocate();
+		void Deallocate(void* block);
+		/** Return all chunks to the heap. This only happens if no block is in use, returns false otherwise. */
+		bool ReleaseChunks();
+
+		inline size_t GetBlockSize() const { return m_BlockSize; }
+
+		/** Returns the pool dedicated to objects of type T. */
+		template<typename T>
+		static PoolAllocator& GetTypePool()
+		{
+			// Kept in static storage and never destroyed, as objects held by static references may be released after static destruction has begun
+			alignas(PoolAllocator) static uint8_t storage[sizeof(PoolAllocator)];
+			static PoolAllocator* pool = RegisterTypePool(new (storage) PoolAllocator(sizeof(T), alignof(T)));
+			return *pool;
+		}
+
+		/**
+		 * Release chunks of every type pool whose objects have all been destroyed. Called after the application is deleted.
+		 * Pools which are still in use are reported and kept, they remain usable either way.
+		 */
+		static void ShutdownTypePools();
+
+	private:
+		static PoolAllocator* RegisterTypePool(PoolAllocator* pool);
+
+		void AllocateChunk();
+
+	private:
+		struct FreeBlock
+		{
+			FreeBlock* Next;
+		};
+
+		size_t m_BlockSize;
+		size_t m_BlockAlignment;
+		uint32_t m_BlocksPerChunk;
+
+		FreeBlock* m_FreeList = nullptr;
+		std::vector<void*> m_Chunks;
+		uint32_t m_LiveBlockCount = 0;
+		std::mutex m_Mutex;
+
+		/** Next pool in the list of type pools */
+		PoolAllocator* m_NextTypePool = nullptr;
+
+	};
+
+}
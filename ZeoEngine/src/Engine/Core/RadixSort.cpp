@@ -0,0 +1,77 @@
+#include "ZEpch.h"
+#include "Engine/Core/RadixSort.h"
+
+namespace ZeoEngine {
+
+	static constexpr uint32_t s_RadixBits = 11;
+	static constexpr uint32_t s_RadixSize = 1 << s_RadixBits;
+	static constexpr uint32_t s_RadixMask = s_RadixSize - 1;
+	static constexpr uint32_t s_PassCount = (32 + s_RadixBits - 1) / s_RadixBits;
+
+	void RadixSort::SortIndices(const uint32_t* keys, uint32_t count, uint32_t* outIndices, uint32_t* scratch)
+	{
+		ZE_PROFILE_FUNCTION();
+
+		// All digit histograms are gathered in one read over the keys
+		uint32_t histograms[s_PassCount][s_RadixSize] = {};
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			const uint32_t key = keys[i];
+			for (uint32_t pass = 0; pass < s_PassCount; ++pass)
+			{
+				++histograms[pass][(key >> (pass * s_RadixBits)) & s_RadixMask];
+			}
+		}
+
+		uint32_t* keyBuffers[2] = { scratch, scratch + count };
+		uint32_t* indexBuffers[2] = { outIndices, scratch + 2 * count };
+		const uint32_t* sourceKeys = keys;
+		const uint32_t* sourceIndices = nullptr;
+		uint32_t target = 0;
+		for (uint32_t pass = 0; pass < s_PassCount; ++pass)
+		{
+			uint32_t* histogram = histograms[pass];
+			const uint32_t shift = pass * s_RadixBits;
+			// Every key falls into the same bucket so this pass would not change the order
+			if (count == 0 || histogram[(keys[0] >> shift) & s_RadixMask] == count)
+				continue;
+
+			// Turn counts into starting offsets
+			uint32_t offset = 0;
+			for (uint32_t digit = 0; digit < s_RadixSize; ++digit)
+			{
+				const uint32_t digitCount = histogram[digit];
+				histogram[digit] = offset;
+				offset += digitCount;
+			}
+
+			uint32_t* targetKeys = keyBuffers[target];
+			uint32_t* targetIndices = indexBuffers[target];
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				const uint32_t key = sourceKeys[i];
+				const uint32_t position = histogram[(key >> shift) & s_RadixMask]++;
+				targetKeys[position] = key;
+				// The first executed pass starts from the identity order
+				targetIndices[position] = sourceIndices ? sourceIndices[i] : i;
+			}
+
+			sourceKeys = targetKeys;
+			sourceIndices = targetIndices;
+			target ^= 1;
+		}
+
+		if (!sourceIndices)
+		{
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				outIndices[i] = i;
+			}
+		}
+		else if (sourceIndices != outIndices)
+		{
+			memcpy(outIndices, sourceIndices, count * sizeof(uint32_t));
+		}
+	}
+
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+namespace ZeoEngine {
+
+	/** Stable least significant digit radix sort on 32-bit keys, 11 bits per pass. */
+	class RadixSort
+	{
+	public:
+		/** Map a float to an unsigned key which sorts in the same order, negative zero sorts just before positive zero. */
+		static uint32_t FloatToKey(float value)
+		{
+			uint32_t bits;
+			memcpy(&bits, &value, sizeof(bits));
+			// Flip all bits of negative values so that larger magnitudes come first, and only the sign bit of positive ones
+			const uint32_t mask = static_cast<uint32_t>(-static_cast<int32_t>(bits >> 31)) | 0x80000000u;
+			return bits ^ mask;
+		}
+
+		/**
+		 * Write the order which sorts keys ascending into outIndices, elements with equal keys keep their relative order.
+		 * Passes over digits which are equal for all keys are skipped, so nearly uniform keys sort in a single read.
+		 * scratch must hold at least 3 * count values.
+		 */
+		static void SortIndices(const uint32_t* keys, uint32_t count, uint32_t* outIndices, uint32_t* scratch);
+	};
+
+}
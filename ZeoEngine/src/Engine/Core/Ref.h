@@ -0,0 +1,218 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "Engine/Core/PoolAllocator.h"
+
+namespace ZeoEngine {
+
+	template<typename T>
+	class Ref;
+
+	/**
+	 * Base class of reference counted objects, the counter lives inside the object so no separate control block is needed.
+	 * @param bThreadSafe - If false, the counter is a plain integer which is cheaper to update,
+	 *                      but references to the object must then only be copied and released on a single thread
+	 */
+	template<bool bThreadSafe>
+	class RefCountedBase
+	{
+	public:
+		uint32_t GetRefCount() const { return m_RefCount; }
+
+	protected:
+		RefCountedBase() = default;
+		// Copies of an object start without any reference
+		RefCountedBase(const RefCountedBase&) {}
+		RefCountedBase& operator=(const RefCountedBase&) { return *this; }
+		virtual ~RefCountedBase() = default;
+
+	private:
+		void IncRef() const
+		{
+			if constexpr (bThreadSafe)
+			{
+				m_RefCount.fetch_add(1, std::memory_order_relaxed);
+			}
+			else
+			{
+				++m_RefCount;
+			}
+		}
+
+		/** Returns true if the last reference has been released. */
+		bool DecRef() const
+		{
+			if constexpr (bThreadSafe)
+			{
+				return m_RefCount.fetch_sub(1, std::memory_order_acq_rel) == 1;
+			}
+			else
+			{
+				return --m_RefCount == 0;
+			}
+		}
+
+		void Destroy() const
+		{
+			if (!m_Pool)
+			{
+				delete this;
+				return;
+			}
+
+			PoolAllocator* pool = m_Pool;
+			// Start of the most derived object, which is where the pool block begins
+			void* block = const_cast<void*>(dynamic_cast<const void*>(this));
+			this->~RefCountedBase();
+			pool->Deallocate(block);
+		}
+
+	private:
+		template<typename T>
+		friend class Ref;
+		template<typename T, typename ... Args>
+		friend Ref<T> CreateRef(Args&& ... args);
+
+		mutable std::conditional_t<bThreadSafe, std::atomic<uint32_t>, uint32_t> m_RefCount{ 0 };
+		/** Pool this object is allocated from, or nullptr if it is allocated by new */
+		PoolAllocator* m_Pool = nullptr;
+
+	};
+
+	/** Reference counted object which can be shared across threads */
+	using RefCounted = RefCountedBase<true>;
+	/** Reference counted object whose references never leave the thread owning it */
+	using LocalRefCounted = RefCountedBase<false>;
+
+	/** Intrusive smart pointer to an object derived from RefCounted or LocalRefCounted. */
+	template<typename T>
+	class Ref
+	{
+	public:
+		Ref() = default;
+		Ref(std::nullptr_t) {}
+		/** Take a reference to an existing object, which is deleted when the last reference is released. */
+		explicit Ref(T* ptr)
+			: m_Ptr(ptr)
+		{
+			if (m_Ptr) m_Ptr->IncRef();
+		}
+
+		Ref(const Ref& other)
+			: m_Ptr(other.m_Ptr)
+		{
+			if (m_Ptr) m_Ptr->IncRef();
+		}
+
+		Ref(Ref&& other) noexcept
+			: m_Ptr(other.m_Ptr)
+		{
+			other.m_Ptr = nullptr;
+		}
+
+		template<typename U, typename = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+		Ref(const Ref<U>& other)
+			: m_Ptr(other.get())
+		{
+			if (m_Ptr) m_Ptr->IncRef();
+		}
+
+		template<typename U, typename = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+		Ref(Ref<U>&& other) noexcept
+			: m_Ptr(other.m_Ptr)
+		{
+			other.m_Ptr = nullptr;
+		}
+
+		~Ref()
+		{
+			Release();
+		}
+
+		Ref& operator=(const Ref& other)
+		{
+			// Add the new reference first in case both refer to the same object
+			if (other.m_Ptr) other.m_Ptr->IncRef();
+			Release();
+			m_Ptr = other.m_Ptr;
+			return *this;
+		}
+
+		Ref& operator=(Ref&& other) noexcept
+		{
+			if (this != &other)
+			{
+				Release();
+				m_Ptr = other.m_Ptr;
+				other.m_Ptr = nullptr;
+			}
+			return *this;
+		}
+
+		Ref& operator=(std::nullptr_t)
+		{
+			reset();
+			return *this;
+		}
+
+		void reset()
+		{
+			Release();
+			m_Ptr = nullptr;
+		}
+
+		T* get() const { return m_Ptr; }
+		T* operator->() const { return m_Ptr; }
+		T& operator*() const { return *m_Ptr; }
+		explicit operator bool() const { return m_Ptr != nullptr; }
+
+		template<typename U>
+		bool operator==(const Ref<U>& other) const { return m_Ptr == other.get(); }
+		template<typename U>
+		bool operator!=(const Ref<U>& other) const { return m_Ptr != other.get(); }
+		bool operator==(std::nullptr_t) const { return m_Ptr == nullptr; }
+		bool operator!=(std::nullptr_t) const { return m_Ptr != nullptr; }
+
+	private:
+		void Release()
+		{
+			if (m_Ptr && m_Ptr->DecRef())
+			{
+				m_Ptr->Destroy();
+			}
+		}
+
+	private:
+		template<typename U>
+		friend class Ref;
+
+		T* m_Ptr = nullptr;
+
+	};
+
+	/** Construct an object in the pool dedicated to its type. */
+	template<typename T, typename ... Args>
+	Ref<T> CreateRef(Args&& ... args)
+	{
+		PoolAllocator& pool = PoolAllocator::GetTypePool<T>();
+		void* block = pool.Allocate();
+		T* object = nullptr;
+		try
+		{
+			object = new (block) T(std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			// The block would be lost otherwise as nothing refers to it yet
+			pool.Deallocate(block);
+			throw;
+		}
+		object->m_Pool = &pool;
+		return Ref<T>(object);
+	}
+
+}
@@ -20,12 +20,14 @@
 #include <fstream>
 
 #include <thread>
+#include <mutex>
 
 namespace ZeoEngine {
 
 	struct ProfileResult
 	{
-		std::string Name;
+		/** Points to a string literal, copying it would put heap allocations into every profiled scope */
+		const char* Name;
 		long long Start, End;
 		uint32_t ThreadID;
 	};
@@ -41,6 +43,8 @@ namespace ZeoEngine {
 		InstrumentationSession* m_CurrentSession;
 		std::ofstream m_OutputStream;
 		int m_ProfileCount;
+		/** Scopes are profiled on job workers as well */
+		std::mutex m_Mutex;
 	public:
 		Instrumentor()
 			: m_CurrentSession(nullptr), m_ProfileCount(0)
@@ -49,6 +53,7 @@ namespace ZeoEngine {
 
 		void BeginSession(const std::string& name, const std::string& filePath = "results.json")
 		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
 			m_OutputStream.open(filePath);
 			WriteHeader();
 			m_CurrentSession = new InstrumentationSession{ name };
@@ -56,6 +61,7 @@ namespace ZeoEngine {
 
 		void EndSession()
 		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
 			WriteFooter();
 			m_OutputStream.close();
 			delete m_CurrentSession;
@@ -65,16 +71,21 @@ namespace ZeoEngine {
 
 		void WriteProfile(const ProfileResult& result)
 		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+
 			if (m_ProfileCount++ > 0)
 				m_OutputStream << ",";
 
-			std::string name = result.Name;
-			std::replace(name.begin(), name.end(), '"', '\'');
-
 			m_OutputStream << "{";
 			m_OutputStream << "\"cat\":\"function\",";
 			m_OutputStream << "\"dur\":" << (result.End - result.Start) << ',';
-			m_OutputStream << "\"name\":\"" << name << "\",";
+			m_OutputStream << "\"name\":\"";
+			// Quotes would break the json format
+			for (const char* c = result.Name; *c; ++c)
+			{
+				m_OutputStream.put(*c == '"' ? '\'' : *c);
+			}
+			m_OutputStream << "\",";
 			m_OutputStream << "\"ph\":\"X\",";
 			m_OutputStream << "\"pid\":0,";
 			m_OutputStream << "\"tid\":" << result.ThreadID << ",";
@@ -84,6 +95,34 @@ namespace ZeoEngine {
 			m_OutputStream.flush();
 		}
 
+		/** Write a counter event which is shown as a stacked graph of all values in the trace viewer. */
+		void WriteCounters(const char* name, const char* const* valueNames, const int64_t* values, uint32_t count)
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+
+			if (!m_CurrentSession)
+				return;
+
+			if (m_ProfileCount++ > 0)
+				m_OutputStream << ",";
+
+			long long timestamp = std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now()).time_since_epoch().count();
+
+			m_OutputStream << "{";
+			m_OutputStream << "\"name\":\"" << name << "\",";
+			m_OutputStream << "\"ph\":\"C\",";
+			m_OutputStream << "\"pid\":0,";
+			m_OutputStream << "\"ts\":" << timestamp << ",";
+			m_OutputStream << "\"args\":{";
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				m_OutputStream << (i > 0 ? "," : "") << "\"" << valueNames[i] << "\":" << values[i];
+			}
+			m_OutputStream << "}}";
+
+			m_OutputStream.flush();
+		}
+
 		void WriteHeader()
 		{
 			m_OutputStream << "{\"otherData\": {},\"traceEvents\":[";
@@ -0,0 +1,265 @@
+#include "ZEpch.h"
+#include "Engine/Debug/MemoryTracker.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#ifdef ZE_PLATFORM_WINDOWS
+	#include <malloc.h>
+#endif // ZE_PLATFORM_WINDOWS
+
+namespace ZeoEngine {
+
+	/** Stored in front of every tracked allocation */
+	struct AllocationHeader
+	{
+		uint64_t Size;
+		MemoryTag Tag;
+	};
+
+	/** Keeps memory returned by the default new aligned to __STDCPP_DEFAULT_NEW_ALIGNMENT__ */
+	static constexpr size_t s_HeaderSize = 16;
+	static_assert(sizeof(AllocationHeader) <= s_HeaderSize, "Allocation header is too large!");
+
+	struct TagCounters
+	{
+		std::atomic<uint64_t> LiveBytes{ 0 };
+		std::atomic<uint64_t> PeakBytes{ 0 };
+		std::atomic<uint64_t> LiveAllocations{ 0 };
+		std::atomic<uint64_t> TotalAllocations{ 0 };
+		std::atomic<uint64_t> FrameAllocations{ 0 };
+		std::atomic<uint64_t> FrameBytes{ 0 };
+
+		// Written by the main thread only
+		uint64_t LastFrameAllocations = 0;
+		uint64_t LastFrameBytes = 0;
+	};
+
+	// These are used by operator new before any dynamic initialization, so they must be constant-initialized
+	static TagCounters s_Counters[static_cast<size_t>(MemoryTag::Count)];
+	static std::atomic<bool> s_bZeroAllocationCheck{ false };
+	static thread_local MemoryTag s_CurrentTag = MemoryTag::General;
+
+	static void RecordAllocation(uint64_t size, MemoryTag tag)
+	{
+		TagCounters& counters = s_Counters[static_cast<size_t>(tag)];
+		uint64_t liveBytes = counters.LiveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+		counters.LiveAllocations.fetch_add(1, std::memory_order_relaxed);
+		counters.TotalAllocations.fetch_add(1, std::memory_order_relaxed);
+		counters.FrameAllocations.fetch_add(1, std::memory_order_relaxed);
+		counters.FrameBytes.fetch_add(size, std::memory_order_relaxed);
+
+		uint64_t peakBytes = counters.PeakBytes.load(std::memory_order_relaxed);
+		while (liveBytes > peakBytes && !counters.PeakBytes.compare_exchange_weak(peakBytes, liveBytes, std::memory_order_relaxed));
+	}
+
+	static void RecordDeallocation(uint64_t size, MemoryTag tag)
+	{
+		TagCounters& counters = s_Counters[static_cast<size_t>(tag)];
+		counters.LiveBytes.fetch_sub(size, std::memory_order_relaxed);
+		counters.LiveAllocations.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	static void* PlatformAlignedAlloc(size_t size, size_t alignment)
+	{
+#ifdef ZE_PLATFORM_WINDOWS
+		return _aligned_malloc(size, alignment);
+#else
+		return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif // ZE_PLATFORM_WINDOWS
+	}
+
+	static void PlatformAlignedFree(void* ptr)
+	{
+#ifdef ZE_PLATFORM_WINDOWS
+		_aligned_free(ptr);
+#else
+		std::free(ptr);
+#endif // ZE_PLATFORM_WINDOWS
+	}
+
+	void* MemoryTracker::Allocate(size_t size, MemoryTag tag)
+	{
+		uint8_t* block = static_cast<uint8_t*>(std::malloc(size + s_HeaderSize));
+		if (!block)
+			return nullptr;
+
+		new (block) AllocationHeader{ size, tag };
+		RecordAllocation(size, tag);
+		return block + s_HeaderSize;
+	}
+
+	void MemoryTracker::Free(void* ptr)
+	{
+		if (!ptr)
+			return;
+
+		uint8_t* block = static_cast<uint8_t*>(ptr) - s_HeaderSize;
+		const AllocationHeader* header = reinterpret_cast<const AllocationHeader*>(block);
+		RecordDeallocation(header->Size, header->Tag);
+		std::free(block);
+	}
+
+	void* MemoryTracker::AllocateAligned(size_t size, size_t alignment, MemoryTag tag)
+	{
+		// Header takes a whole alignment unit so that the returned pointer stays aligned
+		const size_t headerSize = alignment > s_HeaderSize ? alignment : s_HeaderSize;
+		uint8_t* block = static_cast<uint8_t*>(PlatformAlignedAlloc(size + headerSize, alignment));
+		if (!block)
+			return nullptr;
+
+		uint8_t* ptr = block + headerSize;
+		new (ptr - s_HeaderSize) AllocationHeader{ size, tag };
+		RecordAllocation(size, tag);
+		return ptr;
+	}
+
+	void MemoryTracker::FreeAligned(void* ptr, size_t alignment)
+	{
+		if (!ptr)
+			return;
+
+		const size_t headerSize = alignment > s_HeaderSize ? alignment : s_HeaderSize;
+		uint8_t* bytes = static_cast<uint8_t*>(ptr);
+		const AllocationHeader* header = reinterpret_cast<const AllocationHeader*>(bytes - s_HeaderSize);
+		RecordDeallocation(header->Size, header->Tag);
+		PlatformAlignedFree(bytes - headerSize);
+	}
+
+	MemoryTag MemoryTracker::GetCurrentTag()
+	{
+		return s_CurrentTag;
+	}
+
+	void MemoryTracker::SetCurrentTag(MemoryTag tag)
+	{
+		s_CurrentTag = tag;
+	}
+
+	void MemoryTracker::BeginFrame()
+	{
+		if (!IsEnabled())
+			return;
+
+		ZE_PROFILE_FUNCTION();
+
+		const char* names[static_cast<size_t>(MemoryTag::Count)];
+		int64_t liveBytes[static_cast<size_t>(MemoryTag::Count)];
+		for (size_t i = 0; i < static_cast<size_t>(MemoryTag::Count); ++i)
+		{
+			TagCounters& counters = s_Counters[i];
+			counters.LastFrameAllocations = counters.FrameAllocations.exchange(0, std::memory_order_relaxed);
+			counters.LastFrameBytes = counters.FrameBytes.exchange(0, std::memory_order_relaxed);
+
+			names[i] = GetTagName(static_cast<MemoryTag>(i));
+			liveBytes[i] = static_cast<int64_t>(counters.LiveBytes.load(std::memory_order_relaxed));
+		}
+		Instrumentor::Get().WriteCounters("Heap Memory", names, liveBytes, static_cast<uint32_t>(MemoryTag::Count));
+
+		if (IsZeroAllocationCheckEnabled())
+		{
+			for (size_t i = 0; i < static_cast<size_t>(MemoryTag::Count); ++i)
+			{
+				const TagCounters& counters = s_Counters[i];
+				if (counters.LastFrameAllocations > 0)
+				{
+					ZE_CORE_WARN("{0} made {1} allocations ({2} bytes) during last frame", names[i], counters.LastFrameAllocations, counters.LastFrameBytes);
+				}
+			}
+		}
+	}
+
+	MemoryStats MemoryTracker::GetStats(MemoryTag tag)
+	{
+		const TagCounters& counters = s_Counters[static_cast<size_t>(tag)];
+		MemoryStats stats;
+		stats.LiveBytes = counters.LiveBytes.load(std::memory_order_relaxed);
+		stats.PeakBytes = counters.PeakBytes.load(std::memory_order_relaxed);
+		stats.LiveAllocations = counters.LiveAllocations.load(std::memory_order_relaxed);
+		stats.TotalAllocations = counters.TotalAllocations.load(std::memory_order_relaxed);
+		stats.FrameAllocations = counters.LastFrameAllocations;
+		stats.FrameBytes = counters.LastFrameBytes;
+		return stats;
+	}
+
+	MemoryStats MemoryTracker::GetTotalStats()
+	{
+		MemoryStats total;
+		for (size_t i = 0; i < static_cast<size_t>(MemoryTag::Count); ++i)
+		{
+			MemoryStats stats = GetStats(static_cast<MemoryTag>(i));
+			total.LiveBytes += stats.LiveBytes;
+			// Sum of per-tag peaks, which is an upper bound of the overall peak
+			total.PeakBytes += stats.PeakBytes;
+			total.LiveAllocations += stats.LiveAllocations;
+			total.TotalAllocations += stats.TotalAllocations;
+			total.FrameAllocations += stats.FrameAllocations;
+			total.FrameBytes += stats.FrameBytes;
+		}
+		return total;
+	}
+
+	const char* MemoryTracker::GetTagName(MemoryTag tag)
+	{
+		switch (tag)
+		{
+		case MemoryTag::General:
+			return "General";
+		case MemoryTag::Renderer:
+			return "Renderer";
+		case MemoryTag::Textures:
+			return "Textures";
+		case MemoryTag::Events:
+			return "Events";
+		case MemoryTag::Layers:
+			return "Layers";
+		case MemoryTag::ImGui:
+			return "ImGui";
+		default:
+			return "Unknown";
+		}
+	}
+
+	void MemoryTracker::SetZeroAllocationCheckEnabled(bool bEnabled)
+	{
+		s_bZeroAllocationCheck = bEnabled;
+	}
+
+	bool MemoryTracker::IsZeroAllocationCheckEnabled()
+	{
+		return s_bZeroAllocationCheck;
+	}
+
+}
+
+#ifdef ZE_TRACK_MEMORY
+
+// Nothrow, array and sized variants are not replaced as their default versions forward to these
+
+void* operator new(size_t size)
+{
+	void* ptr = ::ZeoEngine::MemoryTracker::Allocate(size, ::ZeoEngine::MemoryTracker::GetCurrentTag());
+	if (!ptr)
+		throw std::bad_alloc();
+	return ptr;
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+	void* ptr = ::ZeoEngine::MemoryTracker::AllocateAligned(size, static_cast<size_t>(alignment), ::ZeoEngine::MemoryTracker::GetCurrentTag());
+	if (!ptr)
+		throw std::bad_alloc();
+	return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+	::ZeoEngine::MemoryTracker::Free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t alignment) noexcept
+{
+	::ZeoEngine::MemoryTracker::FreeAligned(ptr, static_cast<size_t>(alignment));
+}
+
+#endif // ZE_TRACK_MEMORY
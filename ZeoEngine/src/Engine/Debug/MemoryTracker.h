@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ZeoEngine {
+
+	/** Subsystems heap allocations are attributed to. */
+	enum class MemoryTag : uint8_t
+	{
+		General = 0,
+		Renderer,
+		Textures,
+		Events,
+		Layers,
+		ImGui,
+		Count
+	};
+
+	struct MemoryStats
+	{
+		uint64_t LiveBytes = 0;
+		uint64_t PeakBytes = 0;
+		uint64_t LiveAllocations = 0;
+		uint64_t TotalAllocations = 0;
+		/** Allocations made during the last complete frame */
+		uint64_t FrameAllocations = 0;
+		uint64_t FrameBytes = 0;
+	};
+
+	/**
+	 * Keeps per-tag heap statistics.
+	 *
+	 * If ZE_TRACK_MEMORY is defined, global operator new/delete are replaced
+	 * and every allocation is attributed to the tag of the innermost ZE_MEMORY_TAG scope on the allocating thread.
+	 * Each allocation then carries a small header recording its size and tag, so that frees are attributed correctly.
+	 * Tracking is off by default, ZE_MEMORY_TAG then expands to nothing and the statistics stay zero.
+	 */
+	class MemoryTracker
+	{
+	public:
+		/** Allocate tracked memory, which must be released with Free(). */
+		static void* Allocate(size_t size, MemoryTag tag);
+		static void Free(void* ptr);
+		/** Alignment must be a power of two. Memory must be released with FreeAligned() passing the same alignment. */
+		static void* AllocateAligned(size_t size, size_t alignment, MemoryTag tag);
+		static void FreeAligned(void* ptr, size_t alignment);
+
+		static MemoryTag GetCurrentTag();
+		static void SetCurrentTag(MemoryTag tag);
+
+		/** Close statistics of the last frame and emit them into the profiling session. Called by Application at the start of every frame. */
+		static void BeginFrame();
+
+		static MemoryStats GetStats(MemoryTag tag);
+		static MemoryStats GetTotalStats();
+		static const char* GetTagName(MemoryTag tag);
+
+		/** If enabled, a warning is logged for every tag which has allocated memory during the last frame. */
+		static void SetZeroAllocationCheckEnabled(bool bEnabled);
+		static bool IsZeroAllocationCheckEnabled();
+
+		static constexpr bool IsEnabled()
+		{
+#ifdef ZE_TRACK_MEMORY
+			return true;
+#else
+			return false;
+#endif // ZE_TRACK_MEMORY
+		}
+	};
+
+	/** Attribute allocations made on this thread to a tag until the end of the scope. */
+	class MemoryTagScope
+	{
+	public:
+		MemoryTagScope(MemoryTag tag)
+			: m_PreviousTag(MemoryTracker::GetCurrentTag())
+		{
+			MemoryTracker::SetCurrentTag(tag);
+		}
+
+		~MemoryTagScope()
+		{
+			MemoryTracker::SetCurrentTag(m_PreviousTag);
+		}
+
+	private:
+		MemoryTag m_PreviousTag;
+
+	};
+
+}
+
+#ifdef ZE_TRACK_MEMORY
+	#define ZE_MEMORY_TAG(tag) ::ZeoEngine::MemoryTagScope memoryTagScope(::ZeoEngine::MemoryTag::tag);
+#else
+	#define ZE_MEMORY_TAG(tag)
+#endif // ZE_TRACK_MEMORY
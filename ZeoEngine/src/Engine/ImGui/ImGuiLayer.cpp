@@ -20,9 +20,28 @@ namespace ZeoEngine {
 	{
 	}
 
+#ifdef ZE_TRACK_MEMORY
+	// ImGui allocates with malloc() by default which bypasses operator new
+	static void* ImGuiAlloc(size_t size, void*)
+	{
+		return MemoryTracker::Allocate(size, MemoryTag::ImGui);
+	}
+
+	static void ImGuiFree(void* ptr, void*)
+	{
+		MemoryTracker::Free(ptr);
+	}
+#endif // ZE_TRACK_MEMORY
+
 	void ImGuiLayer::OnAttach()
 	{
 		ZE_PROFILE_FUNCTION();
+		ZE_MEMORY_TAG(ImGui);
+
+#ifdef ZE_TRACK_MEMORY
+		// This must be set before any memory is allocated by ImGui
+		ImGui::SetAllocatorFunctions(ImGuiAlloc, ImGuiFree);
+#endif // ZE_TRACK_MEMORY
 
 		// Setup Dear ImGui context
 		IMGUI_CHECKVERSION();
@@ -59,6 +78,7 @@ namespace ZeoEngine {
 	void ImGuiLayer::OnDetach()
 	{
 		ZE_PROFILE_FUNCTION();
+		ZE_MEMORY_TAG(ImGui);
 
 		ImGui_ImplOpenGL3_Shutdown();
 		ImGui_ImplGlfw_Shutdown();
@@ -68,6 +88,7 @@ namespace ZeoEngine {
 	void ImGuiLayer::Begin()
 	{
 		ZE_PROFILE_FUNCTION();
+		ZE_MEMORY_TAG(ImGui);
 
 		ImGui_ImplOpenGL3_NewFrame();
 		ImGui_ImplGlfw_NewFrame();
@@ -77,6 +98,7 @@ namespace ZeoEngine {
 	void ImGuiLayer::End()
 	{
 		ZE_PROFILE_FUNCTION();
+		ZE_MEMORY_TAG(ImGui);
 
 		ImGuiIO& io = ImGui::GetIO();
 		Application& app = Application::Get();
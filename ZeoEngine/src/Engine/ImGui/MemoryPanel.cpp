@@ -0,0 +1,58 @@
+#include "ZEpch.h"
+#include "Engine/ImGui/MemoryPanel.h"
+
+#include <imgui.h>
+
+#include "Engine/Debug/MemoryTracker.h"
+
+namespace ZeoEngine {
+
+	static void DrawStatsRow(const char* name, const MemoryStats& stats)
+	{
+		ImGui::Text("%s", name); ImGui::NextColumn();
+		ImGui::Text("%.1f KB", stats.LiveBytes / 1024.0f); ImGui::NextColumn();
+		ImGui::Text("%.1f KB", stats.PeakBytes / 1024.0f); ImGui::NextColumn();
+		ImGui::Text("%llu", (unsigned long long)stats.LiveAllocations); ImGui::NextColumn();
+		ImGui::Text("%llu (%.1f KB)", (unsigned long long)stats.FrameAllocations, stats.FrameBytes / 1024.0f); ImGui::NextColumn();
+	}
+
+	void MemoryPanel::OnImGuiRender()
+	{
+		ZE_PROFILE_FUNCTION();
+
+		ImGui::Begin("Memory");
+
+		if (!MemoryTracker::IsEnabled())
+		{
+			ImGui::Text("Memory tracking is disabled, build with ZE_TRACK_MEMORY defined to enable it.");
+			ImGui::End();
+			return;
+		}
+
+		bool bZeroAllocationCheck = MemoryTracker::IsZeroAllocationCheckEnabled();
+		if (ImGui::Checkbox("Warn on per-frame allocations", &bZeroAllocationCheck))
+		{
+			MemoryTracker::SetZeroAllocationCheckEnabled(bZeroAllocationCheck);
+		}
+
+		ImGui::Columns(5, "MemoryStats");
+		ImGui::Separator();
+		ImGui::Text("Tag"); ImGui::NextColumn();
+		ImGui::Text("Live"); ImGui::NextColumn();
+		ImGui::Text("Peak"); ImGui::NextColumn();
+		ImGui::Text("Allocations"); ImGui::NextColumn();
+		ImGui::Text("Last Frame"); ImGui::NextColumn();
+		ImGui::Separator();
+		for (uint8_t i = 0; i < static_cast<uint8_t>(MemoryTag::Count); ++i)
+		{
+			MemoryTag tag = static_cast<MemoryTag>(i);
+			DrawStatsRow(MemoryTracker::GetTagName(tag), MemoryTracker::GetStats(tag));
+		}
+		ImGui::Separator();
+		DrawStatsRow("Total", MemoryTracker::GetTotalStats());
+		ImGui::Columns(1);
+
+		ImGui::End();
+	}
+
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+namespace ZeoEngine {
+
+	/** Draws heap statistics collected by MemoryTracker. */
+	class MemoryPanel
+	{
+	public:
+		static void OnImGuiRender();
+	};
+
+}
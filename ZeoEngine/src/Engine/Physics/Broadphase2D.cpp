@@ -0,0 +1,93 @@
+#include "ZEpch.h"
+#include "Engine/Physics/Broadphase2D.h"
+
+namespace ZeoEngine {
+
+	static const uint32_t s_InvalidProxyIndex = ~0u;
+
+	void Broadphase2D::Insert(uint32_t id, const Bounds2D& bounds, bool bActive)
+	{
+		if (id >= m_ProxyIndices.size())
+		{
+			m_ProxyIndices.resize(id + 1, s_InvalidProxyIndex);
+		}
+		ZE_CORE_ASSERT(m_ProxyIndices[id] == s_InvalidProxyIndex, "Proxy already exists!");
+
+		m_ProxyIndices[id] = static_cast<uint32_t>(m_Proxies.size());
+		m_Proxies.push_back({ bounds.Min.x, bounds.Max.x, bounds.Min.y, bounds.Max.y, id, bActive, false });
+		++m_Count;
+		++m_InsertedCount;
+	}
+
+	Broadphase2D::Proxy& Broadphase2D::GetProxy(uint32_t id)
+	{
+		ZE_CORE_ASSERT(id < m_ProxyIndices.size() && m_ProxyIndices[id] != s_InvalidProxyIndex, "Proxy does not exist!");
+
+		return m_Proxies[m_ProxyIndices[id]];
+	}
+
+	void Broadphase2D::Update(uint32_t id, const Bounds2D& bounds)
+	{
+		Proxy& proxy = GetProxy(id);
+		proxy.MinX = bounds.Min.x;
+		proxy.MaxX = bounds.Max.x;
+		proxy.MinY = bounds.Min.y;
+		proxy.MaxY = bounds.Max.y;
+	}
+
+	void Broadphase2D::SetActive(uint32_t id, bool bActive)
+	{
+		GetProxy(id).bActive = bActive;
+	}
+
+	void Broadphase2D::Remove(uint32_t id)
+	{
+		Proxy& proxy = GetProxy(id);
+		// Removed proxies are skipped by the sweep as inactive and never match anything
+		proxy.bRemoved = true;
+		proxy.bActive = false;
+		proxy.MinX = proxy.MinY = std::numeric_limits<float>::max();
+		proxy.MaxX = proxy.MaxY = std::numeric_limits<float>::lowest();
+		m_ProxyIndices[id] = s_InvalidProxyIndex;
+		--m_Count;
+		m_bHasRemoved = true;
+	}
+
+	void Broadphase2D::Sort()
+	{
+		ZE_PROFILE_FUNCTION();
+
+		if (m_bHasRemoved)
+		{
+			m_Proxies.erase(std::remove_if(m_Proxies.begin(), m_Proxies.end(), [](const Proxy& proxy) { return proxy.bRemoved; }), m_Proxies.end());
+			m_bHasRemoved = false;
+		}
+
+		const uint32_t proxyCount = static_cast<uint32_t>(m_Proxies.size());
+		if (m_InsertedCount > proxyCount / 8)
+		{
+			std::sort(m_Proxies.begin(), m_Proxies.end(), [](const Proxy& lhs, const Proxy& rhs) { return lhs.MinX < rhs.MinX; });
+		}
+		else
+		{
+			for (uint32_t i = 1; i < proxyCount; ++i)
+			{
+				const Proxy proxy = m_Proxies[i];
+				uint32_t j = i;
+				while (j > 0 && m_Proxies[j - 1].MinX > proxy.MinX)
+				{
+					m_Proxies[j] = m_Proxies[j - 1];
+					--j;
+				}
+				m_Proxies[j] = proxy;
+			}
+		}
+		m_InsertedCount = 0;
+
+		for (uint32_t i = 0; i < proxyCount; ++i)
+		{
+			m_ProxyIndices[m_Proxies[i].Id] = i;
+		}
+	}
+
+}
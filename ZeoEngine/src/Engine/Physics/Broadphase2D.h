@@ -0,0 +1,71 @@
+#pragma once
+
+#include <vector>
+
+#include "Engine/Renderer/Culling2D.h"
+
+namespace ZeoEngine {
+
+	/**
+	 * Sweep and prune along the x axis. Proxies are kept sorted by the left edge of their bounds,
+	 * which is close to linear with insertion sort as bounds move little between steps, and pairs are found by a single sweep over the sorted list.
+	 * Only pairs involving at least one active proxy are reported, so sleeping and static objects resting on each other cost nothing but the sweep.
+	 */
+	class Broadphase2D
+	{
+	public:
+		/** id is chosen by the caller and must be unique, e.g. the index of a body. */
+		void Insert(uint32_t id, const Bounds2D& bounds, bool bActive);
+		void Update(uint32_t id, const Bounds2D& bounds);
+		void SetActive(uint32_t id, bool bActive);
+		void Remove(uint32_t id);
+
+		uint32_t GetCount() const { return m_Count; }
+
+		/** Calls func(idA, idB) once for every pair of proxies whose bounds overlap and at least one of which is active. */
+		template<typename Func>
+		void FindPairs(Func&& func)
+		{
+			Sort();
+
+			const uint32_t proxyCount = static_cast<uint32_t>(m_Proxies.size());
+			for (uint32_t i = 0; i < proxyCount; ++i)
+			{
+				const Proxy& proxyA = m_Proxies[i];
+				for (uint32_t j = i + 1; j < proxyCount && m_Proxies[j].MinX <= proxyA.MaxX; ++j)
+				{
+					const Proxy& proxyB = m_Proxies[j];
+					if (!proxyA.bActive && !proxyB.bActive)
+						continue;
+					if (proxyA.MaxY < proxyB.MinY || proxyB.MaxY < proxyA.MinY)
+						continue;
+
+					func(proxyA.Id, proxyB.Id);
+				}
+			}
+		}
+
+	private:
+		struct Proxy
+		{
+			float MinX, MaxX, MinY, MaxY;
+			uint32_t Id;
+			bool bActive;
+			bool bRemoved;
+		};
+
+		/** Drop removed proxies and restore the order by left edge. */
+		void Sort();
+		Proxy& GetProxy(uint32_t id);
+
+	private:
+		std::vector<Proxy> m_Proxies;
+		/** Position of each proxy in m_Proxies indexed by id, rebuilt after sorting */
+		std::vector<uint32_t> m_ProxyIndices;
+		uint32_t m_Count = 0;
+		/** Proxies inserted since the last sort, many of them are sorted from scratch instead of one by one */
+		uint32_t m_InsertedCount = 0;
+		bool m_bHasRemoved = false;
+	};
+
+}
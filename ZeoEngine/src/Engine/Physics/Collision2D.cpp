@@ -0,0 +1,233 @@
+#include "ZEpch.h"
+#include "Engine/Physics/Collision2D.h"
+
+namespace ZeoEngine {
+
+	static bool CollideCircles(float radiusA, const glm::vec2& centerA, float radiusB, const glm::vec2& centerB, float margin, ContactManifold2D& outManifold)
+	{
+		const glm::vec2 delta = centerB - centerA;
+		const float distance = glm::length(delta);
+		const float separation = distance - radiusA - radiusB;
+		if (separation > margin)
+			return false;
+
+		// Concentric circles are pushed apart along an arbitrary axis
+		const glm::vec2 normal = distance > 1e-6f ? delta / distance : glm::vec2(0.0f, 1.0f);
+		outManifold.Normal = normal;
+		outManifold.Points[0].Position = 0.5f * (centerA + normal * radiusA + centerB - normal * radiusB);
+		outManifold.Points[0].Separation = separation;
+		outManifold.Points[0].Id = 0;
+		outManifold.PointCount = 1;
+		return true;
+	}
+
+	/** The normal points from the box to the circle. */
+	static bool CollideBoxCircle(const glm::vec2& halfExtents, const Transform2D& boxTransform, float radius, const glm::vec2& center, float margin, ContactManifold2D& outManifold)
+	{
+		const glm::vec2 localCenter = boxTransform.ApplyInverse(center);
+		const glm::vec2 clampedCenter = glm::clamp(localCenter, -halfExtents, halfExtents);
+
+		glm::vec2 localNormal, localClosest;
+		float separation;
+		if (clampedCenter == localCenter)
+		{
+			// Center is inside the box, push the circle out through the nearest face
+			const glm::vec2 faceDistances = halfExtents - glm::abs(localCenter);
+			const uint32_t axis = faceDistances.x < faceDistances.y ? 0 : 1;
+			const float sign = localCenter[axis] >= 0.0f ? 1.0f : -1.0f;
+			localNormal = glm::vec2(0.0f);
+			localNormal[axis] = sign;
+			localClosest = localCenter;
+			localClosest[axis] = sign * halfExtents[axis];
+			separation = -faceDistances[axis] - radius;
+		}
+		else
+		{
+			const glm::vec2 delta = localCenter - clampedCenter;
+			const float distance = glm::length(delta);
+			localNormal = delta / distance;
+			localClosest = clampedCenter;
+			separation = distance - radius;
+		}
+		if (separation > margin)
+			return false;
+
+		const glm::vec2 normal = boxTransform.Rotate(localNormal);
+		outManifold.Normal = normal;
+		outManifold.Points[0].Position = 0.5f * (boxTransform.Apply(localClosest) + center - normal * radius);
+		outManifold.Points[0].Separation = separation;
+		outManifold.Points[0].Id = 0;
+		outManifold.PointCount = 1;
+		return true;
+	}
+
+	/** Keep the part of the segment where dot(normal, point) <= offset, points created by clipping are given clipId. Returns the number of points kept. */
+	static uint32_t ClipSegment(glm::vec2 points[2], uint32_t ids[2], const glm::vec2& normal, float offset, uint32_t clipId)
+	{
+		const float distance0 = glm::dot(normal, points[0]) - offset;
+		const float distance1 = glm::dot(normal, points[1]) - offset;
+
+		glm::vec2 clippedPoints[2];
+		uint32_t clippedIds[2];
+		uint32_t count = 0;
+		if (distance0 <= 0.0f)
+		{
+			clippedPoints[count] = points[0];
+			clippedIds[count++] = ids[0];
+		}
+		if (distance1 <= 0.0f)
+		{
+			clippedPoints[count] = points[1];
+			clippedIds[count++] = ids[1];
+		}
+		if (distance0 * distance1 < 0.0f)
+		{
+			clippedPoints[count] = points[0] + (distance0 / (distance0 - distance1)) * (points[1] - points[0]);
+			clippedIds[count++] = clipId;
+		}
+
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			points[i] = clippedPoints[i];
+			ids[i] = clippedIds[i];
+		}
+		return count;
+	}
+
+	static bool CollideBoxes(const glm::vec2& halfExtentsA, const Transform2D& transformA, const glm::vec2& halfExtentsB, const Transform2D& transformB, float margin,
+		ContactManifold2D& outManifold)
+	{
+		const glm::vec2 axesA[2] = { transformA.GetAxisX(), transformA.GetAxisY() };
+		const glm::vec2 axesB[2] = { transformB.GetAxisX(), transformB.GetAxisY() };
+		const glm::vec2 delta = transformB.Position - transformA.Position;
+
+		// Separation along each face normal of both boxes, any positive one is a separating axis
+		float separationsA[2], separationsB[2];
+		for (uint32_t i = 0; i < 2; ++i)
+		{
+			separationsA[i] = glm::abs(glm::dot(delta, axesA[i])) - halfExtentsA[i] -
+				(halfExtentsB.x * glm::abs(glm::dot(axesB[0], axesA[i])) + halfExtentsB.y * glm::abs(glm::dot(axesB[1], axesA[i])));
+			if (separationsA[i] > margin)
+				return false;
+		}
+		for (uint32_t i = 0; i < 2; ++i)
+		{
+			separationsB[i] = glm::abs(glm::dot(delta, axesB[i])) - halfExtentsB[i] -
+				(halfExtentsA.x * glm::abs(glm::dot(axesA[0], axesB[i])) + halfExtentsA.y * glm::abs(glm::dot(axesA[1], axesB[i])));
+			if (separationsB[i] > margin)
+				return false;
+		}
+
+		// The axis of least penetration gives the reference face.
+		// Faces tested first are preferred unless another one is clearly better, so that the choice does not flip between steps of a resting stack
+		static const float relativeTolerance = 0.95f;
+		static const float absoluteTolerance = 0.01f;
+		bool bReferenceIsA = true;
+		uint32_t referenceAxis = 0;
+		float separation = separationsA[0];
+		if (separationsA[1] > relativeTolerance * separation + absoluteTolerance * halfExtentsA.y)
+		{
+			referenceAxis = 1;
+			separation = separationsA[1];
+		}
+		for (uint32_t i = 0; i < 2; ++i)
+		{
+			if (separationsB[i] > relativeTolerance * separation + absoluteTolerance * halfExtentsB[i])
+			{
+				bReferenceIsA = false;
+				referenceAxis = i;
+				separation = separationsB[i];
+			}
+		}
+
+		const Transform2D& referenceTransform = bReferenceIsA ? transformA : transformB;
+		const Transform2D& incidentTransform = bReferenceIsA ? transformB : transformA;
+		const glm::vec2& referenceHalfExtents = bReferenceIsA ? halfExtentsA : halfExtentsB;
+		const glm::vec2& incidentHalfExtents = bReferenceIsA ? halfExtentsB : halfExtentsA;
+		const glm::vec2* referenceAxes = bReferenceIsA ? axesA : axesB;
+		const glm::vec2* incidentAxes = bReferenceIsA ? axesB : axesA;
+
+		// Normal of the reference face, pointing towards the incident box
+		glm::vec2 normal = referenceAxes[referenceAxis];
+		if (glm::dot(incidentTransform.Position - referenceTransform.Position, normal) < 0.0f)
+		{
+			normal = -normal;
+		}
+
+		// The incident face is the face of the other box most facing the reference face
+		const float incidentDots[2] = { glm::dot(normal, incidentAxes[0]), glm::dot(normal, incidentAxes[1]) };
+		const uint32_t incidentAxis = glm::abs(incidentDots[0]) > glm::abs(incidentDots[1]) ? 0 : 1;
+		const glm::vec2 incidentNormal = incidentDots[incidentAxis] > 0.0f ? -incidentAxes[incidentAxis] : incidentAxes[incidentAxis];
+		const glm::vec2 incidentCenter = incidentTransform.Position + incidentNormal * incidentHalfExtents[incidentAxis];
+		const glm::vec2 incidentTangent = incidentAxes[1 - incidentAxis] * incidentHalfExtents[1 - incidentAxis];
+		glm::vec2 points[2] = { incidentCenter - incidentTangent, incidentCenter + incidentTangent };
+		uint32_t ids[2] = { 0, 1 };
+
+		// Clip the incident face against the side planes of the reference face
+		const glm::vec2 sideNormal = referenceAxes[1 - referenceAxis];
+		const float sideCenter = glm::dot(sideNormal, referenceTransform.Position);
+		const float sideExtent = referenceHalfExtents[1 - referenceAxis];
+		if (ClipSegment(points, ids, sideNormal, sideCenter + sideExtent, 2) < 2)
+			return false;
+		if (ClipSegment(points, ids, -sideNormal, -sideCenter + sideExtent, 3) < 2)
+			return false;
+
+		// Points are reported with the normal from A to B, features are told apart by the choice of faces and the vertex or clip plane
+		const uint32_t faceId = (bReferenceIsA ? 0u : 1u) | (referenceAxis << 1) | (incidentAxis << 2);
+		const float referenceOffset = glm::dot(normal, referenceTransform.Position) + referenceHalfExtents[referenceAxis];
+		outManifold.Normal = bReferenceIsA ? normal : -normal;
+		outManifold.PointCount = 0;
+		for (uint32_t i = 0; i < 2; ++i)
+		{
+			const float pointSeparation = glm::dot(normal, points[i]) - referenceOffset;
+			if (pointSeparation > margin)
+				continue;
+
+			ContactPoint2D& contact = outManifold.Points[outManifold.PointCount++];
+			contact.Position = points[i] - 0.5f * pointSeparation * normal;
+			contact.Separation = pointSeparation;
+			contact.Id = faceId | (ids[i] << 3);
+		}
+		return outManifold.PointCount > 0;
+	}
+
+	bool Collision2D::Collide(const Shape2D& shapeA, const Transform2D& transformA, const Shape2D& shapeB, const Transform2D& transformB, float margin,
+		ContactManifold2D& outManifold)
+	{
+		if (shapeA.Type == ShapeType2D::Box)
+		{
+			if (shapeB.Type == ShapeType2D::Box)
+				return CollideBoxes(shapeA.HalfExtents, transformA, shapeB.HalfExtents, transformB, margin, outManifold);
+
+			return CollideBoxCircle(shapeA.HalfExtents, transformA, shapeB.Radius, transformB.Position, margin, outManifold);
+		}
+
+		if (shapeB.Type == ShapeType2D::Box)
+		{
+			if (!CollideBoxCircle(shapeB.HalfExtents, transformB, shapeA.Radius, transformA.Position, margin, outManifold))
+				return false;
+
+			outManifold.Normal = -outManifold.Normal;
+			return true;
+		}
+
+		return CollideCircles(shapeA.Radius, transformA.Position, shapeB.Radius, transformB.Position, margin, outManifold);
+	}
+
+	Bounds2D Collision2D::ComputeBounds(const Shape2D& shape, const Transform2D& transform)
+	{
+		glm::vec2 extent{ 0.0f };
+		switch (shape.Type)
+		{
+			case ShapeType2D::Box:
+				extent.x = glm::abs(transform.Cosine) * shape.HalfExtents.x + glm::abs(transform.Sine) * shape.HalfExtents.y;
+				extent.y = glm::abs(transform.Sine) * shape.HalfExtents.x + glm::abs(transform.Cosine) * shape.HalfExtents.y;
+				break;
+			case ShapeType2D::Circle:
+				extent = glm::vec2(shape.Radius);
+				break;
+		}
+		return { transform.Position - extent, transform.Position + extent };
+	}
+
+}
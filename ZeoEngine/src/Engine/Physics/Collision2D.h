@@ -0,0 +1,81 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "Engine/Renderer/Culling2D.h"
+
+namespace ZeoEngine {
+
+	enum class ShapeType2D : uint8_t
+	{
+		Box = 0, Circle
+	};
+
+	/** A box or a circle centered at the origin of its body. */
+	struct Shape2D
+	{
+		ShapeType2D Type = ShapeType2D::Box;
+		/** Used by boxes */
+		glm::vec2 HalfExtents{ 0.5f };
+		/** Used by circles */
+		float Radius = 0.5f;
+	};
+
+	/** Position and rotation of a body, with the rotation kept as cosine and sine. */
+	struct Transform2D
+	{
+		glm::vec2 Position{ 0.0f };
+		float Cosine = 1.0f;
+		float Sine = 0.0f;
+
+		Transform2D() = default;
+		Transform2D(const glm::vec2& position, float rotation)
+			: Position(position), Cosine(glm::cos(rotation)), Sine(glm::sin(rotation))
+		{
+		}
+
+		glm::vec2 GetAxisX() const { return { Cosine, Sine }; }
+		glm::vec2 GetAxisY() const { return { -Sine, Cosine }; }
+
+		glm::vec2 Rotate(const glm::vec2& vector) const { return { Cosine * vector.x - Sine * vector.y, Sine * vector.x + Cosine * vector.y }; }
+		glm::vec2 InverseRotate(const glm::vec2& vector) const { return { Cosine * vector.x + Sine * vector.y, -Sine * vector.x + Cosine * vector.y }; }
+		/** Local to world */
+		glm::vec2 Apply(const glm::vec2& point) const { return Position + Rotate(point); }
+		/** World to local */
+		glm::vec2 ApplyInverse(const glm::vec2& point) const { return InverseRotate(point - Position); }
+	};
+
+	struct ContactPoint2D
+	{
+		/** World position halfway between the two surfaces */
+		glm::vec2 Position{ 0.0f };
+		/** Negative when the shapes overlap */
+		float Separation = 0.0f;
+		/** Identifies the features which generated the point, so that the solver can carry impulses over to the next step */
+		uint32_t Id = 0;
+	};
+
+	struct ContactManifold2D
+	{
+		/** Points from shape A to shape B */
+		glm::vec2 Normal{ 0.0f };
+		ContactPoint2D Points[2];
+		uint32_t PointCount = 0;
+	};
+
+	/** Narrowphase collision of boxes and circles, boxes are tested with the separating axis theorem. */
+	class Collision2D
+	{
+	public:
+		/**
+		 * Returns true and fills in the manifold if the shapes touch.
+		 * Points separated by up to margin are reported as well, so that resting contacts do not come and go between steps.
+		 */
+		static bool Collide(const Shape2D& shapeA, const Transform2D& transformA, const Shape2D& shapeB, const Transform2D& transformB, float margin,
+			ContactManifold2D& outManifold);
+
+		/** World-space bounds of the shape. */
+		static Bounds2D ComputeBounds(const Shape2D& shape, const Transform2D& transform);
+	};
+
+}
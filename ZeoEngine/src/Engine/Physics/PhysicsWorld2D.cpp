@@ -0,0 +1,625 @@
+#include "ZEpch.h"
+#include "Engine/Physics/PhysicsWorld2D.h"
+
+#include <glm/gtc/constants.hpp>
+
+#include "Engine/Core/JobSystem.h"
+
+namespace ZeoEngine {
+
+	/** Shapes closer than this are already treated as touching so that resting contacts persist between steps */
+	static const float s_ContactMargin = 0.01f;
+	/** Overlap left in place to keep resting contacts stable */
+	static const float s_LinearSlop = 0.005f;
+	/** Fraction of the overlap removed per step */
+	static const float s_BaumgarteFactor = 0.2f;
+	/** Slower impacts do not bounce */
+	static const float s_RestitutionThreshold = 1.0f;
+	static const float s_LinearSleepTolerance = 0.05f;
+	static const float s_AngularSleepTolerance = glm::radians(2.0f);
+	static const float s_TimeToSleep = 0.5f;
+	static const uint32_t s_NoSolverBody = ~0u;
+
+	static float Cross(const glm::vec2& a, const glm::vec2& b)
+	{
+		return a.x * b.y - a.y * b.x;
+	}
+
+	static glm::vec2 Cross(float w, const glm::vec2& r)
+	{
+		return { -w * r.y, w * r.x };
+	}
+
+	PhysicsWorld2D::PhysicsWorld2D(const glm::vec2& gravity)
+		: m_Gravity(gravity)
+	{
+	}
+
+	BodyId2D PhysicsWorld2D::CreateBody(const BodyDef2D& def)
+	{
+		ZE_PROFILE_FUNCTION();
+
+		BodyId2D bodyId;
+		if (!m_FreeBodies.empty())
+		{
+			bodyId = m_FreeBodies.back();
+			m_FreeBodies.pop_back();
+		}
+		else
+		{
+			bodyId = static_cast<BodyId2D>(m_Bodies.size());
+			m_Bodies.emplace_back();
+			m_MovedStamps.push_back(0);
+		}
+
+		Body& body = m_Bodies[bodyId];
+		body = Body();
+		body.Transform = Transform2D(def.Position, def.Rotation);
+		body.Rotation = def.Rotation;
+		body.Friction = def.Friction;
+		body.Restitution = def.Restitution;
+		body.Shape = def.Shape;
+		body.UserData = def.UserData;
+		body.Type = def.Type;
+		body.bAlive = true;
+		if (def.Type == BodyType2D::Dynamic)
+		{
+			float mass = 0.0f, inertia = 0.0f;
+			switch (def.Shape.Type)
+			{
+				case ShapeType2D::Box:
+				{
+					const glm::vec2& halfExtents = def.Shape.HalfExtents;
+					mass = def.Density * 4.0f * halfExtents.x * halfExtents.y;
+					inertia = mass * (halfExtents.x * halfExtents.x + halfExtents.y * halfExtents.y) / 3.0f;
+					break;
+				}
+				case ShapeType2D::Circle:
+					mass = def.Density * glm::pi<float>() * def.Shape.Radius * def.Shape.Radius;
+					inertia = 0.5f * mass * def.Shape.Radius * def.Shape.Radius;
+					break;
+			}
+			ZE_CORE_ASSERT(mass > 0.0f, "Dynamic bodies must have a positive mass!");
+
+			body.InverseMass = 1.0f / mass;
+			body.InverseInertia = def.bFixedRotation ? 0.0f : 1.0f / inertia;
+			body.LinearVelocity = def.LinearVelocity;
+			body.AngularVelocity = def.bFixedRotation ? 0.0f : def.AngularVelocity;
+			body.bAwake = true;
+		}
+
+		m_Broadphase.Insert(bodyId, ComputeFatBounds(body), body.bAwake);
+		return bodyId;
+	}
+
+	void PhysicsWorld2D::DestroyBody(BodyId2D bodyId)
+	{
+		ZE_PROFILE_FUNCTION();
+
+		Body& body = GetBody(bodyId);
+		// Whatever rested on the body would otherwise keep floating in its sleep
+		for (Contact& contact : m_Contacts)
+		{
+			if (contact.BodyA != bodyId && contact.BodyB != bodyId)
+				continue;
+
+			const BodyId2D otherId = contact.BodyA == bodyId ? contact.BodyB : contact.BodyA;
+			Body& other = m_Bodies[otherId];
+			if (other.bAlive && other.Type == BodyType2D::Dynamic)
+			{
+				SetBodyAwake(otherId, other, true);
+			}
+			// Contacts without points are dropped by the next step
+			contact.Manifold.PointCount = 0;
+		}
+
+		m_Broadphase.Remove(bodyId);
+		body.bAlive = false;
+		body.bAwake = false;
+		m_FreeBodies.push_back(bodyId);
+	}
+
+	void PhysicsWorld2D::Clear()
+	{
+		m_Accumulator = 0.0f;
+		m_Bodies.clear();
+		m_FreeBodies.clear();
+		m_Broadphase = Broadphase2D();
+		m_Contacts.clear();
+		m_PreviousContacts.clear();
+		m_ContactIndices.clear();
+		m_PreviousContactIndices.clear();
+		m_Islands.clear();
+		m_IslandBodies.clear();
+		m_IslandContacts.clear();
+		m_MovedBodies.clear();
+		m_MovedStamps.clear();
+		m_Stats = Statistics();
+	}
+
+	void PhysicsWorld2D::SetTransform(BodyId2D bodyId, const glm::vec2& position, float rotation)
+	{
+		Body& body = GetBody(bodyId);
+		body.Transform = Transform2D(position, rotation);
+		body.Rotation = rotation;
+		m_Broadphase.Update(bodyId, ComputeFatBounds(body));
+		if (body.Type == BodyType2D::Dynamic)
+		{
+			SetBodyAwake(bodyId, body, true);
+			body.SleepTime = 0.0f;
+		}
+	}
+
+	void PhysicsWorld2D::SetLinearVelocity(BodyId2D bodyId, const glm::vec2& velocity)
+	{
+		Body& body = GetBody(bodyId);
+		if (body.Type == BodyType2D::Static)
+			return;
+
+		if (glm::dot(velocity, velocity) > 0.0f)
+		{
+			SetBodyAwake(bodyId, body, true);
+		}
+		body.LinearVelocity = velocity;
+	}
+
+	void PhysicsWorld2D::SetAngularVelocity(BodyId2D bodyId, float velocity)
+	{
+		Body& body = GetBody(bodyId);
+		if (body.Type == BodyType2D::Static || body.InverseInertia == 0.0f)
+			return;
+
+		if (velocity != 0.0f)
+		{
+			SetBodyAwake(bodyId, body, true);
+		}
+		body.AngularVelocity = velocity;
+	}
+
+	void PhysicsWorld2D::ApplyLinearImpulse(BodyId2D bodyId, const glm::vec2& impulse, const glm::vec2& point)
+	{
+		Body& body = GetBody(bodyId);
+		if (body.Type == BodyType2D::Static)
+			return;
+
+		SetBodyAwake(bodyId, body, true);
+		body.LinearVelocity += body.InverseMass * impulse;
+		body.AngularVelocity += body.InverseInertia * Cross(point - body.Transform.Position, impulse);
+	}
+
+	void PhysicsWorld2D::SetAwake(BodyId2D bodyId, bool bAwake)
+	{
+		Body& body = GetBody(bodyId);
+		if (body.Type == BodyType2D::Static)
+			return;
+
+		SetBodyAwake(bodyId, body, bAwake);
+	}
+
+	void PhysicsWorld2D::SetBodyAwake(BodyId2D bodyId, Body& body, bool bAwake)
+	{
+		if (body.bAwake == bAwake)
+			return;
+
+		body.bAwake = bAwake;
+		body.SleepTime = 0.0f;
+		if (!bAwake)
+		{
+			body.LinearVelocity = glm::vec2(0.0f);
+			body.AngularVelocity = 0.0f;
+		}
+		m_Broadphase.SetActive(bodyId, bAwake);
+	}
+
+	Bounds2D PhysicsWorld2D::ComputeFatBounds(const Body& body) const
+	{
+		Bounds2D bounds = Collision2D::ComputeBounds(body.Shape, body.Transform);
+		bounds.Min -= s_ContactMargin;
+		bounds.Max += s_ContactMargin;
+		return bounds;
+	}
+
+	void PhysicsWorld2D::Step(float dt)
+	{
+		ZE_PROFILE_FUNCTION();
+
+		++m_UpdateIndex;
+		m_MovedBodies.clear();
+
+		m_Accumulator += dt;
+		uint32_t stepCount = 0;
+		while (m_Accumulator >= FixedTimeStep && stepCount < MaxStepsPerUpdate)
+		{
+			FixedStep();
+			m_Accumulator -= FixedTimeStep;
+			++stepCount;
+		}
+		if (stepCount == MaxStepsPerUpdate)
+		{
+			m_Accumulator = std::fmod(m_Accumulator, FixedTimeStep);
+		}
+
+		m_Stats.BodyCount = static_cast<uint32_t>(m_Bodies.size() - m_FreeBodies.size());
+		m_Stats.StepCount = stepCount;
+	}
+
+	void PhysicsWorld2D::FixedStep()
+	{
+		ZE_PROFILE_FUNCTION();
+
+		++m_StepIndex;
+		UpdateContacts();
+		BuildIslands();
+
+		const uint32_t islandCount = static_cast<uint32_t>(m_Islands.size());
+		JobSystem::ParallelFor(islandCount, 1, [this](uint32_t begin, uint32_t end)
+		{
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				SolveIsland(m_Islands[i]);
+			}
+		});
+
+		for (BodyId2D bodyId : m_IslandBodies)
+		{
+			if (m_MovedStamps[bodyId] != m_UpdateIndex)
+			{
+				m_MovedStamps[bodyId] = m_UpdateIndex;
+				m_MovedBodies.push_back(bodyId);
+			}
+		}
+
+		m_Stats.AwakeBodyCount = static_cast<uint32_t>(m_IslandBodies.size());
+		m_Stats.ContactCount = static_cast<uint32_t>(m_Contacts.size());
+		m_Stats.IslandCount = islandCount;
+	}
+
+	void PhysicsWorld2D::UpdateContacts()
+	{
+		ZE_PROFILE_FUNCTION();
+
+		std::swap(m_Contacts, m_PreviousContacts);
+		std::swap(m_ContactIndices, m_PreviousContactIndices);
+		m_Contacts.clear();
+		m_ContactIndices.clear();
+
+		m_Stats.PairCount = 0;
+		m_Broadphase.FindPairs([this](uint32_t idA, uint32_t idB)
+		{
+			++m_Stats.PairCount;
+
+			// Keep the order stable so that the pair is found under the same key in the next step
+			const BodyId2D bodyIdA = std::min(idA, idB);
+			const BodyId2D bodyIdB = std::max(idA, idB);
+			const Body& bodyA = m_Bodies[bodyIdA];
+			const Body& bodyB = m_Bodies[bodyIdB];
+			Contact contact;
+			if (!Collision2D::Collide(bodyA.Shape, bodyA.Transform, bodyB.Shape, bodyB.Transform, s_ContactMargin, contact.Manifold))
+				return;
+
+			contact.BodyA = bodyIdA;
+			contact.BodyB = bodyIdB;
+			contact.Friction = glm::sqrt(bodyA.Friction * bodyB.Friction);
+			contact.Restitution = std::max(bodyA.Restitution, bodyB.Restitution);
+
+			const uint64_t key = MakePairKey(bodyIdA, bodyIdB);
+			auto it = m_PreviousContactIndices.find(key);
+			if (it != m_PreviousContactIndices.end())
+			{
+				// Warm start from the impulses of points generated by the same features
+				Contact& previousContact = m_PreviousContacts[it->second];
+				previousContact.bPersisted = true;
+				for (uint32_t i = 0; i < contact.Manifold.PointCount; ++i)
+				{
+					for (uint32_t j = 0; j < previousContact.Manifold.PointCount; ++j)
+					{
+						if (contact.Manifold.Points[i].Id == previousContact.Manifold.Points[j].Id)
+						{
+							contact.NormalImpulses[i] = previousContact.NormalImpulses[j];
+							contact.TangentImpulses[i] = previousContact.TangentImpulses[j];
+							break;
+						}
+					}
+				}
+			}
+
+			m_ContactIndices.emplace(key, static_cast<uint32_t>(m_Contacts.size()));
+			m_Contacts.push_back(contact);
+		});
+
+		// Pairs of sleeping or static bodies were not tested, keep their contacts for when the island wakes up.
+		// Contacts which ended wake their bodies so that nothing is left resting on a body which has moved away
+		std::vector<BodyId2D>& bodiesToWake = m_IslandStack;
+		bodiesToWake.clear();
+		for (Contact& previousContact : m_PreviousContacts)
+		{
+			if (previousContact.Manifold.PointCount == 0)
+				continue;
+
+			const Body& bodyA = m_Bodies[previousContact.BodyA];
+			const Body& bodyB = m_Bodies[previousContact.BodyB];
+			if (!bodyA.bAwake && !bodyB.bAwake)
+			{
+				previousContact.bPersisted = false;
+				previousContact.bInIsland = false;
+				m_ContactIndices.emplace(MakePairKey(previousContact.BodyA, previousContact.BodyB), static_cast<uint32_t>(m_Contacts.size()));
+				m_Contacts.push_back(previousContact);
+			}
+			else if (!previousContact.bPersisted)
+			{
+				bodiesToWake.push_back(previousContact.BodyA);
+				bodiesToWake.push_back(previousContact.BodyB);
+			}
+		}
+		for (BodyId2D bodyId : bodiesToWake)
+		{
+			Body& body = m_Bodies[bodyId];
+			if (body.Type == BodyType2D::Dynamic)
+			{
+				SetBodyAwake(bodyId, body, true);
+			}
+		}
+	}
+
+	void PhysicsWorld2D::BuildIslands()
+	{
+		ZE_PROFILE_FUNCTION();
+
+		const uint32_t bodyCapacity = static_cast<uint32_t>(m_Bodies.size());
+		const uint32_t contactCount = static_cast<uint32_t>(m_Contacts.size());
+
+		// Count contacts per body and turn the counts into end offsets, filling them backwards then leaves each entry at the start of its body
+		m_BodyContactOffsets.assign(bodyCapacity + 1, 0);
+		for (const Contact& contact : m_Contacts)
+		{
+			++m_BodyContactOffsets[contact.BodyA];
+			++m_BodyContactOffsets[contact.BodyB];
+		}
+		for (uint32_t i = 1; i < bodyCapacity; ++i)
+		{
+			m_BodyContactOffsets[i] += m_BodyContactOffsets[i - 1];
+		}
+		m_BodyContactOffsets[bodyCapacity] = 2 * contactCount;
+		m_BodyContacts.resize(2 * contactCount);
+		for (uint32_t i = 0; i < contactCount; ++i)
+		{
+			m_BodyContacts[--m_BodyContactOffsets[m_Contacts[i].BodyA]] = i;
+			m_BodyContacts[--m_BodyContactOffsets[m_Contacts[i].BodyB]] = i;
+		}
+
+		m_Islands.clear();
+		m_IslandBodies.clear();
+		m_IslandContacts.clear();
+		for (BodyId2D seedId = 0; seedId < bodyCapacity; ++seedId)
+		{
+			Body& seed = m_Bodies[seedId];
+			if (!seed.bAwake || seed.Type == BodyType2D::Static || seed.IslandStamp == m_StepIndex)
+				continue;
+
+			Island island;
+			island.BodyOffset = static_cast<uint32_t>(m_IslandBodies.size());
+			island.ContactOffset = static_cast<uint32_t>(m_IslandContacts.size());
+
+			seed.IslandStamp = m_StepIndex;
+			m_IslandStack.clear();
+			m_IslandStack.push_back(seedId);
+			while (!m_IslandStack.empty())
+			{
+				const BodyId2D bodyId = m_IslandStack.back();
+				m_IslandStack.pop_back();
+
+				Body& body = m_Bodies[bodyId];
+				body.IslandIndex = static_cast<uint32_t>(m_IslandBodies.size());
+				m_IslandBodies.push_back(bodyId);
+				// Sleeping bodies touched by the island wake up with it
+				SetBodyAwake(bodyId, body, true);
+
+				for (uint32_t i = m_BodyContactOffsets[bodyId]; i < m_BodyContactOffsets[bodyId + 1]; ++i)
+				{
+					const uint32_t contactIndex = m_BodyContacts[i];
+					Contact& contact = m_Contacts[contactIndex];
+					if (contact.bInIsland || contact.Manifold.PointCount == 0)
+						continue;
+
+					contact.bInIsland = true;
+					m_IslandContacts.push_back(contactIndex);
+
+					// Static bodies do not join islands together
+					const BodyId2D otherId = contact.BodyA == bodyId ? contact.BodyB : contact.BodyA;
+					Body& other = m_Bodies[otherId];
+					if (other.Type == BodyType2D::Static || other.IslandStamp == m_StepIndex)
+						continue;
+
+					other.IslandStamp = m_StepIndex;
+					m_IslandStack.push_back(otherId);
+				}
+			}
+
+			island.BodyCount = static_cast<uint32_t>(m_IslandBodies.size()) - island.BodyOffset;
+			island.ContactCount = static_cast<uint32_t>(m_IslandContacts.size()) - island.ContactOffset;
+			m_Islands.push_back(island);
+		}
+
+		m_SolverLinearVelocities.resize(m_IslandBodies.size());
+		m_SolverAngularVelocities.resize(m_IslandBodies.size());
+		m_Constraints.resize(m_IslandContacts.size());
+	}
+
+	void PhysicsWorld2D::SolveIsland(const Island& island)
+	{
+		const float h = FixedTimeStep;
+		const float invH = 1.0f / h;
+		const uint32_t bodyEnd = island.BodyOffset + island.BodyCount;
+		const uint32_t contactEnd = island.ContactOffset + island.ContactCount;
+
+		for (uint32_t i = island.BodyOffset; i < bodyEnd; ++i)
+		{
+			const Body& body = m_Bodies[m_IslandBodies[i]];
+			m_SolverLinearVelocities[i] = body.LinearVelocity + h * m_Gravity;
+			m_SolverAngularVelocities[i] = body.AngularVelocity;
+		}
+
+		auto loadVelocity = [this](uint32_t index, glm::vec2& outLinear, float& outAngular)
+		{
+			outLinear = index != s_NoSolverBody ? m_SolverLinearVelocities[index] : glm::vec2(0.0f);
+			outAngular = index != s_NoSolverBody ? m_SolverAngularVelocities[index] : 0.0f;
+		};
+		auto storeVelocity = [this](uint32_t index, const glm::vec2& linear, float angular)
+		{
+			if (index != s_NoSolverBody)
+			{
+				m_SolverLinearVelocities[index] = linear;
+				m_SolverAngularVelocities[index] = angular;
+			}
+		};
+
+		// Prepare constraints and apply the impulses of the previous step
+		for (uint32_t c = island.ContactOffset; c < contactEnd; ++c)
+		{
+			const Contact& contact = m_Contacts[m_IslandContacts[c]];
+			ContactConstraint& constraint = m_Constraints[c];
+			const Body& bodyA = m_Bodies[contact.BodyA];
+			const Body& bodyB = m_Bodies[contact.BodyB];
+			constraint.IndexA = bodyA.Type == BodyType2D::Dynamic ? bodyA.IslandIndex : s_NoSolverBody;
+			constraint.IndexB = bodyB.Type == BodyType2D::Dynamic ? bodyB.IslandIndex : s_NoSolverBody;
+			constraint.InverseMassA = bodyA.InverseMass;
+			constraint.InverseMassB = bodyB.InverseMass;
+			constraint.InverseInertiaA = bodyA.InverseInertia;
+			constraint.InverseInertiaB = bodyB.InverseInertia;
+			constraint.Friction = contact.Friction;
+			constraint.Normal = contact.Manifold.Normal;
+			constraint.PointCount = contact.Manifold.PointCount;
+
+			const glm::vec2 normal = constraint.Normal;
+			const glm::vec2 tangent{ normal.y, -normal.x };
+			const float mA = constraint.InverseMassA, mB = constraint.InverseMassB;
+			const float iA = constraint.InverseInertiaA, iB = constraint.InverseInertiaB;
+			glm::vec2 vA, vB;
+			float wA, wB;
+			loadVelocity(constraint.IndexA, vA, wA);
+			loadVelocity(constraint.IndexB, vB, wB);
+
+			for (uint32_t p = 0; p < constraint.PointCount; ++p)
+			{
+				const ContactPoint2D& contactPoint = contact.Manifold.Points[p];
+				ContactConstraint::Point& point = constraint.Points[p];
+				point.AnchorA = contactPoint.Position - bodyA.Transform.Position;
+				point.AnchorB = contactPoint.Position - bodyB.Transform.Position;
+
+				const float rnA = Cross(point.AnchorA, normal);
+				const float rnB = Cross(point.AnchorB, normal);
+				const float normalMass = mA + mB + iA * rnA * rnA + iB * rnB * rnB;
+				point.NormalMass = normalMass > 0.0f ? 1.0f / normalMass : 0.0f;
+
+				const float rtA = Cross(point.AnchorA, tangent);
+				const float rtB = Cross(point.AnchorB, tangent);
+				const float tangentMass = mA + mB + iA * rtA * rtA + iB * rtB * rtB;
+				point.TangentMass = tangentMass > 0.0f ? 1.0f / tangentMass : 0.0f;
+
+				// Push overlapping shapes apart over a few steps, speculative points which are still apart get no bias
+				point.VelocityBias = -s_BaumgarteFactor * invH * std::min(0.0f, contactPoint.Separation + s_LinearSlop);
+				const float normalVelocity = glm::dot(vB + Cross(wB, point.AnchorB) - vA - Cross(wA, point.AnchorA), normal);
+				if (normalVelocity < -s_RestitutionThreshold)
+				{
+					point.VelocityBias = std::max(point.VelocityBias, -contact.Restitution * normalVelocity);
+				}
+
+				const glm::vec2 impulse = contact.NormalImpulses[p] * normal + contact.TangentImpulses[p] * tangent;
+				vA -= mA * impulse;
+				wA -= iA * Cross(point.AnchorA, impulse);
+				vB += mB * impulse;
+				wB += iB * Cross(point.AnchorB, impulse);
+			}
+
+			storeVelocity(constraint.IndexA, vA, wA);
+			storeVelocity(constraint.IndexB, vB, wB);
+		}
+
+		for (uint32_t iteration = 0; iteration < VelocityIterations; ++iteration)
+		{
+			for (uint32_t c = island.ContactOffset; c < contactEnd; ++c)
+			{
+				Contact& contact = m_Contacts[m_IslandContacts[c]];
+				const ContactConstraint& constraint = m_Constraints[c];
+				const glm::vec2 normal = constraint.Normal;
+				const glm::vec2 tangent{ normal.y, -normal.x };
+				const float mA = constraint.InverseMassA, mB = constraint.InverseMassB;
+				const float iA = constraint.InverseInertiaA, iB = constraint.InverseInertiaB;
+				glm::vec2 vA, vB;
+				float wA, wB;
+				loadVelocity(constraint.IndexA, vA, wA);
+				loadVelocity(constraint.IndexB, vB, wB);
+
+				for (uint32_t p = 0; p < constraint.PointCount; ++p)
+				{
+					const ContactConstraint::Point& point = constraint.Points[p];
+
+					// Friction first, non-penetration matters more so it gets the last word
+					{
+						const glm::vec2 dv = vB + Cross(wB, point.AnchorB) - vA - Cross(wA, point.AnchorA);
+						const float maxFriction = constraint.Friction * contact.NormalImpulses[p];
+						const float newImpulse = glm::clamp(contact.TangentImpulses[p] - point.TangentMass * glm::dot(dv, tangent), -maxFriction, maxFriction);
+						const glm::vec2 impulse = (newImpulse - contact.TangentImpulses[p]) * tangent;
+						contact.TangentImpulses[p] = newImpulse;
+
+						vA -= mA * impulse;
+						wA -= iA * Cross(point.AnchorA, impulse);
+						vB += mB * impulse;
+						wB += iB * Cross(point.AnchorB, impulse);
+					}
+
+					{
+						const glm::vec2 dv = vB + Cross(wB, point.AnchorB) - vA - Cross(wA, point.AnchorA);
+						const float newImpulse = std::max(contact.NormalImpulses[p] - point.NormalMass * (glm::dot(dv, normal) - point.VelocityBias), 0.0f);
+						const glm::vec2 impulse = (newImpulse - contact.NormalImpulses[p]) * normal;
+						contact.NormalImpulses[p] = newImpulse;
+
+						vA -= mA * impulse;
+						wA -= iA * Cross(point.AnchorA, impulse);
+						vB += mB * impulse;
+						wB += iB * Cross(point.AnchorB, impulse);
+					}
+				}
+
+				storeVelocity(constraint.IndexA, vA, wA);
+				storeVelocity(constraint.IndexB, vB, wB);
+			}
+		}
+
+		// Integrate positions and find out whether the whole island has been still for long enough
+		float minSleepTime = std::numeric_limits<float>::max();
+		for (uint32_t i = island.BodyOffset; i < bodyEnd; ++i)
+		{
+			const BodyId2D bodyId = m_IslandBodies[i];
+			Body& body = m_Bodies[bodyId];
+			const glm::vec2 linearVelocity = m_SolverLinearVelocities[i];
+			const float angularVelocity = m_SolverAngularVelocities[i];
+			body.LinearVelocity = linearVelocity;
+			body.AngularVelocity = angularVelocity;
+			body.Rotation += h * angularVelocity;
+			body.Transform = Transform2D(body.Transform.Position + h * linearVelocity, body.Rotation);
+			m_Broadphase.Update(bodyId, ComputeFatBounds(body));
+
+			if (glm::dot(linearVelocity, linearVelocity) > s_LinearSleepTolerance * s_LinearSleepTolerance ||
+				angularVelocity * angularVelocity > s_AngularSleepTolerance * s_AngularSleepTolerance)
+			{
+				body.SleepTime = 0.0f;
+			}
+			else
+			{
+				body.SleepTime += h;
+			}
+			minSleepTime = std::min(minSleepTime, body.SleepTime);
+		}
+
+		if (minSleepTime >= s_TimeToSleep)
+		{
+			for (uint32_t i = island.BodyOffset; i < bodyEnd; ++i)
+			{
+				const BodyId2D bodyId = m_IslandBodies[i];
+				SetBodyAwake(bodyId, m_Bodies[bodyId], false);
+			}
+		}
+	}
+
+}
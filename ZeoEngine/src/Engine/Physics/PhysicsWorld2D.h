@@ -0,0 +1,258 @@
+#pragma once
+
+#include <limits>
+#include <unordered_map>
+
+#include "Engine/Physics/Collision2D.h"
+#include "Engine/Physics/Broadphase2D.h"
+
+namespace ZeoEngine {
+
+	enum class BodyType2D : uint8_t
+	{
+		/** Never moves and has infinite mass */
+		Static = 0,
+		/** Moved by gravity, contacts and impulses */
+		Dynamic
+	};
+
+	struct BodyDef2D
+	{
+		BodyType2D Type = BodyType2D::Static;
+		Shape2D Shape;
+		/** Center of the shape, which is also the center of mass */
+		glm::vec2 Position{ 0.0f };
+		/** In radians */
+		float Rotation = 0.0f;
+		glm::vec2 LinearVelocity{ 0.0f };
+		float AngularVelocity = 0.0f;
+		float Density = 1.0f;
+		float Friction = 0.5f;
+		float Restitution = 0.0f;
+		bool bFixedRotation = false;
+		/** Handed back by ForEachMovedBody(), e.g. the entity owning the body */
+		uint32_t UserData = 0;
+	};
+
+	using BodyId2D = uint32_t;
+
+	static constexpr BodyId2D NullBodyId2D = std::numeric_limits<BodyId2D>::max();
+
+	/**
+	 * Rigid body simulation of boxes and circles advanced in fixed steps.
+	 *
+	 * Pairs come from a sweep and prune broadphase, contacts from SAT based narrowphase, and velocities are solved with sequential impulses
+	 * warm started from the previous step. Bodies connected by contacts form islands which are solved in parallel on the job system.
+	 * An island whose bodies have all been nearly still for a while goes to sleep: its bodies are no longer integrated, tested or reported as moved,
+	 * and its contacts are kept as they are until something touches the island again.
+	 */
+	class PhysicsWorld2D
+	{
+	public:
+		static constexpr float FixedTimeStep = 1.0f / 60.0f;
+		/** Time beyond this many steps per Step() is dropped, so that a slow frame does not make the next one even slower */
+		static constexpr uint32_t MaxStepsPerUpdate = 4;
+		static constexpr uint32_t VelocityIterations = 8;
+
+		explicit PhysicsWorld2D(const glm::vec2& gravity = { 0.0f, -9.8f });
+
+		BodyId2D CreateBody(const BodyDef2D& def);
+		/** Bodies touching the destroyed one are woken up. */
+		void DestroyBody(BodyId2D body);
+		/** Destroy all bodies for which predicate(BodyId2D, uint32_t userData) returns true. */
+		template<typename Predicate>
+		void DestroyBodiesIf(Predicate&& predicate)
+		{
+			const uint32_t bodyCount = static_cast<uint32_t>(m_Bodies.size());
+			for (uint32_t body = 0; body < bodyCount; ++body)
+			{
+				if (m_Bodies[body].bAlive && predicate(body, m_Bodies[body].UserData))
+				{
+					DestroyBody(body);
+				}
+			}
+		}
+		void Clear();
+
+		const glm::vec2& GetPosition(BodyId2D body) const { return GetBody(body).Transform.Position; }
+		float GetRotation(BodyId2D body) const { return GetBody(body).Rotation; }
+		/** Move the body without going through the simulation and wake it up. */
+		void SetTransform(BodyId2D body, const glm::vec2& position, float rotation);
+
+		const glm::vec2& GetLinearVelocity(BodyId2D body) const { return GetBody(body).LinearVelocity; }
+		void SetLinearVelocity(BodyId2D body, const glm::vec2& velocity);
+		float GetAngularVelocity(BodyId2D body) const { return GetBody(body).AngularVelocity; }
+		void SetAngularVelocity(BodyId2D body, float velocity);
+		/** Apply an impulse at a world point and wake the body up. */
+		void ApplyLinearImpulse(BodyId2D body, const glm::vec2& impulse, const glm::vec2& point);
+
+		bool IsAwake(BodyId2D body) const { return GetBody(body).bAwake; }
+		/** Putting a body to sleep only lasts until something touches it. */
+		void SetAwake(BodyId2D body, bool bAwake);
+		BodyType2D GetType(BodyId2D body) const { return GetBody(body).Type; }
+		uint32_t GetUserData(BodyId2D body) const { return GetBody(body).UserData; }
+
+		const glm::vec2& GetGravity() const { return m_Gravity; }
+		void SetGravity(const glm::vec2& gravity) { m_Gravity = gravity; }
+
+		/** Advance the simulation by as many fixed steps as fit into the time passed so far. */
+		void Step(float dt);
+
+		/** Calls func(BodyId2D, uint32_t userData, const glm::vec2& position, float rotation) for every body simulated during the last Step(). */
+		template<typename Func>
+		void ForEachMovedBody(Func&& func) const
+		{
+			for (BodyId2D body : m_MovedBodies)
+			{
+				const Body& movedBody = m_Bodies[body];
+				if (!movedBody.bAlive)
+					continue;
+
+				func(body, movedBody.UserData, movedBody.Transform.Position, movedBody.Rotation);
+			}
+		}
+
+		struct Statistics
+		{
+			uint32_t BodyCount = 0;
+			/** Bodies simulated during the last fixed step */
+			uint32_t AwakeBodyCount = 0;
+			/** Overlapping bounds reported by the broadphase */
+			uint32_t PairCount = 0;
+			/** Touching pairs, including those of sleeping islands */
+			uint32_t ContactCount = 0;
+			uint32_t IslandCount = 0;
+			/** Fixed steps taken by the last Step() */
+			uint32_t StepCount = 0;
+		};
+		const Statistics& GetStats() const { return m_Stats; }
+
+	private:
+		struct Body
+		{
+			Transform2D Transform;
+			float Rotation = 0.0f;
+			glm::vec2 LinearVelocity{ 0.0f };
+			float AngularVelocity = 0.0f;
+			float InverseMass = 0.0f;
+			float InverseInertia = 0.0f;
+			float Friction = 0.5f;
+			float Restitution = 0.0f;
+			Shape2D Shape;
+			uint32_t UserData = 0;
+			/** Time the body has been nearly still */
+			float SleepTime = 0.0f;
+			/** Step in which the body was last added to an island */
+			uint32_t IslandStamp = 0;
+			/** Position in the islands of current step */
+			uint32_t IslandIndex = 0;
+			BodyType2D Type = BodyType2D::Static;
+			bool bAwake = false;
+			bool bAlive = false;
+		};
+
+		struct Contact
+		{
+			BodyId2D BodyA, BodyB;
+			ContactManifold2D Manifold;
+			/** Accumulated impulses, carried over to the next step for points with the same id */
+			float NormalImpulses[2] = {};
+			float TangentImpulses[2] = {};
+			float Friction;
+			float Restitution;
+			/** Set on contacts of the previous step which have been found again */
+			bool bPersisted = false;
+			bool bInIsland = false;
+		};
+
+		/** Bodies and contacts of an island are consecutive ranges of m_IslandBodies and m_IslandContacts. */
+		struct Island
+		{
+			uint32_t BodyOffset, BodyCount;
+			uint32_t ContactOffset, ContactCount;
+		};
+
+		/** Contact prepared for solving, bodies are referred to by their position in m_IslandBodies */
+		struct ContactConstraint
+		{
+			struct Point
+			{
+				glm::vec2 AnchorA, AnchorB;
+				float NormalMass, TangentMass;
+				float VelocityBias;
+			};
+
+			Point Points[2];
+			glm::vec2 Normal;
+			uint32_t PointCount;
+			/** NoSolverBody for static bodies */
+			uint32_t IndexA, IndexB;
+			float InverseMassA, InverseMassB;
+			float InverseInertiaA, InverseInertiaB;
+			float Friction;
+		};
+
+		const Body& GetBody(BodyId2D body) const
+		{
+			ZE_CORE_ASSERT(body < m_Bodies.size() && m_Bodies[body].bAlive, "Invalid body!");
+			return m_Bodies[body];
+		}
+		Body& GetBody(BodyId2D body)
+		{
+			ZE_CORE_ASSERT(body < m_Bodies.size() && m_Bodies[body].bAlive, "Invalid body!");
+			return m_Bodies[body];
+		}
+
+		void SetBodyAwake(BodyId2D bodyId, Body& body, bool bAwake);
+		Bounds2D ComputeFatBounds(const Body& body) const;
+
+		void FixedStep();
+		/** Find touching pairs among those involving awake bodies and keep contacts of sleeping islands as they are. */
+		void UpdateContacts();
+		/** Group awake bodies connected by contacts, waking up sleeping bodies they touch. */
+		void BuildIslands();
+		/** Integrate and solve contacts of one island, then put it to sleep if it has been still long enough. Islands are solved concurrently. */
+		void SolveIsland(const Island& island);
+
+		static uint64_t MakePairKey(BodyId2D bodyA, BodyId2D bodyB)
+		{
+			return (static_cast<uint64_t>(bodyA) << 32) | bodyB;
+		}
+
+	private:
+		glm::vec2 m_Gravity;
+		float m_Accumulator = 0.0f;
+		uint32_t m_StepIndex = 0;
+
+		std::vector<Body> m_Bodies;
+		std::vector<BodyId2D> m_FreeBodies;
+		Broadphase2D m_Broadphase;
+
+		std::vector<Contact> m_Contacts;
+		std::vector<Contact> m_PreviousContacts;
+		/** Index in m_Contacts of each pair, keyed by MakePairKey() */
+		std::unordered_map<uint64_t, uint32_t> m_ContactIndices;
+		std::unordered_map<uint64_t, uint32_t> m_PreviousContactIndices;
+
+		/** Contacts of each body laid out by body, see BuildIslands() */
+		std::vector<uint32_t> m_BodyContactOffsets;
+		std::vector<uint32_t> m_BodyContacts;
+
+		std::vector<Island> m_Islands;
+		std::vector<BodyId2D> m_IslandBodies;
+		std::vector<uint32_t> m_IslandContacts;
+		std::vector<BodyId2D> m_IslandStack;
+		/** Solver state indexed like m_IslandBodies and m_IslandContacts, each island only touches its own ranges */
+		std::vector<glm::vec2> m_SolverLinearVelocities;
+		std::vector<float> m_SolverAngularVelocities;
+		std::vector<ContactConstraint> m_Constraints;
+
+		std::vector<BodyId2D> m_MovedBodies;
+		/** Update in which each body was last added to m_MovedBodies */
+		std::vector<uint32_t> m_MovedStamps;
+		uint32_t m_UpdateIndex = 0;
+
+		Statistics m_Stats;
+	};
+
+}
@@ -7,7 +7,22 @@
 
 namespace ZeoEngine {
 
-	Ref<VertexBuffer> VertexBuffer::Create(float* vertices, uint32_t size)
+	Ref<VertexBuffer> VertexBuffer::Create(uint32_t size)
+	{
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::None:
+			ZE_CORE_ASSERT(false, "RendererAPI is currently not supported!");
+			return nullptr;
+		case RendererAPI::API::OpenGL:
+			return CreateRef<OpenGLVertexBuffer>(size);
+		default:
+			ZE_CORE_ASSERT(false, "Unknown RendererAPI!");
+			return nullptr;
+		}
+	}
+
+	Ref<VertexBuffer> VertexBuffer::Create(const void* vertices, uint32_t size)
 	{
 		switch (Renderer::GetAPI())
 		{
@@ -22,6 +37,21 @@ namespace ZeoEngine {
 		}
 	}
 
+	Ref<IndexBuffer> IndexBuffer::Create(uint16_t* indices, uint32_t count)
+	{
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::None:
+			ZE_CORE_ASSERT(false, "RendererAPI is currently not supported!");
+			return nullptr;
+		case RendererAPI::API::OpenGL:
+			return CreateRef<OpenGLIndexBuffer>(indices, count, IndexType::UInt16);
+		default:
+			ZE_CORE_ASSERT(false, "Unknown RendererAPI!");
+			return nullptr;
+		}
+	}
+
 	Ref<IndexBuffer> IndexBuffer::Create(uint32_t* indices, uint32_t count)
 	{
 		switch (Renderer::GetAPI())
@@ -30,7 +60,7 @@ namespace ZeoEngine {
 			ZE_CORE_ASSERT(false, "RendererAPI is currently not supported!");
 			return nullptr;
 		case RendererAPI::API::OpenGL:
-			return CreateRef<OpenGLIndexBuffer>(indices, count);
+			return CreateRef<OpenGLIndexBuffer>(indices, count, IndexType::UInt32);
 		default:
 			ZE_CORE_ASSERT(false, "Unknown RendererAPI!");
 			return nullptr;
@@ -8,10 +8,16 @@ namespace ZeoEngine {
 		Float, Float2, Float3, Float4,
 		Mat3, Mat4,
 		Int, Int2, Int3, Int4,
-		Bool
+		Bool,
+		// Compact vertex attribute formats, usually read as normalized floats by shaders
+		UByte4,
+		Half, Half2, Half4,
+		Short2, UShort2,
+		/** x, y and z in 10 bits each and w in 2 bits, signed */
+		Int10_10_10_2
 	};
 
-	static uint32_t ShaderDataTypeSize(ShaderDataType type)
+	static constexpr uint32_t ShaderDataTypeSize(ShaderDataType type)
 	{
 		switch (type)
 		{
@@ -37,57 +43,147 @@ namespace ZeoEngine {
 			return 4 * 4;
 		case ShaderDataType::Bool:
 			return 1;
+		case ShaderDataType::UByte4:
+			return 1 * 4;
+		case ShaderDataType::Half:
+			return 2;
+		case ShaderDataType::Half2:
+			return 2 * 2;
+		case ShaderDataType::Half4:
+			return 2 * 4;
+		case ShaderDataType::Short2:
+		case ShaderDataType::UShort2:
+			return 2 * 2;
+		case ShaderDataType::Int10_10_10_2:
+			return 4;
 		default:
 			ZE_CORE_ASSERT(false, "Unknown ShaderDataType!");
 			return 0;
 		}
 	}
 
+	static constexpr uint32_t ShaderDataTypeComponentCount(ShaderDataType type)
+	{
+		switch (type)
+		{
+		case ShaderDataType::Float:
+			return 1;
+		case ShaderDataType::Float2:
+			return 2;
+		case ShaderDataType::Float3:
+			return 3;
+		case ShaderDataType::Float4:
+			return 4;
+		case ShaderDataType::Mat3:
+			return 3 * 3;
+		case ShaderDataType::Mat4:
+			return 4 * 4;
+		case ShaderDataType::Int:
+			return 1;
+		case ShaderDataType::Int2:
+			return 2;
+		case ShaderDataType::Int3:
+			return 3;
+		case ShaderDataType::Int4:
+			return 4;
+		case ShaderDataType::Bool:
+			return 1;
+		case ShaderDataType::UByte4:
+			return 4;
+		case ShaderDataType::Half:
+			return 1;
+		case ShaderDataType::Half2:
+			return 2;
+		case ShaderDataType::Half4:
+			return 4;
+		case ShaderDataType::Short2:
+		case ShaderDataType::UShort2:
+			return 2;
+		case ShaderDataType::Int10_10_10_2:
+			return 4;
+		default:
+			ZE_CORE_ASSERT(false, "Unknown ShaderDataType!");
+			return 0;
+		}
+	}
+
+	/** Literal type so that whole layouts can be computed at compile time, names must outlive the layout (usually string literals). */
 	struct BufferElement
 	{
-		std::string Name;
+		const char* Name;
 		ShaderDataType Type;
 		uint32_t Size;
 		size_t Offset;
 		bool bNormalized;
 
-		BufferElement(ShaderDataType type, const std::string& name, bool normalized = false)
+		/** Offset is assigned by BufferLayout in declaration order. */
+		constexpr BufferElement(ShaderDataType type, const char* name, bool normalized = false)
 			: Name(name), Type(type), Size(ShaderDataTypeSize(type)), Offset(0), bNormalized(normalized)
 		{
 		}
 
-		uint32_t GetComponentCount() const
+		constexpr BufferElement(ShaderDataType type, const char* name, size_t offset, bool normalized)
+			: Name(name), Type(type), Size(ShaderDataTypeSize(type)), Offset(offset), bNormalized(normalized)
 		{
-			switch (Type)
-			{
-			case ShaderDataType::Float:
-				return 1;
-			case ShaderDataType::Float2:
-				return 2;
-			case ShaderDataType::Float3:
-				return 3;
-			case ShaderDataType::Float4:
-				return 4;
-			case ShaderDataType::Mat3:
-				return 3 * 3;
-			case ShaderDataType::Mat4:
-				return 4 * 4;
-			case ShaderDataType::Int:
-				return 1;
-			case ShaderDataType::Int2:
-				return 2;
-			case ShaderDataType::Int3:
-				return 3;
-			case ShaderDataType::Int4:
-				return 4;
-			case ShaderDataType::Bool:
-				return 1;
-			default:
-				ZE_CORE_ASSERT(false, "Unknown ShaderDataType!");
-				return 0;
-			}
 		}
 
+		constexpr uint32_t GetComponentCount() const { return ShaderDataTypeComponentCount(Type); }
+
+	};
+
+	/**
+	 * Specialize for a vertex struct to describe its attributes at compile time, declaring each of them with ZE_VERTEX_ELEMENT:
+	 *
+	 * template<>
+	 * struct VertexLayout<MyVertex>
+	 * {
+	 *     static constexpr BufferElement Elements[] = {
+	 *         ZE_VERTEX_ELEMENT(MyVertex, Position, Float3, "a_Position", false),
+	 *     };
+	 * };
+	 */
+	template<typename Vertex>
+	struct VertexLayout;
+
+	template<bool bSizeMatches>
+	constexpr void CheckVertexElementSize()
+	{
+		static_assert(bSizeMatches, "Size of vertex member does not match its ShaderDataType!");
+	}
+
+	/** Element of a VertexLayout whose offset is taken from the vertex struct, its size is checked against the member. */
+	#define ZE_VERTEX_ELEMENT(vertex, member, type, name, bNormalized) \
+		(::ZeoEngine::CheckVertexElementSize<sizeof(vertex::member) == ::ZeoEngine::ShaderDataTypeSize(::ZeoEngine::ShaderDataType::type)>(), \
+		::ZeoEngine::BufferElement(::ZeoEngine::ShaderDataType::type, name, offsetof(vertex, member), bNormalized))
+
+	template<typename Vertex>
+	constexpr bool IsVertexLayoutPacked()
+	{
+		size_t end = 0;
+		for (const BufferElement& element : VertexLayout<Vertex>::Elements)
+		{
+			if (element.Offset != end)
+				return false;
+
+			end = element.Offset + element.Size;
+		}
+		return end == sizeof(Vertex);
+	}
+
+	/**
+	 * Layout of a vertex struct computed entirely at compile time from its VertexLayout specialization.
+	 * Elements are checked to be in order, not to overlap and to cover the struct exactly, so that the stride is sizeof(Vertex).
+	 * Converts to BufferLayout without copying elements.
+	 */
+	template<typename Vertex>
+	class StaticBufferLayout
+	{
+	public:
+		static constexpr const BufferElement* GetElements() { return VertexLayout<Vertex>::Elements; }
+		static constexpr uint32_t GetElementCount() { return static_cast<uint32_t>(std::size(VertexLayout<Vertex>::Elements)); }
+		static constexpr uint32_t GetStride() { return static_cast<uint32_t>(sizeof(Vertex)); }
+
+		static_assert(IsVertexLayoutPacked<Vertex>(), "Vertex layout must list all members in order without gaps!");
 	};
 
 	class BufferLayout
@@ -95,19 +191,29 @@ namespace ZeoEngine {
 	public:
 		BufferLayout() = default;
 		BufferLayout(const std::initializer_list<BufferElement>& elements)
-			: m_Elements(elements)
+			: m_OwnedElements(elements)
 		{
 			CalculateOffsetAndStride();
 		}
+		/** Refers to elements computed at compile time, so no memory is allocated. */
+		template<typename Vertex>
+		BufferLayout(StaticBufferLayout<Vertex>)
+			: m_StaticElements(StaticBufferLayout<Vertex>::GetElements())
+			, m_StaticElementCount(StaticBufferLayout<Vertex>::GetElementCount())
+			, m_Stride(StaticBufferLayout<Vertex>::GetStride())
+		{
+		}
 
-		inline const std::vector<BufferElement>& GetElements() const { return m_Elements; }
+		inline const BufferElement* begin() const { return m_StaticElements ? m_StaticElements : m_OwnedElements.data(); }
+		inline const BufferElement* end() const { return begin() + GetElementCount(); }
+		inline uint32_t GetElementCount() const { return m_StaticElements ? m_StaticElementCount : static_cast<uint32_t>(m_OwnedElements.size()); }
 		inline uint32_t GetStride() const { return m_Stride; }
 
 	private:
 		void CalculateOffsetAndStride()
 		{
 			size_t offset = 0;
-			for (auto& element : m_Elements)
+			for (auto& element : m_OwnedElements)
 			{
 				element.Offset = offset;
 				offset += element.Size;
@@ -116,12 +222,15 @@ namespace ZeoEngine {
 		}
 
 	private:
-		std::vector<BufferElement> m_Elements;
+		/** Used by layouts declared at runtime */
+		std::vector<BufferElement> m_OwnedElements;
+		const BufferElement* m_StaticElements = nullptr;
+		uint32_t m_StaticElementCount = 0;
 		uint32_t m_Stride = 0;
 
 	};
 
-	class VertexBuffer
+	class VertexBuffer : public RefCounted
 	{
 	public:
 		virtual ~VertexBuffer() = default;
@@ -129,16 +238,32 @@ namespace ZeoEngine {
 		virtual void Bind() const = 0;
 		virtual void Unbind() const = 0;
 
+		/** Upload a block of vertex data to the beginning of a dynamic vertex buffer. */
+		virtual void SetData(const void* data, uint32_t size) = 0;
+
 		virtual const BufferLayout& GetLayout() const = 0;
 		virtual void SetLayout(const BufferLayout& layout) = 0;
 
 		// Instead of constructor, passing variables to static create fucntion can prevent from casting to different types on class instantiation
 
-		static Ref<VertexBuffer> Create(float* vertices, uint32_t size);
+		/** Used for constructing a dynamic vertex buffer whose data will be uploaded later via SetData(). */
+		static Ref<VertexBuffer> Create(uint32_t size);
+		/** Used for constructing a static vertex buffer with the given vertices. */
+		static Ref<VertexBuffer> Create(const void* vertices, uint32_t size);
+
+	};
 
+	enum class IndexType : uint8_t
+	{
+		UInt16, UInt32
 	};
 
-	class IndexBuffer
+	static constexpr uint32_t IndexTypeSize(IndexType type)
+	{
+		return type == IndexType::UInt16 ? 2 : 4;
+	}
+
+	class IndexBuffer : public RefCounted
 	{
 	public:
 		virtual ~IndexBuffer() = default;
@@ -147,7 +272,10 @@ namespace ZeoEngine {
 		virtual void Unbind() const = 0;
 
 		virtual uint32_t GetCount() const = 0;
+		virtual IndexType GetIndexType() const = 0;
 
+		/** 16-bit indices halve the size of the buffer but can only address 65536 vertices per draw, see RendererAPI::DrawIndexed() for base vertex. */
+		static Ref<IndexBuffer> Create(uint16_t* indices, uint32_t count);
 		static Ref<IndexBuffer> Create(uint32_t* indices, uint32_t count);
 
 	};
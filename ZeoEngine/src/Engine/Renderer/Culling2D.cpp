@@ -0,0 +1,105 @@
+#include "ZEpch.h"
+#include "Engine/Renderer/Culling2D.h"
+
+#ifdef ZE_SIMD_SSE
+	#include <immintrin.h>
+#endif // ZE_SIMD_SSE
+
+namespace ZeoEngine {
+
+	Bounds2D Culling2D::ComputeViewBounds(const glm::mat4& viewProjection)
+	{
+		const glm::mat4 inverseViewProjection = glm::inverse(viewProjection);
+
+		// Corners of the NDC square, camera may be rotated so the bounds enclose all four of them
+		static const glm::vec4 ndcCorners[4] = {
+			{ -1.0f, -1.0f, 0.0f, 1.0f },
+			{  1.0f, -1.0f, 0.0f, 1.0f },
+			{  1.0f,  1.0f, 0.0f, 1.0f },
+			{ -1.0f,  1.0f, 0.0f, 1.0f },
+		};
+
+		Bounds2D bounds;
+		for (uint32_t i = 0; i < 4; ++i)
+		{
+			const glm::vec4 corner = inverseViewProjection * ndcCorners[i];
+			const glm::vec2 position = glm::vec2(corner) / corner.w;
+			bounds.Min = i == 0 ? position : glm::min(bounds.Min, position);
+			bounds.Max = i == 0 ? position : glm::max(bounds.Max, position);
+		}
+		return bounds;
+	}
+
+	uint32_t Culling2D::CullQuads(const float* centerX, const float* centerY, const float* extentX, const float* extentY, uint32_t count,
+		const Bounds2D& viewBounds, uint8_t* outVisibility)
+	{
+		ZE_PROFILE_FUNCTION();
+
+		uint32_t visibleCount = 0;
+		uint32_t i = 0;
+
+#if defined(ZE_SIMD_AVX2)
+		const __m256 minX = _mm256_set1_ps(viewBounds.Min.x);
+		const __m256 minY = _mm256_set1_ps(viewBounds.Min.y);
+		const __m256 maxX = _mm256_set1_ps(viewBounds.Max.x);
+		const __m256 maxY = _mm256_set1_ps(viewBounds.Max.y);
+		for (; i + 8 <= count; i += 8)
+		{
+			const __m256 cx = _mm256_loadu_ps(centerX + i);
+			const __m256 cy = _mm256_loadu_ps(centerY + i);
+			const __m256 ex = _mm256_loadu_ps(extentX + i);
+			const __m256 ey = _mm256_loadu_ps(extentY + i);
+
+			__m256 visible = _mm256_cmp_ps(_mm256_add_ps(cx, ex), minX, _CMP_GE_OQ);
+			visible = _mm256_and_ps(visible, _mm256_cmp_ps(_mm256_sub_ps(cx, ex), maxX, _CMP_LE_OQ));
+			visible = _mm256_and_ps(visible, _mm256_cmp_ps(_mm256_add_ps(cy, ey), minY, _CMP_GE_OQ));
+			visible = _mm256_and_ps(visible, _mm256_cmp_ps(_mm256_sub_ps(cy, ey), maxY, _CMP_LE_OQ));
+
+			const int mask = _mm256_movemask_ps(visible);
+			for (uint32_t lane = 0; lane < 8; ++lane)
+			{
+				const uint8_t bVisible = static_cast<uint8_t>((mask >> lane) & 1);
+				outVisibility[i + lane] = bVisible;
+				visibleCount += bVisible;
+			}
+		}
+#elif defined(ZE_SIMD_SSE)
+		const __m128 minX = _mm_set1_ps(viewBounds.Min.x);
+		const __m128 minY = _mm_set1_ps(viewBounds.Min.y);
+		const __m128 maxX = _mm_set1_ps(viewBounds.Max.x);
+		const __m128 maxY = _mm_set1_ps(viewBounds.Max.y);
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128 cx = _mm_loadu_ps(centerX + i);
+			const __m128 cy = _mm_loadu_ps(centerY + i);
+			const __m128 ex = _mm_loadu_ps(extentX + i);
+			const __m128 ey = _mm_loadu_ps(extentY + i);
+
+			__m128 visible = _mm_cmpge_ps(_mm_add_ps(cx, ex), minX);
+			visible = _mm_and_ps(visible, _mm_cmple_ps(_mm_sub_ps(cx, ex), maxX));
+			visible = _mm_and_ps(visible, _mm_cmpge_ps(_mm_add_ps(cy, ey), minY));
+			visible = _mm_and_ps(visible, _mm_cmple_ps(_mm_sub_ps(cy, ey), maxY));
+
+			const int mask = _mm_movemask_ps(visible);
+			for (uint32_t lane = 0; lane < 4; ++lane)
+			{
+				const uint8_t bVisible = static_cast<uint8_t>((mask >> lane) & 1);
+				outVisibility[i + lane] = bVisible;
+				visibleCount += bVisible;
+			}
+		}
+#endif
+
+		// Remaining quads, or all of them if SIMD is unavailable
+		for (; i < count; ++i)
+		{
+			const bool bVisible = centerX[i] + extentX[i] >= viewBounds.Min.x && centerX[i] - extentX[i] <= viewBounds.Max.x &&
+				centerY[i] + extentY[i] >= viewBounds.Min.y && centerY[i] - extentY[i] <= viewBounds.Max.y;
+			outVisibility[i] = bVisible ? 1 : 0;
+			visibleCount += bVisible ? 1 : 0;
+		}
+
+		return visibleCount;
+	}
+
+}
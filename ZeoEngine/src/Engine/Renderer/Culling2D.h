@@ -0,0 +1,47 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace ZeoEngine {
+
+	/** Axis-aligned rectangle in world space. */
+	struct Bounds2D
+	{
+		glm::vec2 Min{ 0.0f };
+		glm::vec2 Max{ 0.0f };
+
+		bool Intersects(const Bounds2D& other) const
+		{
+			return Max.x >= other.Min.x && Min.x <= other.Max.x &&
+				Max.y >= other.Min.y && Min.y <= other.Max.y;
+		}
+	};
+
+	class Culling2D
+	{
+	public:
+		/** Returns world-space bounds of the visible area, derived from the inverse of an orthographic view projection matrix. */
+		static Bounds2D ComputeViewBounds(const glm::mat4& viewProjection);
+
+		/** Returns world-space bounds of a unit quad centered at the origin after being transformed. */
+		static Bounds2D ComputeQuadBounds(const glm::mat4& transform)
+		{
+			const glm::vec2 center = { transform[3][0], transform[3][1] };
+			const glm::vec2 extent = 0.5f * glm::vec2(glm::abs(transform[0][0]) + glm::abs(transform[1][0]), glm::abs(transform[0][1]) + glm::abs(transform[1][1]));
+			return { center - extent, center + extent };
+		}
+
+		static bool IsQuadVisible(const glm::mat4& transform, const Bounds2D& viewBounds)
+		{
+			return ComputeQuadBounds(transform).Intersects(viewBounds);
+		}
+
+		/**
+		 * Test many quads given as SoA arrays of centers and half extents against the view bounds, 8 (AVX2) or 4 (SSE) at a time.
+		 * outVisibility[i] is set to 1 if the i-th quad is visible and 0 otherwise. Returns the number of visible quads.
+		 */
+		static uint32_t CullQuads(const float* centerX, const float* centerY, const float* extentX, const float* extentY, uint32_t count,
+			const Bounds2D& viewBounds, uint8_t* outVisibility);
+	};
+
+}
@@ -0,0 +1,322 @@
+#include "ZEpch.h"
+#include "Engine/Renderer/Font.h"
+
+#include <fstream>
+
+#include "Engine/Renderer/VertexPacking.h"
+
+// ImGui compiles its own copy of stb_truetype, a static one keeps the symbols of both private
+#define STB_TRUETYPE_IMPLEMENTATION
+#define STBTT_STATIC
+#include <imstb_truetype.h>
+
+namespace ZeoEngine {
+
+	/** Range of code points rasterized into the atlas, printable ASCII and Latin-1 */
+	static constexpr uint32_t s_FirstCodepoint = 32;
+	static constexpr uint32_t s_LastCodepoint = 255;
+	/** Drawn for characters the font or the atlas does not have */
+	static constexpr uint32_t s_FallbackCodepoint = '?';
+
+	/** Width in atlas pixels of the distance field around each glyph outline */
+	static constexpr int32_t s_SdfPadding = 4;
+	/** Distance value on the outline, mapped to 0.5 when sampled */
+	static constexpr uint8_t s_SdfOnEdgeValue = 128;
+	static constexpr uint32_t s_AtlasWidth = 512;
+	/** Empty pixels between glyphs so that bilinear sampling never picks up a neighbour */
+	static constexpr uint32_t s_AtlasGlyphSpacing = 1;
+
+	/** Strings which change every frame would grow the layout cache forever, so least recently used layouts are replaced beyond this size */
+	static constexpr size_t s_MaxCachedLayouts = 4096;
+
+	static uint64_t MakeKerningKey(uint32_t left, uint32_t right)
+	{
+		return (static_cast<uint64_t>(left) << 32) | right;
+	}
+
+	/** Decode the code point starting at offset and move offset past it, malformed sequences decode as U+FFFD. */
+	static uint32_t DecodeUtf8(const std::string& text, size_t& offset)
+	{
+		const uint8_t lead = static_cast<uint8_t>(text[offset++]);
+		if (lead < 0x80)
+			return lead;
+
+		uint32_t continuationCount, codepoint;
+		if ((lead & 0xe0) == 0xc0)
+		{
+			continuationCount = 1;
+			codepoint = lead & 0x1f;
+		}
+		else if ((lead & 0xf0) == 0xe0)
+		{
+			continuationCount = 2;
+			codepoint = lead & 0x0f;
+		}
+		else if ((lead & 0xf8) == 0xf0)
+		{
+			continuationCount = 3;
+			codepoint = lead & 0x07;
+		}
+		else
+		{
+			return 0xfffd;
+		}
+
+		for (uint32_t i = 0; i < continuationCount; ++i)
+		{
+			if (offset >= text.size() || (static_cast<uint8_t>(text[offset]) & 0xc0) != 0x80)
+				return 0xfffd;
+
+			codepoint = (codepoint << 6) | (static_cast<uint8_t>(text[offset++]) & 0x3f);
+		}
+		return codepoint;
+	}
+
+	Font::Font(const std::string& path, float sdfPixelSize)
+	{
+		ZE_PROFILE_FUNCTION();
+		ZE_MEMORY_TAG(Textures);
+
+		std::vector<uint8_t> fontData;
+		{
+			std::ifstream in(path, std::ios::in | std::ios::binary);
+			if (in)
+			{
+				in.seekg(0, std::ios::end);
+				fontData.resize(static_cast<size_t>(in.tellg()));
+				in.seekg(0, std::ios::beg);
+				in.read(reinterpret_cast<char*>(fontData.data()), fontData.size());
+			}
+		}
+
+		stbtt_fontinfo fontInfo;
+		if (fontData.empty() || !stbtt_InitFont(&fontInfo, fontData.data(), stbtt_GetFontOffsetForIndex(fontData.data(), 0)))
+		{
+			ZE_CORE_ERROR("Failed to load font: '{0}'", path);
+			// Keep the font usable, it just draws nothing
+			m_AtlasTexture = Texture2D::Create(1, 1);
+			uint32_t transparentTextureData = 0;
+			m_AtlasTexture->SetData(&transparentTextureData, sizeof(uint32_t));
+			return;
+		}
+
+		// All metrics are converted from font units to em units
+		const float scale = stbtt_ScaleForMappingEmToPixels(&fontInfo, sdfPixelSize);
+		const float pixelToEm = 1.0f / sdfPixelSize;
+		int ascent, descent, lineGap;
+		stbtt_GetFontVMetrics(&fontInfo, &ascent, &descent, &lineGap);
+		m_LineHeight = (ascent - descent + lineGap) * scale * pixelToEm;
+
+		struct GlyphBitmap
+		{
+			uint32_t Codepoint;
+			uint8_t* Pixels;
+			int Width, Height;
+			/** Offset of the top left corner from the pen position, y pointing down */
+			int OffsetX, OffsetY;
+			uint32_t AtlasX = 0, AtlasY = 0;
+		};
+		std::vector<GlyphBitmap> bitmaps;
+		std::vector<std::pair<uint32_t, int>> glyphIndices;
+		{
+			ZE_PROFILE_SCOPE("Rasterize SDF glyphs - Font::Font(const std::string&, float)");
+
+			const float pixelDistanceScale = static_cast<float>(s_SdfOnEdgeValue) / s_SdfPadding;
+			for (uint32_t codepoint = s_FirstCodepoint; codepoint <= s_LastCodepoint; ++codepoint)
+			{
+				const int glyphIndex = stbtt_FindGlyphIndex(&fontInfo, static_cast<int>(codepoint));
+				// Glyph 0 is the missing glyph, except for the space which may well map to it
+				if (glyphIndex == 0 && codepoint != ' ')
+					continue;
+
+				glyphIndices.emplace_back(codepoint, glyphIndex);
+				int advance, leftSideBearing;
+				stbtt_GetGlyphHMetrics(&fontInfo, glyphIndex, &advance, &leftSideBearing);
+				m_Glyphs[codepoint].Advance = advance * scale * pixelToEm;
+
+				GlyphBitmap bitmap;
+				bitmap.Codepoint = codepoint;
+				bitmap.Pixels = stbtt_GetGlyphSDF(&fontInfo, scale, glyphIndex, s_SdfPadding, s_SdfOnEdgeValue, pixelDistanceScale,
+					&bitmap.Width, &bitmap.Height, &bitmap.OffsetX, &bitmap.OffsetY);
+				// Whitespace has no shape to rasterize
+				if (bitmap.Pixels)
+				{
+					bitmaps.push_back(bitmap);
+				}
+			}
+		}
+
+		// Pack into shelves, tallest glyphs first so that shelves waste little height
+		std::sort(bitmaps.begin(), bitmaps.end(), [](const GlyphBitmap& lhs, const GlyphBitmap& rhs) { return lhs.Height > rhs.Height; });
+		uint32_t shelfX = 0, shelfY = 0, shelfHeight = 0;
+		for (auto& bitmap : bitmaps)
+		{
+			const uint32_t width = static_cast<uint32_t>(bitmap.Width) + s_AtlasGlyphSpacing;
+			const uint32_t height = static_cast<uint32_t>(bitmap.Height) + s_AtlasGlyphSpacing;
+			ZE_CORE_ASSERT(width <= s_AtlasWidth, "Glyph is wider than the font atlas!");
+			if (shelfX + width > s_AtlasWidth)
+			{
+				shelfX = 0;
+				shelfY += shelfHeight;
+				shelfHeight = 0;
+			}
+			bitmap.AtlasX = shelfX;
+			bitmap.AtlasY = shelfY;
+			shelfX += width;
+			shelfHeight = std::max(shelfHeight, height);
+		}
+		uint32_t atlasHeight = 1;
+		while (atlasHeight < shelfY + shelfHeight)
+		{
+			atlasHeight *= 2;
+		}
+
+		// White texels with the distance in alpha, so that the atlas can be tinted like any other texture
+		std::vector<uint32_t> atlasPixels(s_AtlasWidth * atlasHeight, 0x00ffffff);
+		const float texelWidth = 1.0f / s_AtlasWidth;
+		const float texelHeight = 1.0f / atlasHeight;
+		for (const auto& bitmap : bitmaps)
+		{
+			// Bitmap rows go top down while the first texture row is the bottom one
+			for (int row = 0; row < bitmap.Height; ++row)
+			{
+				uint32_t* atlasRow = atlasPixels.data() + (atlasHeight - 1 - (bitmap.AtlasY + row)) * s_AtlasWidth + bitmap.AtlasX;
+				for (int column = 0; column < bitmap.Width; ++column)
+				{
+					atlasRow[column] = 0x00ffffff | (static_cast<uint32_t>(bitmap.Pixels[row * bitmap.Width + column]) << 24);
+				}
+			}
+			stbtt_FreeSDF(bitmap.Pixels, nullptr);
+
+			GlyphMetrics& metrics = m_Glyphs[bitmap.Codepoint];
+			metrics.QuadMin = glm::vec2(bitmap.OffsetX, -(bitmap.OffsetY + bitmap.Height)) * pixelToEm;
+			metrics.QuadMax = glm::vec2(bitmap.OffsetX + bitmap.Width, -bitmap.OffsetY) * pixelToEm;
+			const glm::vec2 texCoordMin = { bitmap.AtlasX * texelWidth, (atlasHeight - bitmap.AtlasY - bitmap.Height) * texelHeight };
+			const glm::vec2 texCoordMax = { (bitmap.AtlasX + bitmap.Width) * texelWidth, (atlasHeight - bitmap.AtlasY) * texelHeight };
+			metrics.PackedTexCoords[0] = VertexPacking::PackHalf2(texCoordMin);
+			metrics.PackedTexCoords[1] = VertexPacking::PackHalf2({ texCoordMax.x, texCoordMin.y });
+			metrics.PackedTexCoords[2] = VertexPacking::PackHalf2(texCoordMax);
+			metrics.PackedTexCoords[3] = VertexPacking::PackHalf2({ texCoordMin.x, texCoordMax.y });
+		}
+
+		m_AtlasTexture = Texture2D::Create(s_AtlasWidth, atlasHeight);
+		m_AtlasTexture->SetData(atlasPixels.data(), static_cast<uint32_t>(atlasPixels.size() * sizeof(uint32_t)));
+		// The distance field is meant to be interpolated, especially when magnified
+		m_AtlasTexture->SetFilter(TextureFilter::Linear, TextureFilter::Linear);
+
+		{
+			ZE_PROFILE_SCOPE("Cache kerning - Font::Font(const std::string&, float)");
+
+			for (const auto& [left, leftGlyph] : glyphIndices)
+			{
+				for (const auto& [right, rightGlyph] : glyphIndices)
+				{
+					const int kerning = stbtt_GetGlyphKernAdvance(&fontInfo, leftGlyph, rightGlyph);
+					if (kerning != 0)
+					{
+						m_Kerning.emplace(MakeKerningKey(left, right), kerning * scale * pixelToEm);
+					}
+				}
+			}
+		}
+	}
+
+	Ref<Font> Font::Create(const std::string& path, float sdfPixelSize)
+	{
+		return CreateRef<Font>(path, sdfPixelSize);
+	}
+
+	const GlyphMetrics* Font::GetGlyph(uint32_t codepoint) const
+	{
+		auto it = m_Glyphs.find(codepoint);
+		return it != m_Glyphs.end() ? &it->second : nullptr;
+	}
+
+	float Font::GetKerning(uint32_t left, uint32_t right) const
+	{
+		auto it = m_Kerning.find(MakeKerningKey(left, right));
+		return it != m_Kerning.end() ? it->second : 0.0f;
+	}
+
+	const TextLayout& Font::GetLayout(const std::string& text)
+	{
+		auto it = m_LayoutCacheIndex.find(text);
+		if (it != m_LayoutCacheIndex.end())
+		{
+			m_LayoutCache.splice(m_LayoutCache.begin(), m_LayoutCache, it->second);
+			return it->second->second;
+		}
+
+		ZE_MEMORY_TAG(Renderer);
+
+		if (m_LayoutCache.size() >= s_MaxCachedLayouts)
+		{
+			// Reuse the least recently used entry, which also keeps the memory of its glyph array
+			m_LayoutCacheIndex.erase(m_LayoutCache.back().first);
+			m_LayoutCache.splice(m_LayoutCache.begin(), m_LayoutCache, std::prev(m_LayoutCache.end()));
+			CachedLayout& entry = m_LayoutCache.front();
+			entry.first = text;
+			entry.second.Glyphs.clear();
+			entry.second.Min = entry.second.Max = glm::vec2(0.0f);
+		}
+		else
+		{
+			m_LayoutCache.emplace_front(text, TextLayout());
+		}
+		m_LayoutCacheIndex.emplace(m_LayoutCache.front().first, m_LayoutCache.begin());
+
+		TextLayout& layout = m_LayoutCache.front().second;
+		LayoutText(text, layout);
+		return layout;
+	}
+
+	void Font::LayoutText(const std::string& text, TextLayout& outLayout) const
+	{
+		ZE_PROFILE_FUNCTION();
+
+		glm::vec2 pen{ 0.0f };
+		uint32_t previousCodepoint = 0;
+		glm::vec2 min{ std::numeric_limits<float>::max() };
+		glm::vec2 max{ std::numeric_limits<float>::lowest() };
+		size_t offset = 0;
+		while (offset < text.size())
+		{
+			uint32_t codepoint = DecodeUtf8(text, offset);
+			if (codepoint == '\n')
+			{
+				pen = { 0.0f, pen.y - m_LineHeight };
+				previousCodepoint = 0;
+				continue;
+			}
+
+			const GlyphMetrics* glyph = GetGlyph(codepoint);
+			if (!glyph)
+			{
+				codepoint = s_FallbackCodepoint;
+				glyph = GetGlyph(codepoint);
+				if (!glyph)
+					continue;
+			}
+
+			if (previousCodepoint != 0)
+			{
+				pen.x += GetKerning(previousCodepoint, codepoint);
+			}
+			if (glyph->HasShape())
+			{
+				outLayout.Glyphs.push_back({ glyph, pen });
+				min = glm::min(min, pen + glyph->QuadMin);
+				max = glm::max(max, pen + glyph->QuadMax);
+			}
+			pen.x += glyph->Advance;
+			previousCodepoint = codepoint;
+		}
+
+		if (!outLayout.Glyphs.empty())
+		{
+			outLayout.Min = min;
+			outLayout.Max = max;
+		}
+	}
+
+}
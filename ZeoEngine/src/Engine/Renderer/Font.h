@@ -0,0 +1,90 @@
+#pragma once
+
+#include <list>
+#include <string_view>
+
+#include <glm/glm.hpp>
+
+#include "Engine/Renderer/Texture.h"
+
+namespace ZeoEngine {
+
+	/** Placement of a glyph in em units, relative to the pen position on the baseline with y pointing up. */
+	struct GlyphMetrics
+	{
+		glm::vec2 QuadMin{ 0.0f };
+		glm::vec2 QuadMax{ 0.0f };
+		/** Atlas texture coordinates of the four corners in the order of Renderer2D quad vertices, packed as ShaderDataType::Half2 */
+		uint32_t PackedTexCoords[4] = {};
+		float Advance = 0.0f;
+
+		/** Whitespace only advances the pen */
+		bool HasShape() const { return QuadMax.x > QuadMin.x; }
+	};
+
+	/** Glyphs of a laid out string in em units, relative to the start of the baseline of its first line. */
+	struct TextLayout
+	{
+		struct Glyph
+		{
+			const GlyphMetrics* Metrics;
+			/** Pen position */
+			glm::vec2 Position;
+		};
+
+		/** Glyphs with a shape only */
+		std::vector<Glyph> Glyphs;
+		/** Bounds of all glyph quads */
+		glm::vec2 Min{ 0.0f };
+		glm::vec2 Max{ 0.0f };
+	};
+
+	/**
+	 * A TrueType font whose glyphs are rasterized into a signed distance field atlas at load, so that text stays sharp at any scale.
+	 * Covers printable ASCII and Latin-1 characters, others are drawn as '?'.
+	 * Glyph metrics and kerning are cached at load, laying out text never touches the font file again.
+	 */
+	class Font : public RefCounted
+	{
+	public:
+		/** @param sdfPixelSize - Em size in pixels glyphs are rasterized at, larger sizes keep sharper corners at the cost of atlas memory */
+		Font(const std::string& path, float sdfPixelSize);
+
+		/** Returns nullptr if the font has no glyph for the code point. */
+		const GlyphMetrics* GetGlyph(uint32_t codepoint) const;
+		/** Adjustment of the pen advance between two characters in em units. */
+		float GetKerning(uint32_t left, uint32_t right) const;
+		/** Distance between baselines of consecutive lines in em units. */
+		float GetLineHeight() const { return m_LineHeight; }
+
+		/**
+		 * Returns the layout of a UTF-8 string, lines are separated by '\n'.
+		 * Layouts are cached by string, so strings drawn every frame like labels and damage numbers are laid out only once.
+		 * When the cache is full the least recently used layout is replaced.
+		 * The returned reference stays valid until the next call. Must be called from the main thread.
+		 */
+		const TextLayout& GetLayout(const std::string& text);
+
+		/** Distance to the glyph outline is stored in alpha, 0.5 being on the outline. */
+		const Ref<Texture2D>& GetAtlasTexture() const { return m_AtlasTexture; }
+
+		static Ref<Font> Create(const std::string& path, float sdfPixelSize = 32.0f);
+
+	private:
+		void LayoutText(const std::string& text, TextLayout& outLayout) const;
+
+	private:
+		std::unordered_map<uint32_t, GlyphMetrics> m_Glyphs;
+		/** Non-zero kerning of code point pairs, see MakeKerningKey() */
+		std::unordered_map<uint64_t, float> m_Kerning;
+		float m_LineHeight = 0.0f;
+		Ref<Texture2D> m_AtlasTexture;
+
+		using CachedLayout = std::pair<std::string, TextLayout>;
+		/** Most recently used first */
+		std::list<CachedLayout> m_LayoutCache;
+		/** Keys view the strings stored in m_LayoutCache */
+		std::unordered_map<std::string_view, std::list<CachedLayout>::iterator> m_LayoutCacheIndex;
+	};
+
+}
@@ -0,0 +1,298 @@
+#include "ZEpch.h"
+#include "Engine/Renderer/HotReloader.h"
+
+#include "Engine/Core/FileWatcher.h"
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Core/FrameAllocator.h"
+
+#include <mutex>
+#include <chrono>
+#include <filesystem>
+
+namespace ZeoEngine {
+
+	struct ShaderRegistration
+	{
+		Shader* ShaderPtr;
+		ShaderDefines Defines;
+	};
+
+	struct ShaderReloadResult
+	{
+		std::string FilePath;
+		std::string DefinesKey;
+		ShaderSources Sources;
+	};
+
+	struct TextureReloadResult
+	{
+		std::string FilePath;
+		ImageData Image;
+	};
+
+	struct HotReloaderData
+	{
+		using Clock = std::chrono::steady_clock;
+		/** Editors tend to write a file several times on save, wait until it settles down */
+		static constexpr std::chrono::milliseconds DebounceTime{ 100 };
+
+		Scope<FileWatcher> Watcher;
+
+		/** Map from normalized file path to resources loaded from it */
+		std::unordered_map<std::string, std::vector<ShaderRegistration>> Shaders;
+		std::unordered_map<std::string, std::vector<Texture2D*>> Textures;
+		std::mutex RegistryMutex;
+
+		/** Files reported by the watcher and the time of their latest change */
+		std::unordered_map<std::string, Clock::time_point> ChangedFiles;
+		std::mutex ChangedFilesMutex;
+
+		/** Data prepared by worker jobs, waiting to be swapped in */
+		std::vector<ShaderReloadResult> ShaderResults;
+		std::vector<TextureReloadResult> TextureResults;
+		std::mutex ResultMutex;
+		/** Tracks in-flight reload jobs */
+		JobCounter PendingJobs;
+	};
+
+	static HotReloaderData* s_ReloaderData = nullptr;
+
+	/** Paths reported by the watcher and paths passed in by users may use different separators. */
+	static std::string NormalizePath(const std::string& filePath)
+	{
+		return std::filesystem::path(filePath).lexically_normal().generic_string();
+	}
+
+	void HotReloader::Init(const std::string& assetDirectory)
+	{
+#ifdef ZE_ENABLE_HOT_RELOAD
+		ZE_PROFILE_FUNCTION();
+
+		s_ReloaderData = new HotReloaderData();
+		s_ReloaderData->Watcher = FileWatcher::Create(assetDirectory, &HotReloader::OnFileChanged);
+#endif // ZE_ENABLE_HOT_RELOAD
+	}
+
+	void HotReloader::Shutdown()
+	{
+#ifdef ZE_ENABLE_HOT_RELOAD
+		ZE_PROFILE_FUNCTION();
+
+		// Stop the watcher thread and in-flight jobs before releasing data they write to
+		s_ReloaderData->Watcher.reset();
+		JobSystem::Wait(s_ReloaderData->PendingJobs);
+		delete s_ReloaderData;
+		s_ReloaderData = nullptr;
+#endif // ZE_ENABLE_HOT_RELOAD
+	}
+
+	void HotReloader::Update()
+	{
+		if (!s_ReloaderData)
+			return;
+
+		ZE_PROFILE_FUNCTION();
+
+		// Extract the map nodes instead of copying their keys so that no string is allocated
+		using ChangedFileNode = decltype(s_ReloaderData->ChangedFiles)::node_type;
+		FrameVector<ChangedFileNode> settledFiles;
+		{
+			std::lock_guard<std::mutex> lock(s_ReloaderData->ChangedFilesMutex);
+			const auto now = HotReloaderData::Clock::now();
+			for (auto it = s_ReloaderData->ChangedFiles.begin(); it != s_ReloaderData->ChangedFiles.end(); )
+			{
+				if (now - it->second >= HotReloaderData::DebounceTime)
+				{
+					settledFiles.push_back(s_ReloaderData->ChangedFiles.extract(it++));
+				}
+				else
+				{
+					++it;
+				}
+			}
+		}
+
+		for (const auto& node : settledFiles)
+		{
+			ScheduleReload(node.key());
+		}
+
+		ApplyReloads();
+	}
+
+	void HotReloader::RegisterShader(Shader* shader, const std::string& filePath, const ShaderDefines& defines)
+	{
+		if (!s_ReloaderData)
+			return;
+
+		std::lock_guard<std::mutex> lock(s_ReloaderData->RegistryMutex);
+		s_ReloaderData->Shaders[NormalizePath(filePath)].push_back({ shader, defines });
+	}
+
+	void HotReloader::UnregisterShader(Shader* shader)
+	{
+		if (!s_ReloaderData)
+			return;
+
+		std::lock_guard<std::mutex> lock(s_ReloaderData->RegistryMutex);
+		for (auto& pair : s_ReloaderData->Shaders)
+		{
+			auto& registrations = pair.second;
+			registrations.erase(std::remove_if(registrations.begin(), registrations.end(),
+				[shader](const ShaderRegistration& registration) { return registration.ShaderPtr == shader; }),
+				registrations.end());
+		}
+	}
+
+	void HotReloader::RegisterTexture(Texture2D* texture, const std::string& filePath)
+	{
+		if (!s_ReloaderData)
+			return;
+
+		std::lock_guard<std::mutex> lock(s_ReloaderData->RegistryMutex);
+		s_ReloaderData->Textures[NormalizePath(filePath)].push_back(texture);
+	}
+
+	void HotReloader::UnregisterTexture(Texture2D* texture)
+	{
+		if (!s_ReloaderData)
+			return;
+
+		std::lock_guard<std::mutex> lock(s_ReloaderData->RegistryMutex);
+		for (auto& pair : s_ReloaderData->Textures)
+		{
+			auto& textures = pair.second;
+			textures.erase(std::remove(textures.begin(), textures.end(), texture), textures.end());
+		}
+	}
+
+	void HotReloader::OnFileChanged(const std::string& filePath)
+	{
+		// Events may still arrive after Shutdown has released the data
+		if (!s_ReloaderData)
+			return;
+
+		std::lock_guard<std::mutex> lock(s_ReloaderData->ChangedFilesMutex);
+		s_ReloaderData->ChangedFiles[NormalizePath(filePath)] = HotReloaderData::Clock::now();
+	}
+
+	void HotReloader::ScheduleReload(const std::string& filePath)
+	{
+		ZE_PROFILE_FUNCTION();
+
+		// Collect what to reload first so that jobs do not touch the registry
+		std::vector<std::pair<std::string, ShaderDefines>> shadersToReload;
+		bool bReloadTexture = false;
+		{
+			std::lock_guard<std::mutex> lock(s_ReloaderData->RegistryMutex);
+			auto shaderIt = s_ReloaderData->Shaders.find(filePath);
+			if (shaderIt != s_ReloaderData->Shaders.end())
+			{
+				for (const auto& registration : shaderIt->second)
+				{
+					shadersToReload.emplace_back(filePath, registration.Defines);
+				}
+			}
+			else if (std::filesystem::path(filePath).extension() == ".glsl")
+			{
+				// An included file has changed, dependencies are not tracked so reload every shader
+				// Unaffected ones will hit the program binary cache
+				for (const auto& pair : s_ReloaderData->Shaders)
+				{
+					for (const auto& registration : pair.second)
+					{
+						shadersToReload.emplace_back(pair.first, registration.Defines);
+					}
+				}
+			}
+
+			auto textureIt = s_ReloaderData->Textures.find(filePath);
+			bReloadTexture = textureIt != s_ReloaderData->Textures.end() && !textureIt->second.empty();
+		}
+
+		for (auto& pair : shadersToReload)
+		{
+			JobSystem::ExecuteBackground([filePath = pair.first, defines = pair.second]()
+			{
+				ShaderReloadResult result{ filePath, ShaderPreprocessor::GetDefinesKey(defines), ShaderPreprocessor::Process(filePath, defines) };
+				std::lock_guard<std::mutex> lock(s_ReloaderData->ResultMutex);
+				s_ReloaderData->ShaderResults.emplace_back(std::move(result));
+			}, &s_ReloaderData->PendingJobs);
+		}
+
+		if (bReloadTexture)
+		{
+			JobSystem::ExecuteBackground([filePath]()
+			{
+				TextureReloadResult result{ filePath, ImageData::Load(filePath) };
+				std::lock_guard<std::mutex> lock(s_ReloaderData->ResultMutex);
+				s_ReloaderData->TextureResults.emplace_back(std::move(result));
+			}, &s_ReloaderData->PendingJobs);
+		}
+	}
+
+	void HotReloader::ApplyReloads()
+	{
+		std::vector<ShaderReloadResult> shaderResults;
+		std::vector<TextureReloadResult> textureResults;
+		{
+			std::lock_guard<std::mutex> lock(s_ReloaderData->ResultMutex);
+			shaderResults.swap(s_ReloaderData->ShaderResults);
+			textureResults.swap(s_ReloaderData->TextureResults);
+		}
+
+		if (shaderResults.empty() && textureResults.empty())
+			return;
+
+		ZE_PROFILE_FUNCTION();
+
+		// Resources may have been destroyed since the jobs were scheduled, so look them up again
+		// Reloading may release the last reference to a resource whose destructor unregisters it, so the registry must not be locked while reloading
+		// Taking references keeps the collected resources alive until they are reloaded
+		std::vector<std::pair<Ref<Shader>, const ShaderSources*>> shadersToReload;
+		std::vector<std::pair<Ref<Texture2D>, const TextureReloadResult*>> texturesToReload;
+		{
+			std::lock_guard<std::mutex> lock(s_ReloaderData->RegistryMutex);
+			for (const auto& result : shaderResults)
+			{
+				auto it = s_ReloaderData->Shaders.find(result.FilePath);
+				if (it == s_ReloaderData->Shaders.end())
+					continue;
+
+				for (const auto& registration : it->second)
+				{
+					if (ShaderPreprocessor::GetDefinesKey(registration.Defines) == result.DefinesKey)
+					{
+						shadersToReload.emplace_back(Ref<Shader>(registration.ShaderPtr), &result.Sources);
+					}
+				}
+			}
+
+			for (const auto& result : textureResults)
+			{
+				auto it = s_ReloaderData->Textures.find(result.FilePath);
+				if (it == s_ReloaderData->Textures.end())
+					continue;
+
+				for (Texture2D* texture : it->second)
+				{
+					texturesToReload.emplace_back(Ref<Texture2D>(texture), &result);
+				}
+			}
+		}
+
+		for (const auto& pair : shadersToReload)
+		{
+			pair.first->Reload(*pair.second);
+		}
+
+		for (const auto& pair : texturesToReload)
+		{
+			ZE_MEMORY_TAG(Textures);
+
+			pair.first->Reload(pair.second->Image);
+			ZE_CORE_INFO("Reloaded texture '{0}'", pair.second->FilePath);
+		}
+	}
+
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Engine/Renderer/Shader.h"
+#include "Engine/Renderer/Texture.h"
+
+namespace ZeoEngine {
+
+	/**
+	 * Watches the asset directory and reloads shaders and textures whose source files have changed.
+	 *
+	 * Shader preprocessing and image decoding happen on worker threads,
+	 * while GPU resources are recreated and swapped in at the beginning of a frame in Update(),
+	 * so a frame never sees a half-reloaded resource.
+	 * Resources register themselves on creation and unregister on destruction.
+	 * Hot-reloading is only enabled if ZE_ENABLE_HOT_RELOAD is defined, otherwise all functions do nothing.
+	 */
+	class HotReloader
+	{
+	public:
+		static void Init(const std::string& assetDirectory = "assets");
+		static void Shutdown();
+
+		/** Apply finished reloads. This must be called on the thread owning the graphics context at a frame boundary. */
+		static void Update();
+
+		static void RegisterShader(Shader* shader, const std::string& filePath, const ShaderDefines& defines = {});
+		static void UnregisterShader(Shader* shader);
+		static void RegisterTexture(Texture2D* texture, const std::string& filePath);
+		static void UnregisterTexture(Texture2D* texture);
+
+	private:
+		/** Called on the watcher thread. */
+		static void OnFileChanged(const std::string& filePath);
+		/** Kick off worker jobs which prepare new data for resources loaded from the file. */
+		static void ScheduleReload(const std::string& filePath);
+		static void ApplyReloads();
+
+	};
+
+}
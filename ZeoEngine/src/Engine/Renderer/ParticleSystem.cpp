@@ -0,0 +1,175 @@
+#include "ZEpch.h"
+#include "Engine/Renderer/ParticleSystem.h"
+
+#include "Engine/Renderer/Renderer2D.h"
+#include "Engine/Renderer/VertexPacking.h"
+#include "Engine/Core/JobSystem.h"
+
+#ifdef ZE_SIMD_SSE
+	#include <immintrin.h>
+#endif // ZE_SIMD_SSE
+
+namespace ZeoEngine {
+
+	/** Particles per job, small enough to spread a few thousand particles across workers */
+	static const uint32_t s_UpdateChunkSize = 4096;
+
+	ParticleSystem::ParticleSystem(uint32_t maxCount)
+		: m_MaxCount(maxCount)
+	{
+		ZE_PROFILE_FUNCTION();
+		ZE_MEMORY_TAG(Renderer);
+
+		m_PositionX.resize(maxCount);
+		m_PositionY.resize(maxCount);
+		m_VelocityX.resize(maxCount);
+		m_VelocityY.resize(maxCount);
+		m_Life.resize(maxCount);
+		m_InverseLifeTime.resize(maxCount);
+		m_SizeBegin.resize(maxCount);
+		m_SizeEnd.resize(maxCount);
+		m_ColorBegin.resize(maxCount);
+		m_ColorEnd.resize(maxCount);
+		m_Size.resize(maxCount);
+		m_PackedColor.resize(maxCount);
+	}
+
+	float ParticleSystem::NextRandom()
+	{
+		// Xorshift is plenty for visual variation and far cheaper than the standard engines
+		m_RandomState ^= m_RandomState << 13;
+		m_RandomState ^= m_RandomState >> 17;
+		m_RandomState ^= m_RandomState << 5;
+		return static_cast<float>(m_RandomState >> 8) * (1.0f / 16777216.0f) - 0.5f;
+	}
+
+	void ParticleSystem::Emit(const ParticleProps& props, uint32_t count)
+	{
+		ZE_PROFILE_FUNCTION();
+
+		ZE_CORE_ASSERT(props.LifeTime > 0.0f, "Particle lifetime must be positive!");
+
+		const uint32_t emitCount = std::min(count, m_MaxCount - m_Count);
+		const uint32_t packedColorBegin = VertexPacking::PackColor(props.ColorBegin);
+		for (uint32_t i = m_Count; i < m_Count + emitCount; ++i)
+		{
+			m_PositionX[i] = props.Position.x;
+			m_PositionY[i] = props.Position.y;
+			m_VelocityX[i] = props.Velocity.x + props.VelocityVariation.x * NextRandom();
+			m_VelocityY[i] = props.Velocity.y + props.VelocityVariation.y * NextRandom();
+			m_Life[i] = props.LifeTime;
+			m_InverseLifeTime[i] = 1.0f / props.LifeTime;
+			m_SizeBegin[i] = props.SizeBegin + props.SizeVariation * NextRandom();
+			m_SizeEnd[i] = props.SizeEnd;
+			m_ColorBegin[i] = props.ColorBegin;
+			m_ColorEnd[i] = props.ColorEnd;
+			// New particles can be rendered before their first update
+			m_Size[i] = m_SizeBegin[i];
+			m_PackedColor[i] = packedColorBegin;
+		}
+		m_Count += emitCount;
+	}
+
+	void ParticleSystem::OnUpdate(DeltaTime dt)
+	{
+		ZE_PROFILE_FUNCTION();
+
+		JobSystem::ParallelFor(m_Count, s_UpdateChunkSize, [this, dt](uint32_t begin, uint32_t end)
+		{
+			UpdateRange(begin, end, dt);
+		});
+		RemoveDeadParticles();
+	}
+
+	void ParticleSystem::UpdateRange(uint32_t begin, uint32_t end, float dt)
+	{
+		uint32_t i = begin;
+#ifdef ZE_SIMD_SSE
+		const __m128 deltaTime = _mm_set1_ps(dt);
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 colorScale = _mm_set1_ps(255.0f);
+		const __m128 half = _mm_set1_ps(0.5f);
+		alignas(16) float lifeFractions[4];
+		for (; i + 4 <= end; i += 4)
+		{
+			const __m128 life = _mm_sub_ps(_mm_loadu_ps(&m_Life[i]), deltaTime);
+			_mm_storeu_ps(&m_Life[i], life);
+			_mm_storeu_ps(&m_PositionX[i], _mm_add_ps(_mm_loadu_ps(&m_PositionX[i]), _mm_mul_ps(_mm_loadu_ps(&m_VelocityX[i]), deltaTime)));
+			_mm_storeu_ps(&m_PositionY[i], _mm_add_ps(_mm_loadu_ps(&m_PositionY[i]), _mm_mul_ps(_mm_loadu_ps(&m_VelocityY[i]), deltaTime)));
+
+			// 1 at birth and 0 at death
+			const __m128 lifeFraction = _mm_min_ps(_mm_max_ps(_mm_mul_ps(life, _mm_loadu_ps(&m_InverseLifeTime[i])), zero), one);
+			const __m128 sizeEnd = _mm_loadu_ps(&m_SizeEnd[i]);
+			_mm_storeu_ps(&m_Size[i], _mm_add_ps(sizeEnd, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&m_SizeBegin[i]), sizeEnd), lifeFraction)));
+
+			// Colors are stored per particle, so each one is interpolated and packed in a register of its own
+			_mm_store_ps(lifeFractions, lifeFraction);
+			for (uint32_t lane = 0; lane < 4; ++lane)
+			{
+				const __m128 colorEnd = _mm_loadu_ps(&m_ColorEnd[i + lane].x);
+				const __m128 colorBegin = _mm_loadu_ps(&m_ColorBegin[i + lane].x);
+				__m128 color = _mm_add_ps(colorEnd, _mm_mul_ps(_mm_sub_ps(colorBegin, colorEnd), _mm_set1_ps(lifeFractions[lane])));
+				// Same rounding as VertexPacking::PackColor()
+				color = _mm_min_ps(_mm_max_ps(color, zero), one);
+				const __m128i color32 = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(color, colorScale), half));
+				const __m128i color16 = _mm_packs_epi32(color32, color32);
+				m_PackedColor[i + lane] = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_packus_epi16(color16, color16)));
+			}
+		}
+#endif // ZE_SIMD_SSE
+		for (; i < end; ++i)
+		{
+			m_Life[i] -= dt;
+			m_PositionX[i] += m_VelocityX[i] * dt;
+			m_PositionY[i] += m_VelocityY[i] * dt;
+
+			const float lifeFraction = glm::clamp(m_Life[i] * m_InverseLifeTime[i], 0.0f, 1.0f);
+			m_Size[i] = m_SizeEnd[i] + (m_SizeBegin[i] - m_SizeEnd[i]) * lifeFraction;
+			m_PackedColor[i] = VertexPacking::PackColor(glm::mix(m_ColorEnd[i], m_ColorBegin[i], lifeFraction));
+		}
+	}
+
+	void ParticleSystem::RemoveDeadParticles()
+	{
+		ZE_PROFILE_FUNCTION();
+
+		uint32_t i = 0;
+		while (i < m_Count)
+		{
+			if (m_Life[i] > 0.0f)
+			{
+				++i;
+				continue;
+			}
+
+			// The particle moved in has not been checked yet, so i stays
+			--m_Count;
+			MoveParticle(m_Count, i);
+		}
+	}
+
+	void ParticleSystem::MoveParticle(uint32_t from, uint32_t to)
+	{
+		m_PositionX[to] = m_PositionX[from];
+		m_PositionY[to] = m_PositionY[from];
+		m_VelocityX[to] = m_VelocityX[from];
+		m_VelocityY[to] = m_VelocityY[from];
+		m_Life[to] = m_Life[from];
+		m_InverseLifeTime[to] = m_InverseLifeTime[from];
+		m_SizeBegin[to] = m_SizeBegin[from];
+		m_SizeEnd[to] = m_SizeEnd[from];
+		m_ColorBegin[to] = m_ColorBegin[from];
+		m_ColorEnd[to] = m_ColorEnd[from];
+		m_Size[to] = m_Size[from];
+		m_PackedColor[to] = m_PackedColor[from];
+	}
+
+	void ParticleSystem::OnRender(float z, const Ref<Texture2D>& texture) const
+	{
+		ZE_PROFILE_FUNCTION();
+
+		Renderer2D::DrawSquares(m_Count, m_PositionX.data(), m_PositionY.data(), m_Size.data(), m_PackedColor.data(), z, texture);
+	}
+
+}
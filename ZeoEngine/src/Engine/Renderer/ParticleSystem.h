@@ -0,0 +1,80 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "Engine/Core/DeltaTime.h"
+#include "Engine/Renderer/Texture.h"
+
+namespace ZeoEngine {
+
+	/** Describes particles to be emitted, variations are applied randomly per particle. */
+	struct ParticleProps
+	{
+		glm::vec2 Position{ 0.0f };
+		glm::vec2 Velocity{ 0.0f };
+		/** Each component of the velocity is offset by up to half of this in both directions */
+		glm::vec2 VelocityVariation{ 0.0f };
+		/** Color and size are interpolated from begin to end over the lifetime */
+		glm::vec4 ColorBegin{ 1.0f };
+		glm::vec4 ColorEnd{ 1.0f, 1.0f, 1.0f, 0.0f };
+		float SizeBegin = 0.1f;
+		float SizeEnd = 0.0f;
+		/** SizeBegin is offset by up to half of this in both directions */
+		float SizeVariation = 0.0f;
+		/** In seconds */
+		float LifeTime = 1.0f;
+	};
+
+	/**
+	 * A pool of 2D particles stored as structure of arrays, so that update kernels stream through each attribute with SIMD
+	 * and large pools are simulated in parallel chunks on the job system. Dead particles are removed by moving the last live particle into their place,
+	 * which keeps live particles packed at the front of the arrays in no particular order.
+	 */
+	class ParticleSystem
+	{
+	public:
+		ParticleSystem(uint32_t maxCount);
+
+		/** Particles beyond the capacity of the pool are dropped. */
+		void Emit(const ParticleProps& props, uint32_t count = 1);
+		void OnUpdate(DeltaTime dt);
+		/**
+		 * Submit live particles to Renderer2D as squares at depth z. Their vertices are written into the staging buffer of the translucent pass,
+		 * which is depth-sorted and batched when the scene ends.
+		 * Must be called between Renderer2D::BeginScene() and Renderer2D::EndScene().
+		 */
+		void OnRender(float z = 0.0f, const Ref<Texture2D>& texture = nullptr) const;
+		void Clear() { m_Count = 0; }
+
+		uint32_t GetCount() const { return m_Count; }
+		uint32_t GetMaxCount() const { return m_MaxCount; }
+
+	private:
+		/** Advance particles in [begin, end) and compute their current size and color. */
+		void UpdateRange(uint32_t begin, uint32_t end, float dt);
+		/** Remove dead particles by swapping in live ones from the back. */
+		void RemoveDeadParticles();
+		void MoveParticle(uint32_t from, uint32_t to);
+		/** Returns a random float in [-0.5, 0.5). */
+		float NextRandom();
+
+	private:
+		uint32_t m_Count = 0;
+		uint32_t m_MaxCount;
+
+		std::vector<float> m_PositionX, m_PositionY;
+		std::vector<float> m_VelocityX, m_VelocityY;
+		/** Remaining lifetime in seconds, particles die when it reaches 0 */
+		std::vector<float> m_Life;
+		std::vector<float> m_InverseLifeTime;
+		std::vector<float> m_SizeBegin, m_SizeEnd;
+		std::vector<glm::vec4> m_ColorBegin, m_ColorEnd;
+
+		/** Written by the update for rendering */
+		std::vector<float> m_Size;
+		std::vector<uint32_t> m_PackedColor;
+
+		uint32_t m_RandomState = 0x9e3779b9;
+	};
+
+}
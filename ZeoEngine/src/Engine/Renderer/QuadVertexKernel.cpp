@@ -0,0 +1,183 @@
+#include "ZEpch.h"
+#include "Engine/Renderer/QuadVertexKernel.h"
+
+#include "Engine/Renderer/VertexPacking.h"
+
+#ifdef ZE_SIMD_SSE
+	#include <immintrin.h>
+#endif // ZE_SIMD_SSE
+
+namespace ZeoEngine {
+
+	// The SSE path treats a vertex as six 32-bit values, StaticBufferLayout already ensures there is no padding
+	static_assert(StaticBufferLayout<QuadVertex>::GetStride() == 6 * sizeof(uint32_t), "Unexpected QuadVertex layout!");
+
+	/** Signs of corner offsets from the quad center, in the order of Renderer2D quad vertices */
+	static const float s_CornerSignsX[4] = { -1.0f,  1.0f, 1.0f, -1.0f };
+	static const float s_CornerSignsY[4] = { -1.0f, -1.0f, 1.0f,  1.0f };
+
+	// Called for single quads as well, so it is not profiled individually
+	void QuadVertexKernel::GenerateVertices(const glm::vec3* positions, const glm::vec2* sizes, const float* rotations, const glm::vec4* colors, uint32_t count,
+		const glm::vec2* texCoords, float textureIndex, float tilingFactor, QuadVertex* outVertices)
+	{
+		// Attributes shared by all quads are packed only once
+		uint32_t packedTexCoords[4];
+		for (uint32_t k = 0; k < 4; ++k)
+		{
+			packedTexCoords[k] = VertexPacking::PackHalf2(texCoords[k]);
+		}
+		const uint16_t packedTextureIndex = VertexPacking::FloatToHalf(textureIndex);
+		const uint16_t packedTilingFactor = VertexPacking::FloatToHalf(tilingFactor);
+
+#ifdef ZE_SIMD_SSE
+		const __m128 signsX = _mm_loadu_ps(s_CornerSignsX);
+		const __m128 signsY = _mm_loadu_ps(s_CornerSignsY);
+		// Last 8 bytes of every vertex: texture coordinate, texture index and tiling factor
+		const int32_t packedTextureParams = static_cast<int32_t>(packedTextureIndex | (static_cast<uint32_t>(packedTilingFactor) << 16));
+		__m128i tails[4];
+		for (uint32_t k = 0; k < 4; ++k)
+		{
+			tails[k] = _mm_setr_epi32(static_cast<int32_t>(packedTexCoords[k]), packedTextureParams, 0, 0);
+		}
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 colorScale = _mm_set1_ps(255.0f);
+		const __m128 half = _mm_set1_ps(0.5f);
+
+		uint32_t* out = reinterpret_cast<uint32_t*>(outVertices);
+		for (uint32_t i = 0; i < count; ++i, out += 4 * 6)
+		{
+			float sine = 0.0f, cosine = 1.0f;
+			if (rotations && rotations[i] != 0.0f)
+			{
+				sine = std::sin(rotations[i]);
+				cosine = std::cos(rotations[i]);
+			}
+			const __m128 s = _mm_set1_ps(sine);
+			const __m128 c = _mm_set1_ps(cosine);
+
+			// All four corners of the quad at once
+			const __m128 offsetX = _mm_mul_ps(_mm_set1_ps(0.5f * sizes[i].x), signsX);
+			const __m128 offsetY = _mm_mul_ps(_mm_set1_ps(0.5f * sizes[i].y), signsY);
+			const __m128 x = _mm_add_ps(_mm_set1_ps(positions[i].x), _mm_sub_ps(_mm_mul_ps(c, offsetX), _mm_mul_ps(s, offsetY)));
+			const __m128 y = _mm_add_ps(_mm_set1_ps(positions[i].y), _mm_add_ps(_mm_mul_ps(s, offsetX), _mm_mul_ps(c, offsetY)));
+
+			// Same rounding as VertexPacking::PackColor(): clamp, scale, add one half and truncate
+			const __m128 color = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(&colors[i].x), zero), one);
+			const __m128i color32 = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(color, colorScale), half));
+			const __m128i color16 = _mm_packs_epi32(color32, color32);
+			const __m128 packedColor = _mm_castsi128_ps(_mm_packus_epi16(color16, color16));
+
+			// Interleave into (x, y, z, color) for every corner
+			const __m128 xy01 = _mm_unpacklo_ps(x, y);
+			const __m128 xy23 = _mm_unpackhi_ps(x, y);
+			const __m128 zc = _mm_unpacklo_ps(_mm_set1_ps(positions[i].z), packedColor);
+			const __m128 zczc = _mm_movelh_ps(zc, zc);
+			const __m128 heads[4] = {
+				_mm_movelh_ps(xy01, zc),
+				_mm_movehl_ps(zczc, xy01),
+				_mm_movelh_ps(xy23, zc),
+				_mm_movehl_ps(zczc, xy23),
+			};
+
+			for (uint32_t k = 0; k < 4; ++k)
+			{
+				uint32_t* vertex = out + k * 6;
+				_mm_storeu_ps(reinterpret_cast<float*>(vertex), heads[k]);
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(vertex + 4), tails[k]);
+			}
+		}
+#else
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			float sine = 0.0f, cosine = 1.0f;
+			if (rotations && rotations[i] != 0.0f)
+			{
+				sine = std::sin(rotations[i]);
+				cosine = std::cos(rotations[i]);
+			}
+			const uint32_t packedColor = VertexPacking::PackColor(colors[i]);
+
+			for (uint32_t k = 0; k < 4; ++k)
+			{
+				const float offsetX = 0.5f * sizes[i].x * s_CornerSignsX[k];
+				const float offsetY = 0.5f * sizes[i].y * s_CornerSignsY[k];
+				QuadVertex& vertex = outVertices[i * 4 + k];
+				vertex.Position = { positions[i].x + cosine * offsetX - sine * offsetY, positions[i].y + sine * offsetX + cosine * offsetY, positions[i].z };
+				vertex.Color = packedColor;
+				vertex.TexCoord = packedTexCoords[k];
+				vertex.TexIndex = packedTextureIndex;
+				vertex.TilingFactor = packedTilingFactor;
+			}
+		}
+#endif // ZE_SIMD_SSE
+	}
+
+	// Called from worker threads for ranges of particles, so it is not profiled individually
+	void QuadVertexKernel::GenerateSquareVertices(const float* positionX, const float* positionY, const float* sizes, const uint32_t* packedColors, uint32_t count, float z,
+		const glm::vec2* texCoords, float textureIndex, float tilingFactor, QuadVertex* outVertices)
+	{
+		uint32_t packedTexCoords[4];
+		for (uint32_t k = 0; k < 4; ++k)
+		{
+			packedTexCoords[k] = VertexPacking::PackHalf2(texCoords[k]);
+		}
+		const uint16_t packedTextureIndex = VertexPacking::FloatToHalf(textureIndex);
+		const uint16_t packedTilingFactor = VertexPacking::FloatToHalf(tilingFactor);
+
+		uint32_t i = 0;
+#ifdef ZE_SIMD_SSE
+		const int32_t packedTextureParams = static_cast<int32_t>(packedTextureIndex | (static_cast<uint32_t>(packedTilingFactor) << 16));
+		__m128i tails[4];
+		for (uint32_t k = 0; k < 4; ++k)
+		{
+			tails[k] = _mm_setr_epi32(static_cast<int32_t>(packedTexCoords[k]), packedTextureParams, 0, 0);
+		}
+		const __m128 depth = _mm_set1_ps(z);
+		const __m128 half = _mm_set1_ps(0.5f);
+
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128 x = _mm_loadu_ps(positionX + i);
+			const __m128 y = _mm_loadu_ps(positionY + i);
+			const __m128 halfSize = _mm_mul_ps(_mm_loadu_ps(sizes + i), half);
+			const __m128 minX = _mm_sub_ps(x, halfSize);
+			const __m128 maxX = _mm_add_ps(x, halfSize);
+			const __m128 minY = _mm_sub_ps(y, halfSize);
+			const __m128 maxY = _mm_add_ps(y, halfSize);
+			const __m128 colors = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(packedColors + i)));
+
+			const __m128 cornersX[4] = { minX, maxX, maxX, minX };
+			const __m128 cornersY[4] = { minY, minY, maxY, maxY };
+			uint32_t* out = reinterpret_cast<uint32_t*>(outVertices + i * 4);
+			for (uint32_t k = 0; k < 4; ++k)
+			{
+				// Turn (x, y, z, color) of four squares into (x, y, z, color) of corner k of each square
+				__m128 head0 = cornersX[k], head1 = cornersY[k], head2 = depth, head3 = colors;
+				_MM_TRANSPOSE4_PS(head0, head1, head2, head3);
+				const __m128 heads[4] = { head0, head1, head2, head3 };
+				for (uint32_t j = 0; j < 4; ++j)
+				{
+					uint32_t* vertex = out + (j * 4 + k) * 6;
+					_mm_storeu_ps(reinterpret_cast<float*>(vertex), heads[j]);
+					_mm_storel_epi64(reinterpret_cast<__m128i*>(vertex + 4), tails[k]);
+				}
+			}
+		}
+#endif // ZE_SIMD_SSE
+		for (; i < count; ++i)
+		{
+			const float halfSize = 0.5f * sizes[i];
+			for (uint32_t k = 0; k < 4; ++k)
+			{
+				QuadVertex& vertex = outVertices[i * 4 + k];
+				vertex.Position = { positionX[i] + halfSize * s_CornerSignsX[k], positionY[i] + halfSize * s_CornerSignsY[k], z };
+				vertex.Color = packedColors[i];
+				vertex.TexCoord = packedTexCoords[k];
+				vertex.TexIndex = packedTextureIndex;
+				vertex.TilingFactor = packedTilingFactor;
+			}
+		}
+	}
+
+}
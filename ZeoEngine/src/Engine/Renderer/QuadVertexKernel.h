@@ -0,0 +1,56 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "Engine/Renderer/Buffer.h"
+
+namespace ZeoEngine {
+
+	/** 24 bytes instead of 44 with all attributes as floats, see VertexPacking. */
+	struct QuadVertex
+	{
+		glm::vec3 Position;
+		/** Normalized RGBA8 */
+		uint32_t Color;
+		/** Two halves */
+		uint32_t TexCoord;
+		/** Halves */
+		uint16_t TexIndex;
+		uint16_t TilingFactor;
+	};
+
+	template<>
+	struct VertexLayout<QuadVertex>
+	{
+		static constexpr BufferElement Elements[] = {
+			ZE_VERTEX_ELEMENT(QuadVertex, Position, Float3, "a_Position", false),
+			ZE_VERTEX_ELEMENT(QuadVertex, Color, UByte4, "a_Color", true),
+			ZE_VERTEX_ELEMENT(QuadVertex, TexCoord, Half2, "a_TexCoord", false),
+			ZE_VERTEX_ELEMENT(QuadVertex, TexIndex, Half, "a_TexIndex", false),
+			ZE_VERTEX_ELEMENT(QuadVertex, TilingFactor, Half, "a_TilingFactor", false),
+		};
+	};
+
+	class QuadVertexKernel
+	{
+	public:
+		/**
+		 * Write four vertices for each quad centered at positions[i] directly into outVertices, in the same corner order as the quad index buffer.
+		 * Corners are rotated around the center with sine and cosine computed once per quad instead of going through a 4x4 matrix.
+		 * Rotations are in radians and may be null if no quad is rotated. Texture coordinates of the four corners are shared by all quads.
+		 * Colors, texture coordinates, texture index and tiling factor are packed into the compact formats of QuadVertex.
+		 * Uses SSE if available and a scalar path otherwise.
+		 */
+		static void GenerateVertices(const glm::vec3* positions, const glm::vec2* sizes, const float* rotations, const glm::vec4* colors, uint32_t count,
+			const glm::vec2* texCoords, float textureIndex, float tilingFactor, QuadVertex* outVertices);
+
+		/**
+		 * Write four vertices for each axis-aligned square given as SoA arrays of centers and side lengths, all squares lying at depth z.
+		 * Colors are already packed as RGBA8, e.g. by a particle update which writes them once per frame.
+		 * Uses SSE for four squares at a time if available and a scalar path for the rest.
+		 */
+		static void GenerateSquareVertices(const float* positionX, const float* positionY, const float* sizes, const uint32_t* packedColors, uint32_t count, float z,
+			const glm::vec2* texCoords, float textureIndex, float tilingFactor, QuadVertex* outVertices);
+	};
+
+}
@@ -22,16 +22,61 @@ namespace ZeoEngine {
 			s_RendererAPI->SetClearColor(color);
 		}
 
+		inline static void SetBlendEnabled(bool bEnabled)
+		{
+			s_RendererAPI->SetBlendEnabled(bEnabled);
+		}
+
+		inline static void SetDepthTestEnabled(bool bEnabled)
+		{
+			s_RendererAPI->SetDepthTestEnabled(bEnabled);
+		}
+
+		inline static void SetDepthWriteEnabled(bool bEnabled)
+		{
+			s_RendererAPI->SetDepthWriteEnabled(bEnabled);
+		}
+
+		inline static void SetLineWidth(float width)
+		{
+			s_RendererAPI->SetLineWidth(width);
+		}
+
 		/** Call this before any rendering calls! */
 		inline static void Clear()
 		{
 			s_RendererAPI->Clear();
 		}
 
-		/** Issue a draw call. */
-		inline static void DrawIndexed(const Ref<VertexArray>& vertexArray)
+		/** Issue a draw call. If indexCount is 0, the whole index buffer will be drawn. See RendererAPI::DrawIndexed() for baseVertex. */
+		inline static void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0, uint32_t baseVertex = 0)
+		{
+			s_RendererAPI->DrawIndexed(vertexArray, indexCount, baseVertex);
+		}
+
+		inline static void DrawLines(const Ref<VertexArray>& vertexArray, uint32_t vertexCount)
+		{
+			s_RendererAPI->DrawLines(vertexArray, vertexCount);
+		}
+
+		inline static uint32_t GetUniformBufferOffsetAlignment()
+		{
+			return s_RendererAPI->GetUniformBufferOffsetAlignment();
+		}
+
+		inline static uint32_t GetMaxTextureSlots()
+		{
+			return s_RendererAPI->GetMaxTextureSlots();
+		}
+
+		inline static RendererAPI::StateStatistics GetStateStats()
+		{
+			return s_RendererAPI->GetStateStats();
+		}
+
+		inline static void ResetStateStats()
 		{
-			s_RendererAPI->DrawIndexed(vertexArray);
+			s_RendererAPI->ResetStateStats();
 		}
 
 	private:
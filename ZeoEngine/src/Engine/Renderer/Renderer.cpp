@@ -2,6 +2,7 @@
 #include "Engine/Renderer/Renderer.h"
 
 #include "Engine/Renderer/Renderer2D.h"
+#include "Engine/Renderer/HotReloader.h"
 
 namespace ZeoEngine {
 
@@ -10,14 +11,47 @@ namespace ZeoEngine {
 	void Renderer::Init()
 	{
 		ZE_PROFILE_FUNCTION();
+		ZE_MEMORY_TAG(Renderer);
 
 		RenderCommand::Init();
+		s_SceneData->CameraUniformBuffer = UniformBuffer::Create(sizeof(CameraData), UniformBufferBinding::Camera);
+		s_SceneData->DrawUniformRing = CreateScope<UniformBufferRing>(s_SceneData->DrawUniformRingSize);
+		CreateQuadIndexBuffer();
+		HotReloader::Init();
 		Renderer2D::Init();
 	}
 
 	void Renderer::Shutdown()
 	{
 		Renderer2D::Shutdown();
+		HotReloader::Shutdown();
+		// Release GPU resources before the context is gone
+		s_SceneData->CameraUniformBuffer.reset();
+		s_SceneData->DrawUniformRing.reset();
+		s_SceneData->QuadIndexBuffer.reset();
+	}
+
+	void Renderer::CreateQuadIndexBuffer()
+	{
+		ZE_PROFILE_FUNCTION();
+
+		// Indices never change between frames so they are generated only once
+		const uint32_t indexCount = MaxQuadsPerIndexBuffer * 6;
+		std::vector<uint16_t> quadIndices(indexCount);
+		uint32_t offset = 0;
+		for (uint32_t i = 0; i < indexCount; i += 6)
+		{
+			quadIndices[i + 0] = static_cast<uint16_t>(offset + 0);
+			quadIndices[i + 1] = static_cast<uint16_t>(offset + 1);
+			quadIndices[i + 2] = static_cast<uint16_t>(offset + 2);
+
+			quadIndices[i + 3] = static_cast<uint16_t>(offset + 2);
+			quadIndices[i + 4] = static_cast<uint16_t>(offset + 3);
+			quadIndices[i + 5] = static_cast<uint16_t>(offset + 0);
+
+			offset += 4;
+		}
+		s_SceneData->QuadIndexBuffer = IndexBuffer::Create(quadIndices.data(), indexCount);
 	}
 
 	void Renderer::OnWindowResize(uint32_t width, uint32_t height)
@@ -25,9 +59,19 @@ namespace ZeoEngine {
 		RenderCommand::SetViewport(0, 0, width, height);
 	}
 
-	void Renderer::BeginScene(OrthographicCamera& camera)
+	void Renderer::BeginScene(const OrthographicCamera& camera)
 	{
-		s_SceneData->ViewProjectionMatrix = camera.GetViewProjectionMatrix();
+		ZE_PROFILE_FUNCTION();
+		ZE_MEMORY_TAG(Renderer);
+
+		// Both 3D and 2D scenes usually share one camera, so skip uploading the same data twice
+		const glm::mat4& viewProjection = camera.GetViewProjectionMatrix();
+		if (s_SceneData->bCameraUploaded && s_SceneData->Camera.ViewProjection == viewProjection)
+			return;
+
+		s_SceneData->Camera.ViewProjection = viewProjection;
+		s_SceneData->CameraUniformBuffer->SetData(&s_SceneData->Camera, sizeof(CameraData));
+		s_SceneData->bCameraUploaded = true;
 	}
 
 	void Renderer::EndScene()
@@ -35,14 +79,19 @@ namespace ZeoEngine {
 
 	}
 
-	void Renderer::Submit(const Ref<Shader> shader, const Ref<VertexArray>& vertexArray, const glm::mat4& transform)
+	void Renderer::Submit(const Ref<Shader> shader, const Ref<VertexArray>& vertexArray, const glm::mat4& transform, const UniformBlock* material, uint32_t indexCount)
 	{
+		ZE_MEMORY_TAG(Renderer);
+
 		shader->Bind();
-		shader->SetMat4("u_ViewProjection", s_SceneData->ViewProjectionMatrix);
-		shader->SetMat4("u_Transform", transform);
+		s_SceneData->DrawUniformRing->Push(UniformBufferBinding::Draw, &transform, sizeof(glm::mat4));
+		if (material)
+		{
+			s_SceneData->DrawUniformRing->Push(UniformBufferBinding::Material, material->GetData(), material->GetSize());
+		}
 
 		vertexArray->Bind();
-		RenderCommand::DrawIndexed(vertexArray);
+		RenderCommand::DrawIndexed(vertexArray, indexCount);
 	}
 
 }
@@ -3,6 +3,7 @@
 #include "Engine/Renderer/RenderCommand.h"
 #include "Engine/Renderer/OrthographicCamera.h"
 #include "Engine/Renderer/Shader.h"
+#include "Engine/Renderer/UniformBuffer.h"
 
 namespace ZeoEngine {
 
@@ -14,19 +15,47 @@ namespace ZeoEngine {
 
 		static void OnWindowResize(uint32_t width, uint32_t height);
 
-		static void BeginScene(OrthographicCamera& camera);
+		/** Upload camera data to the shared camera uniform buffer, which is read by all shaders. */
+		static void BeginScene(const OrthographicCamera& camera);
 		static void EndScene();
 
-		static void Submit(const Ref<Shader> shader, const Ref<VertexArray>& vertexArray, const glm::mat4& transform = glm::mat4(1.0f));
+		/**
+		 * Draw a vertex array. Transform and optional material parameters are pushed into per-draw uniform blocks.
+		 * If indexCount is 0, the whole index buffer will be drawn.
+		 */
+		static void Submit(const Ref<Shader> shader, const Ref<VertexArray>& vertexArray, const glm::mat4& transform = glm::mat4(1.0f), const UniformBlock* material = nullptr, uint32_t indexCount = 0);
 
 		inline static RendererAPI::API GetAPI() { return RendererAPI::GetAPI(); }
 
+		/** Quads a single draw can take from the shared quad index buffer, the limit of 16-bit indices */
+		static const uint32_t MaxQuadsPerIndexBuffer = 65536 / 4;
+		/**
+		 * 16-bit index buffer shared by all batch renderers, describing two triangles for each group of four vertices.
+		 * Draw more than MaxQuadsPerIndexBuffer quads in slices by passing the first vertex of each slice as base vertex.
+		 */
+		static const Ref<IndexBuffer>& GetQuadIndexBuffer() { return s_SceneData->QuadIndexBuffer; }
+
 	private:
+		/** Matches the Camera block in assets/shaders/include/Camera.glsl */
+		struct CameraData
+		{
+			glm::mat4 ViewProjection;
+		};
+
 		struct SceneData
 		{
-			glm::mat4 ViewProjectionMatrix;
+			CameraData Camera;
+			bool bCameraUploaded = false;
+
+			static const uint32_t DrawUniformRingSize = 256 * 1024;
+
+			Ref<UniformBuffer> CameraUniformBuffer;
+			Scope<UniformBufferRing> DrawUniformRing;
+			Ref<IndexBuffer> QuadIndexBuffer;
 		};
 
+		static void CreateQuadIndexBuffer();
+
 		static Scope<SceneData> s_SceneData;
 
 	};
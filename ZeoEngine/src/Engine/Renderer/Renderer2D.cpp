@@ -4,81 +4,763 @@
 #include "Engine/Renderer/VertexArray.h"
 #include "Engine/Renderer/Shader.h"
 #include "Engine/Renderer/RenderCommand.h"
-
-#include <glm/gtc/matrix_transform.hpp>
+#include "Engine/Renderer/Renderer.h"
+#include "Engine/Renderer/QuadVertexKernel.h"
+#include "Engine/Renderer/VertexPacking.h"
+#include "Engine/Core/RadixSort.h"
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Core/FrameAllocator.h"
 
 namespace ZeoEngine {
 
-	struct Renderer2DStorage
+	struct CircleVertex
+	{
+		glm::vec3 WorldPosition;
+		/** Normalized RGBA8 */
+		uint32_t Color;
+		/** Two halves, corner of the quad in [-1, 1] */
+		uint32_t LocalPosition;
+		/** Halves, relative to the radius */
+		uint16_t Thickness;
+		uint16_t Fade;
+	};
+
+	template<>
+	struct VertexLayout<CircleVertex>
+	{
+		static constexpr BufferElement Elements[] = {
+			ZE_VERTEX_ELEMENT(CircleVertex, WorldPosition, Float3, "a_WorldPosition", false),
+			ZE_VERTEX_ELEMENT(CircleVertex, Color, UByte4, "a_Color", true),
+			ZE_VERTEX_ELEMENT(CircleVertex, LocalPosition, Half2, "a_LocalPosition", false),
+			ZE_VERTEX_ELEMENT(CircleVertex, Thickness, Half, "a_Thickness", false),
+			ZE_VERTEX_ELEMENT(CircleVertex, Fade, Half, "a_Fade", false),
+		};
+	};
+
+	struct LineVertex
 	{
+		glm::vec3 Position;
+		/** Normalized RGBA8 */
+		uint32_t Color;
+	};
+
+	template<>
+	struct VertexLayout<LineVertex>
+	{
+		static constexpr BufferElement Elements[] = {
+			ZE_VERTEX_ELEMENT(LineVertex, Position, Float3, "a_Position", false),
+			ZE_VERTEX_ELEMENT(LineVertex, Color, UByte4, "a_Color", true),
+		};
+	};
+
+	/** Shader a staged quad is drawn with, all of them read QuadVertex */
+	enum class QuadShader : uint8_t
+	{
+		Texture,
+		/** Glyphs sampled from a signed distance field atlas */
+		Text,
+	};
+
+	/**
+	 * Quads of one pass, staged until the end of the scene so that they can be sorted by depth.
+	 * Staging memory comes from FrameAllocator, it is only allocated once a quad is added and released by Clear() when the scene ends.
+	 */
+	struct QuadPass
+	{
+		FrameVector<QuadVertex> Vertices;
+		/** Scene texture id of each quad, see Renderer2D::GetTextureId() */
+		FrameVector<uint32_t> TextureIds;
+		FrameVector<QuadShader> Shaders;
+		/** Sort key of each quad, ascending keys are drawn first */
+		FrameVector<uint32_t> DepthKeys;
+		/** Opaque quads are drawn front to back so that hidden pixels fail the depth test early, translucent ones back to front with blending */
+		bool bTranslucent = false;
+		/** Quads staged by last scene, reserved up front so that the vectors rarely grow and leave their old buffers in the arena */
+		uint32_t LastQuadCount = 0;
+
+		uint32_t GetQuadCount() const { return static_cast<uint32_t>(TextureIds.size()); }
+
+		void Reserve(size_t quadCount)
+		{
+			if (quadCount <= TextureIds.capacity())
+				return;
+
+			// Grow geometrically as the vectors themselves would, but start from the size of last scene
+			quadCount = std::max({ quadCount, TextureIds.capacity() * 2, static_cast<size_t>(LastQuadCount) });
+			Vertices.reserve(quadCount * 4);
+			TextureIds.reserve(quadCount);
+			Shaders.reserve(quadCount);
+			DepthKeys.reserve(quadCount);
+		}
+
+		/** Append quads sharing a texture and return their vertices to be filled in. */
+		QuadVertex* AddQuads(uint32_t count, uint32_t textureId, const glm::vec3* positions)
+		{
+			const size_t quadOffset = TextureIds.size();
+			Reserve(quadOffset + count);
+			Vertices.resize((quadOffset + count) * 4);
+			TextureIds.resize(quadOffset + count, textureId);
+			Shaders.resize(quadOffset + count, QuadShader::Texture);
+			DepthKeys.resize(quadOffset + count);
+			// Larger z is closer to the camera
+			const uint32_t keyMask = bTranslucent ? 0u : ~0u;
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				DepthKeys[quadOffset + i] = RadixSort::FloatToKey(positions[i].z) ^ keyMask;
+			}
+			return Vertices.data() + quadOffset * 4;
+		}
+
+		/** Append quads sharing a texture and depth, e.g. glyphs of a string. */
+		QuadVertex* AddQuads(uint32_t count, uint32_t textureId, float z, QuadShader shader = QuadShader::Texture)
+		{
+			const size_t quadOffset = TextureIds.size();
+			Reserve(quadOffset + count);
+			Vertices.resize((quadOffset + count) * 4);
+			TextureIds.resize(quadOffset + count, textureId);
+			Shaders.resize(quadOffset + count, shader);
+			DepthKeys.resize(quadOffset + count, RadixSort::FloatToKey(z) ^ (bTranslucent ? 0u : ~0u));
+			return Vertices.data() + quadOffset * 4;
+		}
+
+		/** Drop the staged quads together with their memory, which is invalidated by next FrameAllocator::Reset(). */
+		void Clear()
+		{
+			LastQuadCount = GetQuadCount();
+			Vertices = FrameVector<QuadVertex>();
+			TextureIds = FrameVector<uint32_t>();
+			Shaders = FrameVector<QuadShader>();
+			DepthKeys = FrameVector<uint32_t>();
+		}
+	};
+
+	/** Tilemap staged until the end of the scene, drawn chunk by chunk from its own vertex buffers */
+	struct TilemapDraw
+	{
+		Tilemap* Map;
+		glm::mat4 Transform;
+		glm::vec4 TintColor;
+	};
+
+	struct Renderer2DData
+	{
+		static const uint32_t MaxQuads = 10000;
+		static const uint32_t MaxVertices = MaxQuads * 4;
+		static const uint32_t MaxIndices = MaxQuads * 6;
+		/** Capacity of the slot arrays, the slots actually used are limited further by what the driver supports */
+		static const uint32_t MaxTextureSlotCapacity = 32;
+		static const uint32_t NoTextureSlot = ~0u;
+		static const uint32_t MaxLines = 20000;
+		static const uint32_t MaxLineVertices = MaxLines * 2;
+
 		Ref<VertexArray> QuadVAO;
+		Ref<VertexBuffer> QuadVBO;
 		Ref<Shader> TextureShader;
-		Ref<Texture> WhiteTexture;
+		Ref<Shader> TextShader;
+		Ref<Texture2D> WhiteTexture;
+
+		Ref<VertexArray> CircleVAO;
+		Ref<VertexBuffer> CircleVBO;
+		Ref<Shader> CircleShader;
+
+		Ref<VertexArray> LineVAO;
+		Ref<VertexBuffer> LineVBO;
+		Ref<Shader> LineShader;
+		float LineWidth = 1.0f;
+
+		Ref<Shader> TilemapShader;
+		UniformBlock TilemapMaterial;
+		/** Opaque tilemaps are drawn with opaque quads, translucent ones after them without writing depth */
+		FrameVector<TilemapDraw> OpaqueTilemaps;
+		FrameVector<TilemapDraw> TranslucentTilemaps;
+
+		/** Circles and lines are staged like quads but drawn after them in submission order */
+		FrameVector<CircleVertex> CircleVertices;
+		FrameVector<LineVertex> LineVertices;
+		uint32_t PackedCircleLocalPositions[4];
+
+		QuadPass OpaquePass;
+		/** Glyphs are always blended, so they are sorted among translucent quads */
+		QuadPass TranslucentPass;
+
+		/** Textures used by staged quads indexed by scene texture id, id 0 is the white texture */
+		std::vector<Ref<Texture2D>> SceneTextures;
+		std::vector<bool> SceneTextureTranslucency;
+		/** Slot of each scene texture in current batch */
+		std::vector<uint32_t> SceneTextureSlots;
+		std::unordered_map<const Texture2D*, uint32_t> SceneTextureIds;
+
+		uint32_t BatchQuadCount = 0;
+		QuadVertex* QuadVertexBufferBase = nullptr;
+
+		std::array<Ref<Texture2D>, MaxTextureSlotCapacity> TextureSlots;
+		std::array<uint32_t, MaxTextureSlotCapacity> TextureSlotIds;
+		/** Texture slots the fragment shader can sample from, queried from RendererAPI on init */
+		uint32_t MaxTextureSlots = 16;
+		/** Slot 0 is reserved for white texture */
+		uint32_t TextureSlotIndex = 1;
+		/** Slot indices as stored in QuadVertex::TexIndex */
+		std::array<uint16_t, MaxTextureSlotCapacity> PackedTextureSlots;
+		uint16_t PackedUnitTilingFactor = 0;
+
+		glm::vec4 QuadVertexPositions[4];
+		glm::vec2 QuadTexCoords[4];
+
+		/** World-space bounds of the view of current scene */
+		Bounds2D ViewBounds;
+
+		Renderer2D::Statistics Stats;
 	};
 
-	static Renderer2DStorage* s_Data;
+	static Renderer2DData s_Data;
+
+	// Batches are drawn with the shared 16-bit quad index buffer
+	static_assert(Renderer2DData::MaxQuads <= Renderer::MaxQuadsPerIndexBuffer, "Renderer2D batch is too large for the quad index buffer!");
 
 	void Renderer2D::Init()
 	{
 		ZE_PROFILE_FUNCTION();
 
-		s_Data = new Renderer2DStorage();
+		s_Data.QuadVAO = VertexArray::Create();
 
-		s_Data->QuadVAO = VertexArray::Create();
+		s_Data.QuadVBO = VertexBuffer::Create(s_Data.MaxVertices * sizeof(QuadVertex));
+		s_Data.QuadVBO->SetLayout(StaticBufferLayout<QuadVertex>());
+		s_Data.QuadVAO->AddVertexBuffer(s_Data.QuadVBO);
 
-		float squareVertices[] = {
-			-0.5f, -0.5f, 0.0f, 0.0f, 0.0f,
-			 0.5f, -0.5f, 0.0f, 1.0f, 0.0f,
-			 0.5f,  0.5f, 0.0f, 1.0f, 1.0f,
-			-0.5f,  0.5f, 0.0f, 0.0f, 1.0f
-		};
-
-		Ref<VertexBuffer> squareVBO = VertexBuffer::Create(squareVertices, sizeof(squareVertices));
+		s_Data.QuadVertexBufferBase = new QuadVertex[s_Data.MaxVertices];
 
-		BufferLayout squareLayout = {
-			{ ShaderDataType::Float3, "a_Position" },
-			{ ShaderDataType::Float2, "a_TexCoord" },
-		};
-		squareVBO->SetLayout(squareLayout);
-		s_Data->QuadVAO->AddVertexBuffer(squareVBO);
+		s_Data.QuadVAO->SetIndexBuffer(Renderer::GetQuadIndexBuffer());
 
-		uint32_t squareIndices[] = {
-			0, 1, 2,
-			2, 3, 0
-		};
+		s_Data.CircleVAO = VertexArray::Create();
+		s_Data.CircleVBO = VertexBuffer::Create(s_Data.MaxVertices * sizeof(CircleVertex));
+		s_Data.CircleVBO->SetLayout(StaticBufferLayout<CircleVertex>());
+		s_Data.CircleVAO->AddVertexBuffer(s_Data.CircleVBO);
+		s_Data.CircleVAO->SetIndexBuffer(Renderer::GetQuadIndexBuffer());
 
-		Ref<IndexBuffer> squareIBO = IndexBuffer::Create(squareIndices, sizeof(squareIndices) / sizeof(uint32_t));
-		s_Data->QuadVAO->SetIndexBuffer(squareIBO);
+		s_Data.LineVAO = VertexArray::Create();
+		s_Data.LineVBO = VertexBuffer::Create(s_Data.MaxLineVertices * sizeof(LineVertex));
+		s_Data.LineVBO->SetLayout(StaticBufferLayout<LineVertex>());
+		s_Data.LineVAO->AddVertexBuffer(s_Data.LineVBO);
 
 		// Generate a 1x1 white texture to be used by flat color
-		s_Data->WhiteTexture = Texture2D::Create(1, 1);
+		s_Data.WhiteTexture = Texture2D::Create(1, 1);
 		uint32_t whiteTextureData = 0xffffffff;
-		s_Data->WhiteTexture->SetData(&whiteTextureData, sizeof(uint32_t));
+		s_Data.WhiteTexture->SetData(&whiteTextureData, sizeof(uint32_t));
+
+		s_Data.MaxTextureSlots = std::min(RenderCommand::GetMaxTextureSlots(), static_cast<uint32_t>(Renderer2DData::MaxTextureSlotCapacity));
+		ZE_CORE_ASSERT(s_Data.MaxTextureSlots >= 2, "Renderer2D needs at least one texture slot besides the white texture!");
+		// Size of the sampler array in shaders has to match the number of texture slots we use
+		ShaderPreprocessor::SetGlobalDefine("ZE_MAX_TEXTURE_SLOTS", std::to_string(s_Data.MaxTextureSlots));
+		s_Data.TextureShader = Shader::Create("assets/shaders/Texture.glsl");
+		s_Data.CircleShader = Shader::Create("assets/shaders/Circle.glsl");
+		s_Data.TextShader = Shader::Create("assets/shaders/Text.glsl");
+		s_Data.LineShader = Shader::Create("assets/shaders/Line.glsl");
+		s_Data.TilemapShader = Shader::Create("assets/shaders/Tilemap.glsl");
+		s_Data.TilemapMaterial = UniformBlock({
+			{ ShaderDataType::Float4, "u_TintColor" }
+		});
+
+		s_Data.TextureSlots[0] = s_Data.WhiteTexture;
+		s_Data.TextureSlotIds[0] = 0;
+		for (uint32_t i = 0; i < s_Data.MaxTextureSlots; ++i)
+		{
+			s_Data.PackedTextureSlots[i] = VertexPacking::FloatToHalf(static_cast<float>(i));
+		}
+		s_Data.PackedUnitTilingFactor = VertexPacking::FloatToHalf(1.0f);
+
+		// The white texture always occupies slot 0
+		s_Data.SceneTextures.push_back(s_Data.WhiteTexture);
+		s_Data.SceneTextureTranslucency.push_back(false);
+		s_Data.SceneTextureSlots.push_back(0);
 
-		s_Data->TextureShader = Shader::Create("assets/shaders/Texture.glsl");
-		// TextureShader is bound here!
-		s_Data->TextureShader->Bind();
-		s_Data->TextureShader->SetInt("u_Texture", 0);
+		s_Data.OpaquePass.bTranslucent = false;
+		s_Data.TranslucentPass.bTranslucent = true;
+
+		s_Data.QuadVertexPositions[0] = { -0.5f, -0.5f, 0.0f, 1.0f };
+		s_Data.QuadVertexPositions[1] = {  0.5f, -0.5f, 0.0f, 1.0f };
+		s_Data.QuadVertexPositions[2] = {  0.5f,  0.5f, 0.0f, 1.0f };
+		s_Data.QuadVertexPositions[3] = { -0.5f,  0.5f, 0.0f, 1.0f };
+
+		s_Data.QuadTexCoords[0] = { 0.0f, 0.0f };
+		s_Data.QuadTexCoords[1] = { 1.0f, 0.0f };
+		s_Data.QuadTexCoords[2] = { 1.0f, 1.0f };
+		s_Data.QuadTexCoords[3] = { 0.0f, 1.0f };
+
+		for (uint32_t i = 0; i < 4; ++i)
+		{
+			s_Data.PackedCircleLocalPositions[i] = VertexPacking::PackHalf2(2.0f * glm::vec2(s_Data.QuadVertexPositions[i]));
+		}
 	}
 
 	void Renderer2D::Shutdown()
 	{
 		ZE_PROFILE_FUNCTION();
 
-		delete s_Data;
+		delete[] s_Data.QuadVertexBufferBase;
+		// Release GPU resources before the context is gone
+		s_Data = Renderer2DData();
 	}
 
 	void Renderer2D::BeginScene(const OrthographicCamera& camera)
 	{
 		ZE_PROFILE_FUNCTION();
+		ZE_MEMORY_TAG(Renderer);
+
+		Renderer::BeginScene(camera);
 
-		s_Data->TextureShader->SetMat4("u_ViewProjection", camera.GetViewProjectionMatrix());
+		s_Data.ViewBounds = Culling2D::ComputeViewBounds(camera.GetViewProjectionMatrix());
 	}
 
 	void Renderer2D::EndScene()
 	{
 		ZE_PROFILE_FUNCTION();
 
+		Flush();
+	}
+
+	/** Draw quads gathered in current batch and start a new one. */
+	static void DrawBatch(const Ref<Shader>& shader)
+	{
+		if (s_Data.BatchQuadCount == 0)
+			return;
+
+		s_Data.QuadVBO->SetData(s_Data.QuadVertexBufferBase, s_Data.BatchQuadCount * 4 * sizeof(QuadVertex));
+
+		shader->Bind();
+
+		// Bind textures
+		for (uint32_t i = 0; i < s_Data.TextureSlotIndex; ++i)
+		{
+			s_Data.TextureSlots[i]->Bind(i);
+		}
+
+		s_Data.QuadVAO->Bind();
+		RenderCommand::DrawIndexed(s_Data.QuadVAO, s_Data.BatchQuadCount * 6);
+		++s_Data.Stats.DrawCalls;
+
+		for (uint32_t i = 1; i < s_Data.TextureSlotIndex; ++i)
+		{
+			s_Data.SceneTextureSlots[s_Data.TextureSlotIds[i]] = Renderer2DData::NoTextureSlot;
+		}
+		s_Data.TextureSlotIndex = 1;
+		s_Data.BatchQuadCount = 0;
+	}
+
+	static const Ref<Shader>& GetQuadShader(QuadShader shader)
+	{
+		return shader == QuadShader::Text ? s_Data.TextShader : s_Data.TextureShader;
+	}
+
+	/** Sort quads of the pass by depth and draw them in as few batches as texture slots and shader changes allow. */
+	static void DrawPass(const QuadPass& pass)
+	{
+		const uint32_t quadCount = pass.GetQuadCount();
+		if (quadCount == 0)
+			return;
+
+		uint32_t* sortedQuads = FrameAllocator::NewArray<uint32_t>(quadCount);
+		uint32_t* sortScratch = FrameAllocator::NewArray<uint32_t>(quadCount * 3);
+		RadixSort::SortIndices(pass.DepthKeys.data(), quadCount, sortedQuads, sortScratch);
+
+		RenderCommand::SetBlendEnabled(pass.bTranslucent);
+		// Translucent quads must not hide those behind them which are drawn later
+		RenderCommand::SetDepthWriteEnabled(!pass.bTranslucent);
+
+		QuadShader batchShader = pass.Shaders[sortedQuads[0]];
+		for (uint32_t i = 0; i < quadCount;)
+		{
+			const uint32_t quad = sortedQuads[i];
+			const uint32_t textureId = pass.TextureIds[quad];
+			const QuadShader shader = pass.Shaders[quad];
+			if (shader != batchShader)
+			{
+				DrawBatch(GetQuadShader(batchShader));
+				batchShader = shader;
+			}
+
+			uint32_t slot = s_Data.SceneTextureSlots[textureId];
+			if (slot == Renderer2DData::NoTextureSlot)
+			{
+				// All texture slots are occupied, start a new batch
+				if (s_Data.TextureSlotIndex >= s_Data.MaxTextureSlots)
+				{
+					DrawBatch(GetQuadShader(batchShader));
+				}
+
+				slot = s_Data.TextureSlotIndex++;
+				s_Data.TextureSlots[slot] = s_Data.SceneTextures[textureId];
+				s_Data.TextureSlotIds[slot] = textureId;
+				s_Data.SceneTextureSlots[textureId] = slot;
+			}
+
+			// Quads which follow each other both in the pass and in draw order are copied together, e.g. particles sharing a depth
+			const uint32_t maxRunLength = std::min(quadCount - i, Renderer2DData::MaxQuads - s_Data.BatchQuadCount);
+			uint32_t runLength = 1;
+			while (runLength < maxRunLength && sortedQuads[i + runLength] == quad + runLength &&
+				pass.TextureIds[quad + runLength] == textureId && pass.Shaders[quad + runLength] == shader)
+			{
+				++runLength;
+			}
+
+			QuadVertex* vertices = s_Data.QuadVertexBufferBase + s_Data.BatchQuadCount * 4;
+			memcpy(vertices, pass.Vertices.data() + quad * 4, runLength * 4 * sizeof(QuadVertex));
+			const uint16_t packedSlot = s_Data.PackedTextureSlots[slot];
+			for (uint32_t k = 0; k < runLength * 4; ++k)
+			{
+				vertices[k].TexIndex = packedSlot;
+			}
+
+			i += runLength;
+			s_Data.BatchQuadCount += runLength;
+			if (s_Data.BatchQuadCount == Renderer2DData::MaxQuads)
+			{
+				DrawBatch(GetQuadShader(batchShader));
+			}
+		}
+		DrawBatch(GetQuadShader(batchShader));
+	}
+
+	static void DrawCircles()
+	{
+		const uint32_t circleCount = static_cast<uint32_t>(s_Data.CircleVertices.size() / 4);
+		if (circleCount == 0)
+			return;
+
+		s_Data.CircleShader->Bind();
+		s_Data.CircleVAO->Bind();
+		for (uint32_t offset = 0; offset < circleCount; offset += Renderer2DData::MaxQuads)
+		{
+			const uint32_t batchCount = std::min(circleCount - offset, Renderer2DData::MaxQuads);
+			s_Data.CircleVBO->SetData(s_Data.CircleVertices.data() + offset * 4, batchCount * 4 * sizeof(CircleVertex));
+			RenderCommand::DrawIndexed(s_Data.CircleVAO, batchCount * 6);
+			++s_Data.Stats.DrawCalls;
+		}
+	}
+
+	static void DrawLines()
+	{
+		const uint32_t vertexCount = static_cast<uint32_t>(s_Data.LineVertices.size());
+		if (vertexCount == 0)
+			return;
+
+		s_Data.LineShader->Bind();
+		s_Data.LineVAO->Bind();
+		RenderCommand::SetLineWidth(s_Data.LineWidth);
+		for (uint32_t offset = 0; offset < vertexCount; offset += Renderer2DData::MaxLineVertices)
+		{
+			const uint32_t batchCount = std::min(vertexCount - offset, Renderer2DData::MaxLineVertices);
+			s_Data.LineVBO->SetData(s_Data.LineVertices.data() + offset, batchCount * sizeof(LineVertex));
+			RenderCommand::DrawLines(s_Data.LineVAO, batchCount);
+			++s_Data.Stats.DrawCalls;
+		}
+	}
+
+	/** Draw visible chunks of staged tilemaps, translucent ones back to front without writing depth like translucent quads. */
+	static void DrawTilemaps(FrameVector<TilemapDraw>& draws, bool bTranslucent)
+	{
+		if (draws.empty())
+			return;
+
+		if (bTranslucent)
+		{
+			std::stable_sort(draws.begin(), draws.end(), [](const TilemapDraw& lhs, const TilemapDraw& rhs) { return lhs.Transform[3].z < rhs.Transform[3].z; });
+		}
+		RenderCommand::SetBlendEnabled(bTranslucent);
+		RenderCommand::SetDepthWriteEnabled(!bTranslucent);
+
+		const Bounds2D& viewBounds = s_Data.ViewBounds;
+		const glm::vec2 viewCorners[4] = {
+			viewBounds.Min, { viewBounds.Max.x, viewBounds.Min.y }, viewBounds.Max, { viewBounds.Min.x, viewBounds.Max.y }
+		};
+		for (const TilemapDraw& draw : draws)
+		{
+			// Bounds of the view in tile units of the tilemap
+			const glm::mat4 inverseTransform = glm::inverse(draw.Transform);
+			Bounds2D localBounds = { glm::vec2(std::numeric_limits<float>::max()), glm::vec2(std::numeric_limits<float>::lowest()) };
+			for (const glm::vec2& corner : viewCorners)
+			{
+				const glm::vec2 localCorner = glm::vec2(inverseTransform * glm::vec4(corner, draw.Transform[3].z, 1.0f));
+				localBounds.Min = glm::min(localBounds.Min, localCorner);
+				localBounds.Max = glm::max(localBounds.Max, localCorner);
+			}
+
+			s_Data.TilemapMaterial.SetFloat4("u_TintColor", draw.TintColor);
+			draw.Map->GetTileset()->Bind(0);
+			draw.Map->ForEachVisibleChunk(localBounds, [&draw](const Ref<VertexArray>& vertexArray, uint32_t quadCount)
+			{
+				Renderer::Submit(s_Data.TilemapShader, vertexArray, draw.Transform, &s_Data.TilemapMaterial, quadCount * 6);
+				++s_Data.Stats.DrawCalls;
+				++s_Data.Stats.TilemapChunkCount;
+				s_Data.Stats.TileCount += quadCount;
+			});
+		}
+		draws = FrameVector<TilemapDraw>();
+	}
+
+	void Renderer2D::Flush()
+	{
+		ZE_PROFILE_FUNCTION();
+		ZE_MEMORY_TAG(Renderer);
+
+		// Staging vectors only allocate once something is staged, so empty ones hold no frame memory
+		if (s_Data.OpaquePass.GetQuadCount() + s_Data.TranslucentPass.GetQuadCount() == 0 &&
+			s_Data.CircleVertices.empty() && s_Data.LineVertices.empty() && s_Data.OpaqueTilemaps.empty() && s_Data.TranslucentTilemaps.empty())
+			return;
+
+		DrawTilemaps(s_Data.OpaqueTilemaps, false);
+		DrawPass(s_Data.OpaquePass);
+		DrawTilemaps(s_Data.TranslucentTilemaps, true);
+		DrawPass(s_Data.TranslucentPass);
+		s_Data.Stats.TranslucentQuadCount += s_Data.TranslucentPass.GetQuadCount();
+
+		// Restore the states set by RendererAPI::Init() for other renderers, circles need them too for their soft edges
+		RenderCommand::SetBlendEnabled(true);
+		RenderCommand::SetDepthWriteEnabled(true);
+
+		DrawCircles();
+		DrawLines();
+		s_Data.CircleVertices = FrameVector<CircleVertex>();
+		s_Data.LineVertices = FrameVector<LineVertex>();
+
+		s_Data.OpaquePass.Clear();
+		s_Data.TranslucentPass.Clear();
+		s_Data.SceneTextures.resize(1);
+		s_Data.SceneTextureTranslucency.resize(1);
+		s_Data.SceneTextureSlots.resize(1);
+		s_Data.SceneTextureIds.clear();
+	}
+
+	uint32_t Renderer2D::GetTextureId(const Ref<Texture2D>& texture)
+	{
+		auto it = s_Data.SceneTextureIds.find(texture.get());
+		if (it != s_Data.SceneTextureIds.end())
+			return it->second;
+
+		// Different texture objects may still refer to the same GPU resource
+		uint32_t textureId = 1;
+		const uint32_t textureCount = static_cast<uint32_t>(s_Data.SceneTextures.size());
+		while (textureId < textureCount && !(*s_Data.SceneTextures[textureId] == *texture))
+		{
+			++textureId;
+		}
+		if (textureId == textureCount)
+		{
+			s_Data.SceneTextures.push_back(texture);
+			s_Data.SceneTextureTranslucency.push_back(texture->IsTranslucent());
+			s_Data.SceneTextureSlots.push_back(Renderer2DData::NoTextureSlot);
+		}
+		s_Data.SceneTextureIds.emplace(texture.get(), textureId);
+		return textureId;
+	}
+
+	QuadVertex* Renderer2D::AddQuad(uint32_t textureId, float alpha, const glm::vec3& position)
+	{
+		const bool bTranslucent = alpha < 1.0f || s_Data.SceneTextureTranslucency[textureId];
+		QuadPass& pass = bTranslucent ? s_Data.TranslucentPass : s_Data.OpaquePass;
+		return pass.AddQuads(1, textureId, &position);
+	}
+
+	bool Renderer2D::CullQuad(const glm::mat4& transform)
+	{
+		if (Culling2D::IsQuadVisible(transform, s_Data.ViewBounds))
+			return false;
+
+		++s_Data.Stats.CulledQuadCount;
+		return true;
+	}
+
+	bool Renderer2D::CullQuad(const glm::vec3& position, const glm::vec2& size, float rotation)
+	{
+		// Use the circumscribed circle for rotated quads so that culling never needs sine and cosine
+		const glm::vec2 extent = rotation == 0.0f ? 0.5f * glm::abs(size) : glm::vec2(0.5f * glm::length(size));
+		const Bounds2D bounds = { glm::vec2(position) - extent, glm::vec2(position) + extent };
+		if (bounds.Intersects(s_Data.ViewBounds))
+			return false;
+
+		++s_Data.Stats.CulledQuadCount;
+		return true;
+	}
+
+	uint32_t Renderer2D::CullQuads(const float* centerX, const float* centerY, const float* extentX, const float* extentY, uint32_t count, uint8_t* outVisibility)
+	{
+		const uint32_t visibleCount = Culling2D::CullQuads(centerX, centerY, extentX, extentY, count, s_Data.ViewBounds, outVisibility);
+		s_Data.Stats.CulledQuadCount += count - visibleCount;
+		return visibleCount;
+	}
+
+	void Renderer2D::ReportCulledQuads(uint32_t count)
+	{
+		s_Data.Stats.CulledQuadCount += count;
+	}
+
+	const Bounds2D& Renderer2D::GetViewBounds()
+	{
+		return s_Data.ViewBounds;
+	}
+
+	void Renderer2D::SubmitQuad(const glm::mat4& transform, const glm::vec4& color, uint32_t textureId, const glm::vec2* texCoords, float tilingFactor)
+	{
+		QuadVertex* vertices = AddQuad(textureId, color.a, glm::vec3(transform[3]));
+		const uint32_t packedColor = VertexPacking::PackColor(color);
+		const uint16_t packedTilingFactor = VertexPacking::FloatToHalf(tilingFactor);
+		for (uint32_t i = 0; i < 4; ++i)
+		{
+			vertices[i].Position = transform * s_Data.QuadVertexPositions[i];
+			vertices[i].Color = packedColor;
+			vertices[i].TexCoord = VertexPacking::PackHalf2(texCoords[i]);
+			// Texture slot is assigned when the quad is batched
+			vertices[i].TexIndex = 0;
+			vertices[i].TilingFactor = packedTilingFactor;
+		}
+
+		++s_Data.Stats.QuadCount;
+	}
+
+	void Renderer2D::SubmitQuad(const glm::vec3& position, const glm::vec2& size, float rotation, const glm::vec4& color, uint32_t textureId, const glm::vec2* texCoords, float tilingFactor)
+	{
+		QuadVertex* vertices = AddQuad(textureId, color.a, position);
+		QuadVertexKernel::GenerateVertices(&position, &size, &rotation, &color, 1, texCoords, 0.0f, tilingFactor, vertices);
+
+		++s_Data.Stats.QuadCount;
+	}
+
+	/** Stage quads in the opaque or translucent pass, runs of quads going to the same pass are generated in one go. */
+	static void StageQuads(uint32_t count, const glm::vec3* positions, const glm::vec2* sizes, const float* rotations, const glm::vec4* colors,
+		uint32_t textureId, float tilingFactor)
+	{
+		const bool bTextureTranslucent = s_Data.SceneTextureTranslucency[textureId];
+		uint32_t offset = 0;
+		while (offset < count)
+		{
+			const bool bTranslucent = bTextureTranslucent || colors[offset].a < 1.0f;
+			uint32_t quadCount = count - offset;
+			if (!bTextureTranslucent)
+			{
+				quadCount = 1;
+				while (offset + quadCount < count && (colors[offset + quadCount].a < 1.0f) == bTranslucent)
+				{
+					++quadCount;
+				}
+			}
+
+			QuadPass& pass = bTranslucent ? s_Data.TranslucentPass : s_Data.OpaquePass;
+			QuadVertex* vertices = pass.AddQuads(quadCount, textureId, positions + offset);
+			QuadVertexKernel::GenerateVertices(positions + offset, sizes + offset, rotations ? rotations + offset : nullptr, colors + offset, quadCount,
+				s_Data.QuadTexCoords, 0.0f, tilingFactor, vertices);
+			offset += quadCount;
+		}
+	}
+
+	void Renderer2D::DrawQuads(uint32_t count, const glm::vec3* positions, const glm::vec2* sizes, const float* rotations, const glm::vec4* colors,
+		const Ref<Texture2D>& texture, float tilingFactor)
+	{
+		ZE_PROFILE_FUNCTION();
+		ZE_MEMORY_TAG(Renderer);
+
+		if (count == 0)
+			return;
+
+		// Bounds in SoA layout for the culling kernel, rotated quads use their circumscribed circle like CullQuad()
+		float* centerX = FrameAllocator::NewArray<float>(count);
+		float* centerY = FrameAllocator::NewArray<float>(count);
+		float* extentX = FrameAllocator::NewArray<float>(count);
+		float* extentY = FrameAllocator::NewArray<float>(count);
+		uint8_t* visibility = FrameAllocator::NewArray<uint8_t>(count);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			const glm::vec2 extent = rotations && rotations[i] != 0.0f ? glm::vec2(0.5f * glm::length(sizes[i])) : 0.5f * glm::abs(sizes[i]);
+			centerX[i] = positions[i].x;
+			centerY[i] = positions[i].y;
+			extentX[i] = extent.x;
+			extentY[i] = extent.y;
+		}
+		const uint32_t visibleCount = CullQuads(centerX, centerY, extentX, extentY, count, visibility);
+		if (visibleCount == 0)
+			return;
+
+		const uint32_t textureId = texture ? GetTextureId(texture) : 0;
+		if (visibleCount < count)
+		{
+			// Only visible quads get vertices, so gather them into contiguous arrays for the vertex kernel
+			glm::vec3* visiblePositions = FrameAllocator::NewArray<glm::vec3>(visibleCount);
+			glm::vec2* visibleSizes = FrameAllocator::NewArray<glm::vec2>(visibleCount);
+			float* visibleRotations = rotations ? FrameAllocator::NewArray<float>(visibleCount) : nullptr;
+			glm::vec4* visibleColors = FrameAllocator::NewArray<glm::vec4>(visibleCount);
+			uint32_t visibleIndex = 0;
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				if (!visibility[i])
+					continue;
+
+				visiblePositions[visibleIndex] = positions[i];
+				visibleSizes[visibleIndex] = sizes[i];
+				if (rotations)
+				{
+					visibleRotations[visibleIndex] = rotations[i];
+				}
+				visibleColors[visibleIndex] = colors[i];
+				++visibleIndex;
+			}
+			StageQuads(visibleCount, visiblePositions, visibleSizes, visibleRotations, visibleColors, textureId, tilingFactor);
+		}
+		else
+		{
+			StageQuads(count, positions, sizes, rotations, colors, textureId, tilingFactor);
+		}
+		s_Data.Stats.QuadCount += visibleCount;
+	}
+
+	void Renderer2D::DrawSquares(uint32_t count, const float* positionX, const float* positionY, const float* sizes, const uint32_t* packedColors, float z,
+		const Ref<Texture2D>& texture)
+	{
+		ZE_PROFILE_FUNCTION();
+		ZE_MEMORY_TAG(Renderer);
+
+		if (count == 0)
+			return;
+
+		float* extents = FrameAllocator::NewArray<float>(count);
+		uint8_t* visibility = FrameAllocator::NewArray<uint8_t>(count);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			extents[i] = 0.5f * std::abs(sizes[i]);
+		}
+		const uint32_t visibleCount = CullQuads(positionX, positionY, extents, extents, count, visibility);
+		if (visibleCount == 0)
+			return;
+
+		if (visibleCount < count)
+		{
+			// Only visible squares get vertices, so gather them into contiguous arrays for the vertex kernel
+			float* visiblePositionX = FrameAllocator::NewArray<float>(visibleCount);
+			float* visiblePositionY = FrameAllocator::NewArray<float>(visibleCount);
+			float* visibleSizes = FrameAllocator::NewArray<float>(visibleCount);
+			uint32_t* visibleColors = FrameAllocator::NewArray<uint32_t>(visibleCount);
+			uint32_t visibleIndex = 0;
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				if (!visibility[i])
+					continue;
+
+				visiblePositionX[visibleIndex] = positionX[i];
+				visiblePositionY[visibleIndex] = positionY[i];
+				visibleSizes[visibleIndex] = sizes[i];
+				visibleColors[visibleIndex] = packedColors[i];
+				++visibleIndex;
+			}
+			positionX = visiblePositionX;
+			positionY = visiblePositionY;
+			sizes = visibleSizes;
+			packedColors = visibleColors;
+		}
+
+		QuadVertex* vertices = s_Data.TranslucentPass.AddQuads(visibleCount, texture ? GetTextureId(texture) : 0, z);
+		JobSystem::ParallelFor(visibleCount, 4096, [=](uint32_t begin, uint32_t end)
+		{
+			QuadVertexKernel::GenerateSquareVertices(positionX + begin, positionY + begin, sizes + begin, packedColors + begin, end - begin, z,
+				s_Data.QuadTexCoords, 0.0f, 1.0f, vertices + begin * 4);
+		});
+		s_Data.Stats.QuadCount += visibleCount;
 	}
 
 	void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color)
@@ -90,16 +772,11 @@ namespace ZeoEngine {
 	{
 		ZE_PROFILE_FUNCTION();
 
-		s_Data->TextureShader->SetFloat4("u_Color", color);
-		s_Data->TextureShader->SetFloat("u_TilingFactor", 1.0f);
-		s_Data->WhiteTexture->Bind();
+		if (CullQuad(position, size, 0.0f))
+			return;
 
-		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position) *
-			glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
-		s_Data->TextureShader->SetMat4("u_Transform", transform);
-
-		s_Data->QuadVAO->Bind();
-		RenderCommand::DrawIndexed(s_Data->QuadVAO);
+		// White texture
+		SubmitQuad(position, size, 0.0f, color, 0, s_Data.QuadTexCoords, 1.0f);
 	}
 
 	void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size, const Ref<Texture2D>& texture, float tilingFactor, const glm::vec4& tintColor)
@@ -111,16 +788,57 @@ namespace ZeoEngine {
 	{
 		ZE_PROFILE_FUNCTION();
 
-		s_Data->TextureShader->SetFloat4("u_Color", tintColor);
-		s_Data->TextureShader->SetFloat("u_TilingFactor", tilingFactor);
-		texture->Bind();
+		if (CullQuad(position, size, 0.0f))
+			return;
+
+		uint32_t textureId = GetTextureId(texture);
+
+		SubmitQuad(position, size, 0.0f, tintColor, textureId, s_Data.QuadTexCoords, tilingFactor);
+	}
+
+	void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size, const Ref<SubTexture2D>& subTexture, float tilingFactor, const glm::vec4& tintColor)
+	{
+		DrawQuad({ position.x, position.y, 0.0f }, size, subTexture, tilingFactor, tintColor);
+	}
+
+	void Renderer2D::DrawQuad(const glm::vec3& position, const glm::vec2& size, const Ref<SubTexture2D>& subTexture, float tilingFactor, const glm::vec4& tintColor)
+	{
+		ZE_PROFILE_FUNCTION();
+
+		if (CullQuad(position, size, 0.0f))
+			return;
+
+		uint32_t textureId = GetTextureId(subTexture->GetTexture());
+
+		SubmitQuad(position, size, 0.0f, tintColor, textureId, subTexture->GetTexCoords(), tilingFactor);
+	}
+
+	// Overloads taking a transform are called once per entity by Scene, so they are not profiled individually
+	void Renderer2D::DrawQuad(const glm::mat4& transform, const glm::vec4& color)
+	{
+		if (CullQuad(transform))
+			return;
+
+		// White texture
+		SubmitQuad(transform, color, 0, s_Data.QuadTexCoords, 1.0f);
+	}
+
+	void Renderer2D::DrawQuad(const glm::mat4& transform, const Ref<Texture2D>& texture, float tilingFactor, const glm::vec4& tintColor)
+	{
+		if (CullQuad(transform))
+			return;
+
+		uint32_t textureId = GetTextureId(texture);
+		SubmitQuad(transform, tintColor, textureId, s_Data.QuadTexCoords, tilingFactor);
+	}
 
-		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position) *
-			glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
-		s_Data->TextureShader->SetMat4("u_Transform", transform);
+	void Renderer2D::DrawQuad(const glm::mat4& transform, const Ref<SubTexture2D>& subTexture, float tilingFactor, const glm::vec4& tintColor)
+	{
+		if (CullQuad(transform))
+			return;
 
-		s_Data->QuadVAO->Bind();
-		RenderCommand::DrawIndexed(s_Data->QuadVAO);
+		uint32_t textureId = GetTextureId(subTexture->GetTexture());
+		SubmitQuad(transform, tintColor, textureId, subTexture->GetTexCoords(), tilingFactor);
 	}
 
 	void Renderer2D::DrawRotatedQuad(const glm::vec2& position, const glm::vec2& size, float rotation, const glm::vec4& color)
@@ -132,17 +850,11 @@ namespace ZeoEngine {
 	{
 		ZE_PROFILE_FUNCTION();
 
-		s_Data->TextureShader->SetFloat4("u_Color", color);
-		s_Data->TextureShader->SetFloat("u_TilingFactor", 1.0f);
-		s_Data->WhiteTexture->Bind();
+		if (CullQuad(position, size, rotation))
+			return;
 
-		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position) *
-			glm::rotate(glm::mat4(1.0f), rotation, { 0.0f, 0.0f, 1.0f }) *
-			glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
-		s_Data->TextureShader->SetMat4("u_Transform", transform);
-
-		s_Data->QuadVAO->Bind();
-		RenderCommand::DrawIndexed(s_Data->QuadVAO);
+		// White texture
+		SubmitQuad(position, size, rotation, color, 0, s_Data.QuadTexCoords, 1.0f);
 	}
 
 	void Renderer2D::DrawRotatedQuad(const glm::vec2& position, const glm::vec2& size, float rotation, const Ref<Texture2D>& texture, float tilingFactor, const glm::vec4& tintColor)
@@ -154,17 +866,235 @@ namespace ZeoEngine {
 	{
 		ZE_PROFILE_FUNCTION();
 
-		s_Data->TextureShader->SetFloat4("u_Color", tintColor);
-		s_Data->TextureShader->SetFloat("u_TilingFactor", tilingFactor);
-		texture->Bind();
+		if (CullQuad(position, size, rotation))
+			return;
+
+		uint32_t textureId = GetTextureId(texture);
+
+		SubmitQuad(position, size, rotation, tintColor, textureId, s_Data.QuadTexCoords, tilingFactor);
+	}
+
+	void Renderer2D::DrawRotatedQuad(const glm::vec2& position, const glm::vec2& size, float rotation, const Ref<SubTexture2D>& subTexture, float tilingFactor, const glm::vec4& tintColor)
+	{
+		DrawRotatedQuad({ position.x, position.y, 0.0f }, size, rotation, subTexture, tilingFactor, tintColor);
+	}
+
+	void Renderer2D::DrawRotatedQuad(const glm::vec3& position, const glm::vec2& size, float rotation, const Ref<SubTexture2D>& subTexture, float tilingFactor, const glm::vec4& tintColor)
+	{
+		ZE_PROFILE_FUNCTION();
+
+		if (CullQuad(position, size, rotation))
+			return;
+
+		uint32_t textureId = GetTextureId(subTexture->GetTexture());
+
+		SubmitQuad(position, size, rotation, tintColor, textureId, subTexture->GetTexCoords(), tilingFactor);
+	}
+
+	// Primitives below are called many times per frame by debug overlays, so they are not profiled individually
+	void Renderer2D::DrawLine(const glm::vec3& start, const glm::vec3& end, const glm::vec4& color)
+	{
+		const Bounds2D bounds = { glm::min(glm::vec2(start), glm::vec2(end)), glm::max(glm::vec2(start), glm::vec2(end)) };
+		if (!bounds.Intersects(s_Data.ViewBounds))
+		{
+			++s_Data.Stats.CulledLineCount;
+			return;
+		}
+
+		const uint32_t packedColor = VertexPacking::PackColor(color);
+		s_Data.LineVertices.push_back({ start, packedColor });
+		s_Data.LineVertices.push_back({ end, packedColor });
+		++s_Data.Stats.LineCount;
+	}
+
+	void Renderer2D::DrawPolyline(const glm::vec3* points, uint32_t count, const glm::vec4& color, bool bClosed)
+	{
+		ZE_PROFILE_FUNCTION();
+
+		if (count < 2)
+			return;
+
+		const uint32_t segmentCount = bClosed ? count : count - 1;
+		const uint32_t packedColor = VertexPacking::PackColor(color);
+		s_Data.LineVertices.reserve(s_Data.LineVertices.size() + segmentCount * 2);
+		for (uint32_t i = 0; i < segmentCount; ++i)
+		{
+			const glm::vec3& start = points[i];
+			const glm::vec3& end = points[(i + 1) % count];
+			const Bounds2D bounds = { glm::min(glm::vec2(start), glm::vec2(end)), glm::max(glm::vec2(start), glm::vec2(end)) };
+			if (!bounds.Intersects(s_Data.ViewBounds))
+			{
+				++s_Data.Stats.CulledLineCount;
+				continue;
+			}
 
-		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position) *
-			glm::rotate(glm::mat4(1.0f), rotation, { 0.0f, 0.0f, 1.0f }) *
-			glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
-		s_Data->TextureShader->SetMat4("u_Transform", transform);
+			s_Data.LineVertices.push_back({ start, packedColor });
+			s_Data.LineVertices.push_back({ end, packedColor });
+			++s_Data.Stats.LineCount;
+		}
+	}
+
+	void Renderer2D::DrawRect(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color)
+	{
+		const glm::vec2 extent = 0.5f * size;
+		const glm::vec3 corners[4] = {
+			{ position.x - extent.x, position.y - extent.y, position.z },
+			{ position.x + extent.x, position.y - extent.y, position.z },
+			{ position.x + extent.x, position.y + extent.y, position.z },
+			{ position.x - extent.x, position.y + extent.y, position.z },
+		};
+		DrawPolyline(corners, 4, color, true);
+	}
+
+	void Renderer2D::DrawRect(const glm::mat4& transform, const glm::vec4& color)
+	{
+		glm::vec3 corners[4];
+		for (uint32_t i = 0; i < 4; ++i)
+		{
+			corners[i] = transform * s_Data.QuadVertexPositions[i];
+		}
+		DrawPolyline(corners, 4, color, true);
+	}
+
+	void Renderer2D::SubmitCircle(const glm::vec3* corners, const glm::vec4& color, float thickness, float fade)
+	{
+		const uint32_t packedColor = VertexPacking::PackColor(color);
+		const uint16_t packedThickness = VertexPacking::FloatToHalf(thickness);
+		const uint16_t packedFade = VertexPacking::FloatToHalf(fade);
+		for (uint32_t i = 0; i < 4; ++i)
+		{
+			s_Data.CircleVertices.push_back({ corners[i], packedColor, s_Data.PackedCircleLocalPositions[i], packedThickness, packedFade });
+		}
+		++s_Data.Stats.CircleCount;
+	}
+
+	void Renderer2D::DrawCircle(const glm::mat4& transform, const glm::vec4& color, float thickness, float fade)
+	{
+		if (CullQuad(transform))
+			return;
+
+		glm::vec3 corners[4];
+		for (uint32_t i = 0; i < 4; ++i)
+		{
+			corners[i] = transform * s_Data.QuadVertexPositions[i];
+		}
+		SubmitCircle(corners, color, thickness, fade);
+	}
 
-		s_Data->QuadVAO->Bind();
-		RenderCommand::DrawIndexed(s_Data->QuadVAO);
+	void Renderer2D::DrawCircle(const glm::vec3& center, float radius, const glm::vec4& color, float thickness, float fade)
+	{
+		if (CullQuad(center, glm::vec2(2.0f * radius), 0.0f))
+			return;
+
+		glm::vec3 corners[4];
+		for (uint32_t i = 0; i < 4; ++i)
+		{
+			corners[i] = { center.x + 2.0f * radius * s_Data.QuadVertexPositions[i].x, center.y + 2.0f * radius * s_Data.QuadVertexPositions[i].y, center.z };
+		}
+		SubmitCircle(corners, color, thickness, fade);
+	}
+
+	/** Write four vertices for every glyph of the layout, corners in em units are mapped to world space by transformCorner. */
+	template<typename TransformFunc>
+	static void WriteGlyphVertices(const TextLayout& layout, const glm::vec4& color, QuadVertex* outVertices, TransformFunc transformCorner)
+	{
+		const uint32_t packedColor = VertexPacking::PackColor(color);
+		for (const auto& glyph : layout.Glyphs)
+		{
+			const glm::vec2 min = glyph.Position + glyph.Metrics->QuadMin;
+			const glm::vec2 max = glyph.Position + glyph.Metrics->QuadMax;
+			const glm::vec2 corners[4] = { min, { max.x, min.y }, max, { min.x, max.y } };
+			for (uint32_t k = 0; k < 4; ++k)
+			{
+				outVertices->Position = transformCorner(corners[k]);
+				outVertices->Color = packedColor;
+				outVertices->TexCoord = glyph.Metrics->PackedTexCoords[k];
+				// Texture slot is assigned when the glyph is batched
+				outVertices->TexIndex = 0;
+				outVertices->TilingFactor = s_Data.PackedUnitTilingFactor;
+				++outVertices;
+			}
+		}
+	}
+
+	// Strings may be drawn thousands of times per frame, so they are not profiled individually
+	void Renderer2D::DrawString(const std::string& text, const Ref<Font>& font, const glm::vec3& position, float size, const glm::vec4& color)
+	{
+		const TextLayout& layout = font->GetLayout(text);
+		const uint32_t glyphCount = static_cast<uint32_t>(layout.Glyphs.size());
+		if (glyphCount == 0)
+			return;
+
+		const Bounds2D bounds = { glm::vec2(position) + size * layout.Min, glm::vec2(position) + size * layout.Max };
+		if (!bounds.Intersects(s_Data.ViewBounds))
+		{
+			s_Data.Stats.CulledQuadCount += glyphCount;
+			return;
+		}
+
+		QuadVertex* vertices = s_Data.TranslucentPass.AddQuads(glyphCount, GetTextureId(font->GetAtlasTexture()), position.z, QuadShader::Text);
+		WriteGlyphVertices(layout, color, vertices, [&position, size](const glm::vec2& corner)
+		{
+			return glm::vec3(position.x + size * corner.x, position.y + size * corner.y, position.z);
+		});
+		s_Data.Stats.GlyphCount += glyphCount;
+	}
+
+	void Renderer2D::DrawString(const std::string& text, const Ref<Font>& font, const glm::mat4& transform, const glm::vec4& color)
+	{
+		const TextLayout& layout = font->GetLayout(text);
+		const uint32_t glyphCount = static_cast<uint32_t>(layout.Glyphs.size());
+		if (glyphCount == 0)
+			return;
+
+		// Bounds of the transformed layout rectangle
+		const glm::vec2 center = glm::vec2(transform * glm::vec4(0.5f * (layout.Min + layout.Max), 0.0f, 1.0f));
+		const glm::vec2 halfSize = 0.5f * (layout.Max - layout.Min);
+		const glm::vec2 extent = glm::abs(glm::vec2(transform[0]) * halfSize.x) + glm::abs(glm::vec2(transform[1]) * halfSize.y);
+		const Bounds2D bounds = { center - extent, center + extent };
+		if (!bounds.Intersects(s_Data.ViewBounds))
+		{
+			s_Data.Stats.CulledQuadCount += glyphCount;
+			return;
+		}
+
+		QuadVertex* vertices = s_Data.TranslucentPass.AddQuads(glyphCount, GetTextureId(font->GetAtlasTexture()), transform[3].z, QuadShader::Text);
+		WriteGlyphVertices(layout, color, vertices, [&transform](const glm::vec2& corner)
+		{
+			return glm::vec3(transform * glm::vec4(corner, 0.0f, 1.0f));
+		});
+		s_Data.Stats.GlyphCount += glyphCount;
+	}
+
+	void Renderer2D::DrawTilemap(Tilemap& tilemap, const glm::mat4& transform, const glm::vec4& tintColor)
+	{
+		const bool bTranslucent = tintColor.a < 1.0f || tilemap.GetTileset()->IsTranslucent();
+		auto& draws = bTranslucent ? s_Data.TranslucentTilemaps : s_Data.OpaqueTilemaps;
+		draws.push_back({ &tilemap, transform, tintColor });
+	}
+
+	void Renderer2D::SetLineWidth(float width)
+	{
+		s_Data.LineWidth = width;
+	}
+
+	float Renderer2D::GetLineWidth()
+	{
+		return s_Data.LineWidth;
+	}
+
+	void Renderer2D::ResetStats()
+	{
+		memset(&s_Data.Stats, 0, sizeof(Statistics));
+		RenderCommand::ResetStateStats();
+	}
+
+	Renderer2D::Statistics Renderer2D::GetStats()
+	{
+		RendererAPI::StateStatistics stateStats = RenderCommand::GetStateStats();
+		s_Data.Stats.StateChangesIssued = stateStats.IssuedCalls;
+		s_Data.Stats.StateChangesSkipped = stateStats.SkippedCalls;
+		return s_Data.Stats;
 	}
 
 }
@@ -2,9 +2,15 @@
 
 #include "Engine/Renderer/OrthographicCamera.h"
 #include "Engine/Renderer/Texture.h"
+#include "Engine/Renderer/SubTexture2D.h"
+#include "Engine/Renderer/Culling2D.h"
+#include "Engine/Renderer/Font.h"
+#include "Engine/Renderer/Tilemap.h"
 
 namespace ZeoEngine {
 
+	struct QuadVertex;
+
 	class Renderer2D
 	{
 	public:
@@ -13,17 +19,131 @@ namespace ZeoEngine {
 
 		static void BeginScene(const OrthographicCamera& camera);
 		static void EndScene();
+		/**
+		 * Draw all quads submitted so far. Opaque quads are drawn first, front to back without blending,
+		 * then translucent ones and text back to front with blending and without depth writes. Quads with equal depth keep their submission order.
+		 */
+		static void Flush();
 
 		static void DrawQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color);
 		static void DrawQuad(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color);
 		static void DrawQuad(const glm::vec2& position, const glm::vec2& size, const Ref<Texture2D>& texture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f));
 		static void DrawQuad(const glm::vec3& position, const glm::vec2& size, const Ref<Texture2D>& texture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f));
+		static void DrawQuad(const glm::vec2& position, const glm::vec2& size, const Ref<SubTexture2D>& subTexture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f));
+		static void DrawQuad(const glm::vec3& position, const glm::vec2& size, const Ref<SubTexture2D>& subTexture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f));
+
+		static void DrawQuad(const glm::mat4& transform, const glm::vec4& color);
+		static void DrawQuad(const glm::mat4& transform, const Ref<Texture2D>& texture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f));
+		static void DrawQuad(const glm::mat4& transform, const Ref<SubTexture2D>& subTexture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f));
+
+		/**
+		 * Test quads given as SoA arrays of world-space centers and half extents against the view of current scene.
+		 * Culled quads are counted in stats. See Culling2D::CullQuads().
+		 */
+		static uint32_t CullQuads(const float* centerX, const float* centerY, const float* extentX, const float* extentY, uint32_t count, uint8_t* outVisibility);
+		/** Count quads culled by the caller without going through Renderer2D, e.g. by a spatial index query. */
+		static void ReportCulledQuads(uint32_t count);
+		/** World-space bounds of the view of current scene. */
+		static const Bounds2D& GetViewBounds();
 
 		/** Rotation should be in radians. */
 		static void DrawRotatedQuad(const glm::vec2& position, const glm::vec2& size, float rotation, const glm::vec4& color);
 		static void DrawRotatedQuad(const glm::vec3& position, const glm::vec2& size, float rotation, const glm::vec4& color);
 		static void DrawRotatedQuad(const glm::vec2& position, const glm::vec2& size, float rotation, const Ref<Texture2D>& texture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f));
 		static void DrawRotatedQuad(const glm::vec3& position, const glm::vec2& size, float rotation, const Ref<Texture2D>& texture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f));
+		static void DrawRotatedQuad(const glm::vec2& position, const glm::vec2& size, float rotation, const Ref<SubTexture2D>& subTexture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f));
+		static void DrawRotatedQuad(const glm::vec3& position, const glm::vec2& size, float rotation, const Ref<SubTexture2D>& subTexture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f));
+
+		/**
+		 * Draw many quads given as arrays. Quads are culled against the view in SIMD batches first, then vertices of visible ones
+		 * are generated into the staging buffers of the opaque and translucent passes, see QuadVertexKernel.
+		 * Rotations are in radians and may be null. A null texture draws flat colors.
+		 */
+		static void DrawQuads(uint32_t count, const glm::vec3* positions, const glm::vec2* sizes, const float* rotations, const glm::vec4* colors,
+			const Ref<Texture2D>& texture = nullptr, float tilingFactor = 1.0f);
+
+		/**
+		 * Draw axis-aligned squares given as SoA arrays, e.g. particles, with colors already packed as RGBA8 (see VertexPacking::PackColor()).
+		 * Squares are culled against the view first, then vertices of visible ones are generated in parallel on the job system
+		 * into the staging buffer of the translucent pass. All squares sharing depth z keep their order. The arrays are read before this function returns.
+		 */
+		static void DrawSquares(uint32_t count, const float* positionX, const float* positionY, const float* sizes, const uint32_t* packedColors, float z,
+			const Ref<Texture2D>& texture = nullptr);
+
+		/** Line primitives are meant for debug overlays, they are batched separately and drawn after all quads and circles of a flush. */
+		static void DrawLine(const glm::vec3& start, const glm::vec3& end, const glm::vec4& color);
+		/** Draw line segments connecting consecutive points, and the last point back to the first one if bClosed is true. */
+		static void DrawPolyline(const glm::vec3* points, uint32_t count, const glm::vec4& color, bool bClosed = false);
+		/** Outline of an axis-aligned rectangle centered at position. */
+		static void DrawRect(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color);
+		/** Outline of a unit quad after being transformed. */
+		static void DrawRect(const glm::mat4& transform, const glm::vec4& color);
+		/** Width in pixels of all lines drawn in current scene. */
+		static void SetLineWidth(float width);
+		static float GetLineWidth();
+
+		/**
+		 * Draw a circle filling a unit quad after being transformed, shaped by its distance field in the fragment shader.
+		 * Thickness is the width of the ring relative to the radius, 1 gives a filled disc. Fade is the width of the soft edge relative to the radius.
+		 * Circles are blended and drawn after quads in submission order.
+		 */
+		static void DrawCircle(const glm::mat4& transform, const glm::vec4& color, float thickness = 1.0f, float fade = 0.005f);
+		static void DrawCircle(const glm::vec3& center, float radius, const glm::vec4& color, float thickness = 1.0f, float fade = 0.005f);
+
+		/**
+		 * Draw a UTF-8 string with the baseline of its first line starting at position, size is the em size in world units.
+		 * Glyphs are sampled from the signed distance field atlas of the font and sorted by depth among translucent quads.
+		 */
+		static void DrawString(const std::string& text, const Ref<Font>& font, const glm::vec3& position, float size, const glm::vec4& color = glm::vec4(1.0f));
+		/** The string laid out in em units is placed by the transform, e.g. for a label attached to an entity. */
+		static void DrawString(const std::string& text, const Ref<Font>& font, const glm::mat4& transform, const glm::vec4& color = glm::vec4(1.0f));
+
+		/**
+		 * Draw chunks of the tilemap intersecting the view, one draw call each, with tiles placed in the world by the transform.
+		 * Tilemaps are not depth-sorted against quads: opaque ones are drawn with opaque quads, translucent ones (tileset or tint) are blended
+		 * back to front after opaque quads and before translucent ones, without writing depth. The tilemap must stay alive until EndScene().
+		 */
+		static void DrawTilemap(Tilemap& tilemap, const glm::mat4& transform, const glm::vec4& tintColor = glm::vec4(1.0f));
+
+		struct Statistics
+		{
+			uint32_t DrawCalls = 0;
+			uint32_t QuadCount = 0;
+			/** Quads rejected for lying outside the view */
+			uint32_t CulledQuadCount = 0;
+			/** Quads drawn in the blended pass because of their color or texture, including glyphs */
+			uint32_t TranslucentQuadCount = 0;
+			uint32_t CircleCount = 0;
+			uint32_t GlyphCount = 0;
+			uint32_t LineCount = 0;
+			/** Line segments rejected for lying outside the view */
+			uint32_t CulledLineCount = 0;
+			/** Tiles of visible tilemap chunks, drawn from static vertex buffers */
+			uint32_t TileCount = 0;
+			uint32_t TilemapChunkCount = 0;
+			/** GPU state changes sent to the driver and those skipped as redundant, counted across all renderers */
+			uint32_t StateChangesIssued = 0;
+			uint32_t StateChangesSkipped = 0;
+
+			uint32_t GetTotalVertexCount() const { return (QuadCount + CircleCount + GlyphCount + TileCount) * 4 + LineCount * 2; }
+			uint32_t GetTotalIndexCount() const { return (QuadCount + CircleCount + GlyphCount + TileCount) * 6; }
+		};
+		static void ResetStats();
+		static Statistics GetStats();
+
+	private:
+		/** Returns the id of the texture among those used in current scene, the texture will be added if it has not been used yet. */
+		static uint32_t GetTextureId(const Ref<Texture2D>& texture);
+		/** Stage a quad in the opaque or translucent pass and return its four vertices to be filled in. */
+		static QuadVertex* AddQuad(uint32_t textureId, float alpha, const glm::vec3& position);
+		/** Returns true and counts the quad in stats if it lies outside the view. */
+		static bool CullQuad(const glm::mat4& transform);
+		static bool CullQuad(const glm::vec3& position, const glm::vec2& size, float rotation);
+		/** Write four vertices of a quad into the pass it belongs to. */
+		static void SubmitQuad(const glm::mat4& transform, const glm::vec4& color, uint32_t textureId, const glm::vec2* texCoords, float tilingFactor);
+		static void SubmitQuad(const glm::vec3& position, const glm::vec2& size, float rotation, const glm::vec4& color, uint32_t textureId, const glm::vec2* texCoords, float tilingFactor);
+		/** Write four vertices of a circle given corners of its quad. */
+		static void SubmitCircle(const glm::vec3* corners, const glm::vec4& color, float thickness, float fade);
 	};
 
 }
@@ -15,6 +15,13 @@ namespace ZeoEngine {
 			OpenGL = 1,
 		};
 
+		/** Number of state changes sent to the driver and those filtered out as redundant */
+		struct StateStatistics
+		{
+			uint32_t IssuedCalls = 0;
+			uint32_t SkippedCalls = 0;
+		};
+
 	public:
 		virtual void Init() = 0;
 
@@ -23,7 +30,27 @@ namespace ZeoEngine {
 		virtual void SetClearColor(const glm::vec4& color) = 0;
 		virtual void Clear() = 0;
 
-		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray) = 0;
+		virtual void SetBlendEnabled(bool bEnabled) = 0;
+		virtual void SetDepthTestEnabled(bool bEnabled) = 0;
+		virtual void SetDepthWriteEnabled(bool bEnabled) = 0;
+		/** Width in pixels of lines drawn by DrawLines(). */
+		virtual void SetLineWidth(float width) = 0;
+
+		/**
+		 * If indexCount is 0, the whole index buffer will be drawn.
+		 * baseVertex is added to every index, which lets a small index buffer draw vertices beyond the range of its index type.
+		 */
+		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0, uint32_t baseVertex = 0) = 0;
+		/** Draw independent line segments from pairs of vertices, without an index buffer. */
+		virtual void DrawLines(const Ref<VertexArray>& vertexArray, uint32_t vertexCount) = 0;
+
+		/** Returns the alignment required for offsets of uniform buffer ranges. */
+		virtual uint32_t GetUniformBufferOffsetAlignment() const = 0;
+		/** Returns the number of textures a fragment shader can sample from at once. */
+		virtual uint32_t GetMaxTextureSlots() const = 0;
+
+		virtual StateStatistics GetStateStats() const = 0;
+		virtual void ResetStateStats() = 0;
 
 		inline static API GetAPI() { return s_API; }
 
@@ -4,9 +4,17 @@
 #include "Engine/Renderer/Renderer.h"
 #include "Platform/OpenGL/OpenGLShader.h"
 
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Renderer/HotReloader.h"
+
 namespace ZeoEngine {
+
+	Shader::~Shader()
+	{
+		HotReloader::UnregisterShader(this);
+	}
 	
-	Ref<Shader> Shader::Create(const std::string& filePath)
+	Ref<Shader> Shader::Create(const std::string& filePath, const ShaderDefines& defines)
 	{
 		switch (Renderer::GetAPI())
 		{
@@ -14,7 +22,11 @@ namespace ZeoEngine {
 			ZE_CORE_ASSERT(false, "RendererAPI is currently not supported!");
 			return nullptr;
 		case RendererAPI::API::OpenGL:
-			return CreateRef<OpenGLShader>(filePath);
+		{
+			Ref<Shader> shader = CreateRef<OpenGLShader>(filePath, defines);
+			HotReloader::RegisterShader(shader.get(), filePath, defines);
+			return shader;
+		}
 		default:
 			ZE_CORE_ASSERT(false, "Unknown RendererAPI!");
 			return nullptr;
@@ -36,6 +48,30 @@ namespace ZeoEngine {
 		}
 	}
 
+	Ref<Shader> Shader::CreateAsync(const std::string& name, const ShaderSources& shaderSrcs)
+	{
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::None:
+			ZE_CORE_ASSERT(false, "RendererAPI is currently not supported!");
+			return nullptr;
+		case RendererAPI::API::OpenGL:
+			return CreateRef<OpenGLShader>(name, shaderSrcs);
+		default:
+			ZE_CORE_ASSERT(false, "Unknown RendererAPI!");
+			return nullptr;
+		}
+	}
+
+	std::string Shader::GetNameFromFilePath(const std::string& filePath)
+	{
+		auto lastSlash = filePath.find_last_of("/\\"); // find_last_of() will find ANY of the provided characters
+		lastSlash = lastSlash == std::string::npos ? 0 : lastSlash + 1;
+		auto lastDot = filePath.rfind("."); // rfind() will find EXACTLY the provided characters
+		auto count = lastDot == std::string::npos ? filePath.size() - lastSlash /** File without extension */ : lastDot - lastSlash;
+		return filePath.substr(lastSlash, count);
+	}
+
 	void ShaderLibrary::Add(const std::string& name, const Ref<Shader>& shader)
 	{
 		ZE_CORE_ASSERT(!Exists(name), "Trying to add the shader which already exists!");
@@ -52,6 +88,7 @@ namespace ZeoEngine {
 	{
 		auto shader = Shader::Create(filePath);
 		Add(shader);
+		m_ShaderFilePaths[shader->GetName()] = filePath;
 		return shader;
 	}
 
@@ -59,15 +96,70 @@ namespace ZeoEngine {
 	{
 		auto shader = Shader::Create(filePath);
 		Add(name, shader);
+		m_ShaderFilePaths[name] = filePath;
 		return shader;
 	}
 
+	void ShaderLibrary::LoadAsync(const std::vector<std::string>& filePaths)
+	{
+		ZE_PROFILE_FUNCTION();
+
+		// File IO and preprocessing do not touch the graphics context so they can run on workers
+		std::vector<std::future<ShaderSources>> preprocessResults;
+		preprocessResults.reserve(filePaths.size());
+		for (const auto& filePath : filePaths)
+		{
+			preprocessResults.emplace_back(JobSystem::Submit([filePath]() { return ShaderPreprocessor::Process(filePath); }));
+		}
+
+		// Compiling has to happen on the thread owning the context,
+		// but the driver is free to compile in the background until the results are queried
+		std::vector<Ref<Shader>> shaders;
+		shaders.reserve(filePaths.size());
+		for (size_t i = 0; i < filePaths.size(); ++i)
+		{
+			const std::string name = Shader::GetNameFromFilePath(filePaths[i]);
+			auto shader = Shader::CreateAsync(name, preprocessResults[i].get());
+			HotReloader::RegisterShader(shader.get(), filePaths[i]);
+			Add(name, shader);
+			m_ShaderFilePaths[name] = filePaths[i];
+			shaders.push_back(shader);
+		}
+
+		// Only wait once every compile has been issued so that the driver can work on all of them at the same time
+		for (auto& shader : shaders)
+		{
+			shader->FinishCompile();
+		}
+	}
+
 	Ref<Shader> ShaderLibrary::Get(const std::string& name)
 	{
 		ZE_CORE_ASSERT(Exists(name), "Shader not found!");
 		return m_Shaders[name];
 	}
 
+	Ref<Shader> ShaderLibrary::Get(const std::string& name, const ShaderDefines& defines)
+	{
+		if (defines.empty())
+			return Get(name);
+
+		const std::string variantName = name + "|" + ShaderPreprocessor::GetDefinesKey(defines);
+		auto it = m_Variants.find(variantName);
+		if (it != m_Variants.end())
+			return it->second;
+
+		auto pathIt = m_ShaderFilePaths.find(name);
+		ZE_CORE_ASSERT(pathIt != m_ShaderFilePaths.end(), "Variants are only supported for shaders loaded from file!");
+		if (pathIt == m_ShaderFilePaths.end())
+			return nullptr;
+
+		ZE_CORE_TRACE("Compiling shader variant: {0}", variantName);
+		auto shader = Shader::Create(pathIt->second, defines);
+		m_Variants[variantName] = shader;
+		return shader;
+	}
+
 	bool ShaderLibrary::Exists(const std::string& name) const
 	{
 		return m_Shaders.find(name) != m_Shaders.end();
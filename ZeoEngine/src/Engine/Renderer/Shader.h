@@ -2,17 +2,20 @@
 
 #include <glm/glm.hpp>
 
+#include "Engine/Renderer/ShaderPreprocessor.h"
+
 namespace ZeoEngine {
 
-	class Shader
+	class Shader : public RefCounted
 	{
 	public:
-		virtual ~Shader() = default;
+		virtual ~Shader();
 
 		virtual void Bind() const = 0;
 		virtual void Unbind() const = 0;
 
 		virtual void SetInt(const std::string& name, int value) = 0;
+		virtual void SetIntArray(const std::string& name, int* values, uint32_t count) = 0;
 		virtual void SetFloat(const std::string& name, float value) = 0;
 		virtual void SetFloat3(const std::string& name, const glm::vec3& value) = 0;
 		virtual void SetFloat4(const std::string& name, const glm::vec4& value) = 0;
@@ -20,8 +23,29 @@ namespace ZeoEngine {
 
 		virtual const std::string& GetName() const = 0;
 
-		static Ref<Shader> Create(const std::string& filePath);
+		/**
+		 * Recompile from new sources, used for hot-reloading.
+		 * If compilation fails, the current program is kept and false is returned.
+		 * Note that uniform values are not carried over to the new program.
+		 */
+		virtual bool Reload(const ShaderSources& shaderSrcs) = 0;
+		/**
+		 * Wait for the compile issued by CreateAsync() to complete and report its errors, which must happen before the shader is bound.
+		 * Returns false if the shader failed to compile.
+		 */
+		virtual bool FinishCompile() = 0;
+
+		/** Compile the shader source file with optional variant defines. */
+		static Ref<Shader> Create(const std::string& filePath, const ShaderDefines& defines = {});
 		static Ref<Shader> Create(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc);
+		/**
+		 * Issue compiling of already preprocessed sources and return immediately.
+		 * FinishCompile() must be called before the shader is first bound.
+		 */
+		static Ref<Shader> CreateAsync(const std::string& name, const ShaderSources& shaderSrcs);
+
+		/** "assets/shaders/Texture.glsl" -> "Texture" */
+		static std::string GetNameFromFilePath(const std::string& filePath);
 
 	};
 
@@ -32,13 +56,27 @@ namespace ZeoEngine {
 		void Add(const Ref<Shader>& shader);
 		Ref<Shader> Load(const std::string& filePath);
 		Ref<Shader> Load(const std::string& name, const std::string& filePath);
+		/**
+		 * Load a batch of shaders in parallel. Source files are read and preprocessed on worker threads
+		 * and all compiles are issued up front, so total time is bound by the slowest shader instead of the sum.
+		 */
+		void LoadAsync(const std::vector<std::string>& filePaths);
 
 		Ref<Shader> Get(const std::string& name);
+		/**
+		 * Returns the variant of a loaded shader compiled with the given defines.
+		 * Variants are compiled lazily on first request and cached afterwards.
+		 */
+		Ref<Shader> Get(const std::string& name, const ShaderDefines& defines);
 
 		bool Exists(const std::string& name) const;
 
 	private:
 		std::unordered_map<std::string, Ref<Shader>> m_Shaders;
+		/** Source file paths of shaders loaded from disk, required to compile variants */
+		std::unordered_map<std::string, std::string> m_ShaderFilePaths;
+		/** Map from "name|defines key" to compiled variant */
+		std::unordered_map<std::string, Ref<Shader>> m_Variants;
 
 	};
 
@@ -0,0 +1,197 @@
+#include "ZEpch.h"
+#include "Engine/Renderer/ShaderPreprocessor.h"
+
+#include <fstream>
+#include <filesystem>
+
+namespace ZeoEngine {
+
+	ShaderDefines ShaderPreprocessor::s_GlobalDefines;
+
+	static std::string GetDirectory(const std::string& filePath)
+	{
+		auto lastSlash = filePath.find_last_of("/\\");
+		return lastSlash == std::string::npos ? std::string() : filePath.substr(0, lastSlash + 1);
+	}
+
+	ShaderSources ShaderPreprocessor::Process(const std::string& filePath, const ShaderDefines& defines)
+	{
+		ZE_PROFILE_FUNCTION();
+
+		std::string src = ReadFile(filePath);
+		auto shaderSrcs = SplitStages(src);
+
+		const std::string directory = GetDirectory(filePath);
+		for (auto& pair : shaderSrcs)
+		{
+			// Include-once is tracked per stage as each stage is compiled separately
+			std::unordered_set<std::string> includedFiles;
+			pair.second = InjectDefines(ResolveIncludes(pair.second, directory, includedFiles), defines);
+		}
+
+		return shaderSrcs;
+	}
+
+	std::string ShaderPreprocessor::ReadFile(const std::string& filePath)
+	{
+		ZE_PROFILE_FUNCTION();
+
+		std::string result;
+		std::ifstream in(filePath, std::ios::in | std::ios::binary);
+		if (in)
+		{
+			in.seekg(0, std::ios::end);
+			size_t size = in.tellg();
+			if (size == -1)
+			{
+				ZE_CORE_ERROR("Could not read from file '{0}'!", filePath);
+			}
+			else
+			{
+				result.resize(size);
+				in.seekg(0, std::ios::beg);
+				in.read(&result[0], size);
+				in.close();
+			}
+		}
+		else
+		{
+			ZE_CORE_ERROR("Could not open file: '{0}'", filePath);
+		}
+
+		return result;
+	}
+
+	void ShaderPreprocessor::SetGlobalDefine(const std::string& name, const std::string& value)
+	{
+		s_GlobalDefines[name] = value;
+	}
+
+	std::string ShaderPreprocessor::GetDefinesKey(const ShaderDefines& defines)
+	{
+		std::string key;
+		for (auto& pair : defines)
+		{
+			if (!key.empty())
+			{
+				key += ';';
+			}
+			key += pair.first;
+			if (!pair.second.empty())
+			{
+				key += '=' + pair.second;
+			}
+		}
+		return key;
+	}
+
+	ShaderSources ShaderPreprocessor::SplitStages(const std::string& src)
+	{
+		ZE_PROFILE_FUNCTION();
+
+		ShaderSources shaderSrcs;
+
+		const char* typeToken = "#type";
+		size_t typeTokenLength = strlen(typeToken);
+		// Location of shader type
+		size_t typeTokenPos = src.find(typeToken, 0);
+		while (typeTokenPos != std::string::npos)
+		{
+			// End of line
+			size_t eol = src.find_first_of("\r\n", typeTokenPos);
+			ZE_CORE_ASSERT(eol != std::string::npos, "Syntax error!");
+
+			size_t typePos = typeTokenPos + typeTokenLength + 1;
+			// Get shader type
+			std::string type = src.substr(typePos, eol - typePos);
+
+			// Beginning of shader source: "#version..."
+			size_t shaderSrcPos = src.find_first_not_of("\r\n", eol);
+			// Locate the next shader type
+			typeTokenPos = src.find(typeToken, shaderSrcPos);
+			// Get shader source code
+			shaderSrcs[type]
+				= src.substr(shaderSrcPos, typeTokenPos - (shaderSrcPos == std::string::npos ? src.size() - 1 : shaderSrcPos));
+		}
+
+		return shaderSrcs;
+	}
+
+	std::string ShaderPreprocessor::ResolveIncludes(const std::string& src, const std::string& directory, std::unordered_set<std::string>& includedFiles)
+	{
+		const char* includeToken = "#include";
+		size_t includeTokenLength = strlen(includeToken);
+
+		std::string result;
+		result.reserve(src.size());
+		size_t lastPos = 0;
+		size_t includeTokenPos = src.find(includeToken, 0);
+		while (includeTokenPos != std::string::npos)
+		{
+			size_t eol = src.find_first_of("\r\n", includeTokenPos);
+			if (eol == std::string::npos)
+			{
+				eol = src.size();
+			}
+
+			// #include "Common.glsl"
+			size_t pathBegin = src.find('"', includeTokenPos + includeTokenLength);
+			size_t pathEnd = pathBegin == std::string::npos ? std::string::npos : src.find('"', pathBegin + 1);
+			ZE_CORE_ASSERT(pathEnd != std::string::npos && pathEnd < eol, "Syntax error! #include expects \"FILENAME\"");
+
+			result.append(src, lastPos, includeTokenPos - lastPos);
+
+			std::string includePath = directory + src.substr(pathBegin + 1, pathEnd - pathBegin - 1);
+			std::error_code error;
+			std::string canonicalPath = std::filesystem::weakly_canonical(includePath, error).string();
+			if (includedFiles.insert(error ? includePath : canonicalPath).second)
+			{
+				// Included files can include other files relative to themselves
+				result += ResolveIncludes(ReadFile(includePath), GetDirectory(includePath), includedFiles);
+			}
+
+			lastPos = eol;
+			includeTokenPos = src.find(includeToken, eol);
+		}
+		result.append(src, lastPos, std::string::npos);
+
+		return result;
+	}
+
+	std::string ShaderPreprocessor::InjectDefines(const std::string& src, const ShaderDefines& defines)
+	{
+		if (s_GlobalDefines.empty() && defines.empty())
+			return src;
+
+		// Variant defines take precedence over global ones
+		ShaderDefines allDefines = s_GlobalDefines;
+		for (auto& pair : defines)
+		{
+			allDefines[pair.first] = pair.second;
+		}
+
+		std::string defineBlock;
+		for (auto& pair : allDefines)
+		{
+			defineBlock += "#define " + pair.first + " " + pair.second + "\n";
+		}
+
+		size_t versionPos = src.find("#version");
+		if (versionPos == std::string::npos)
+			return defineBlock + src;
+
+		size_t eol = src.find_first_of("\r\n", versionPos);
+		if (eol == std::string::npos)
+			return src + "\n" + defineBlock;
+
+		size_t insertPos = src.find_first_not_of("\r\n", eol);
+		if (insertPos == std::string::npos)
+		{
+			insertPos = src.size();
+		}
+		std::string result = src;
+		result.insert(insertPos, defineBlock);
+		return result;
+	}
+
+}
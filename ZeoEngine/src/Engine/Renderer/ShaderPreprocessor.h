@@ -0,0 +1,48 @@
+#pragma once
+
+#include <map>
+
+namespace ZeoEngine {
+
+	/** A set of preprocessor definitions used to compile a shader variant. It is kept sorted so that equal sets always produce the same key. */
+	using ShaderDefines = std::map<std::string, std::string>;
+
+	/** Map from stage name to its source. */
+	using ShaderSources = std::unordered_map<std::string, std::string>;
+
+	/**
+	 * Graphics API independent preprocessing of shader source files.
+	 *
+	 * A source file contains one or more stages, each of which begins with a "#type <stage>" line
+	 * where stage can be "vertex", "fragment" (or "pixel"), "geometry" or "compute".
+	 * Every stage may use:
+	 * - #include "path": Path is relative to the including file, each file is included at most once per stage
+	 * - Engine-injected defines: @see SetGlobalDefine()
+	 * - Variant defines: Passed in when creating a shader variant, @see ShaderLibrary::Get()
+	 */
+	class ShaderPreprocessor
+	{
+	public:
+		/** Read the source file and returns processed sources keyed by stage names. This is safe to call from worker threads. */
+		static ShaderSources Process(const std::string& filePath, const ShaderDefines& defines = {});
+
+		static std::string ReadFile(const std::string& filePath);
+
+		/** Define a macro for all shaders compiled afterwards. This should be called during initialization only. */
+		static void SetGlobalDefine(const std::string& name, const std::string& value = "");
+
+		/** Returns a string which uniquely identifies the define set e.g. "A;B=2". */
+		static std::string GetDefinesKey(const ShaderDefines& defines);
+
+	private:
+		static ShaderSources SplitStages(const std::string& src);
+		static std::string ResolveIncludes(const std::string& src, const std::string& directory, std::unordered_set<std::string>& includedFiles);
+		/** Defines are inserted right after "#version" directive as GLSL requires it to come first. */
+		static std::string InjectDefines(const std::string& src, const ShaderDefines& defines);
+
+	private:
+		static ShaderDefines s_GlobalDefines;
+
+	};
+
+}
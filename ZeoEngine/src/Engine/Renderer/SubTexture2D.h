@@ -0,0 +1,37 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "Engine/Renderer/Texture.h"
+
+namespace ZeoEngine {
+
+	/**
+	 * A rectangular region of a Texture2D, e.g. a single frame or tile of a sprite sheet.
+	 * Sub textures of the same sheet share the underlying texture so they can be drawn in one batch.
+	 */
+	class SubTexture2D : public RefCounted
+	{
+	public:
+		/** Construct a sub texture from an explicit UV rect, both min and max are in the range of [0, 1]. */
+		SubTexture2D(const Ref<Texture2D>& texture, const glm::vec2& min, const glm::vec2& max);
+
+		const Ref<Texture2D>& GetTexture() const { return m_Texture; }
+		/** Returns four texture coordinates in the order of bottom left, bottom right, top right and top left. */
+		const glm::vec2* GetTexCoords() const { return m_TexCoords; }
+
+		/**
+		 * Create a sub texture from a grid sprite sheet.
+		 * @param coords - Cell coordinates of the sprite counted from the bottom left corner of the sheet
+		 * @param cellSize - Size of a single cell in pixels
+		 * @param spriteSize - Number of cells this sprite spans, which is used for sprites larger than a single cell
+		 */
+		static Ref<SubTexture2D> CreateFromCoords(const Ref<Texture2D>& texture, const glm::vec2& coords, const glm::vec2& cellSize, const glm::vec2& spriteSize = { 1.0f, 1.0f });
+
+	private:
+		Ref<Texture2D> m_Texture;
+		glm::vec2 m_TexCoords[4];
+
+	};
+
+}
@@ -3,10 +3,64 @@
 
 #include "Engine/Renderer/Renderer.h"
 #include "Platform/OpenGL/OpenGLTexture.h"
+#include "Engine/Renderer/HotReloader.h"
+
+#include <stb_image.h>
 
 namespace ZeoEngine {
+
+	ImageData ImageData::Load(const std::string& path)
+	{
+		ZE_PROFILE_FUNCTION();
+		ZE_MEMORY_TAG(Textures);
+
+		ImageData image;
+		// All textures are loaded flipped so setting this global flag from multiple threads is harmless
+		stbi_set_flip_vertically_on_load(1);
+		int width, height, channels;
+		stbi_uc* data = nullptr;
+		{
+			ZE_PROFILE_SCOPE("stbi_load - ImageData::Load(const std::string&)");
+
+			data = stbi_load(path.c_str(), &width, &height, &channels, 0);
+		}
+		if (!data)
+		{
+			ZE_CORE_ERROR("Failed to load image: '{0}'", path);
+			return image;
+		}
+
+		image.Width = width;
+		image.Height = height;
+		image.Channels = channels;
+		image.Pixels.assign(data, data + width * height * channels);
+
+		stbi_image_free(data);
+		return image;
+	}
+
+	bool ImageData::HasTranslucentPixels(const uint8_t* pixels, uint32_t pixelCount, uint32_t channels)
+	{
+		if (channels != 4)
+			return false;
+
+		for (uint32_t i = 0; i < pixelCount; ++i)
+		{
+			if (pixels[i * 4 + 3] != 0xff)
+				return true;
+		}
+		return false;
+	}
+
+	Texture2D::~Texture2D()
+	{
+		HotReloader::UnregisterTexture(this);
+	}
+
 	Ref<Texture2D> Texture2D::Create(uint32_t width, uint32_t height)
 	{
+		ZE_MEMORY_TAG(Textures);
+
 		switch (Renderer::GetAPI())
 		{
 		case RendererAPI::API::None:
@@ -22,13 +76,19 @@ namespace ZeoEngine {
 
 	Ref<Texture2D> Texture2D::Create(const std::string& path)
 	{
+		ZE_MEMORY_TAG(Textures);
+
 		switch (Renderer::GetAPI())
 		{
 		case RendererAPI::API::None:
 			ZE_CORE_ASSERT(false, "RendererAPI is currently not supported!");
 			return nullptr;
 		case RendererAPI::API::OpenGL:
-			return CreateRef<OpenGLTexture2D>(path);
+		{
+			Ref<Texture2D> texture = CreateRef<OpenGLTexture2D>(path);
+			HotReloader::RegisterTexture(texture.get(), path);
+			return texture;
+		}
 		default:
 			ZE_CORE_ASSERT(false, "Unknown RendererAPI!");
 			return nullptr;
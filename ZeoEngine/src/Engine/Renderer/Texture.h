@@ -4,7 +4,30 @@
 
 namespace ZeoEngine {
 
-	class Texture
+	/** Pixels of an image file decoded on CPU, which can be done on any thread. */
+	struct ImageData
+	{
+		uint32_t Width = 0, Height = 0;
+		uint32_t Channels = 0;
+		std::vector<uint8_t> Pixels;
+
+		bool IsValid() const { return !Pixels.empty(); }
+		/** Returns true if any pixel has an alpha below 255. */
+		bool HasTranslucentPixels() const { return HasTranslucentPixels(Pixels.data(), Width * Height, Channels); }
+
+		static bool HasTranslucentPixels(const uint8_t* pixels, uint32_t pixelCount, uint32_t channels);
+
+		/** Decode an image file, rows are flipped so that the first row is the bottom one as OpenGL expects. */
+		static ImageData Load(const std::string& path);
+	};
+
+	enum class TextureFilter
+	{
+		Nearest,
+		Linear,
+	};
+
+	class Texture : public RefCounted
 	{
 	public:
 		virtual ~Texture() = default;
@@ -16,11 +39,25 @@ namespace ZeoEngine {
 		virtual void SetData(void* data, uint32_t size) = 0;
 
 		virtual void Bind(uint32_t slot = 0) const = 0;
+
+		/** Sampling used when the texture is minified and magnified, defaults to linear and nearest. */
+		virtual void SetFilter(TextureFilter minFilter, TextureFilter magFilter) = 0;
+
+		/** Returns true if the texture has partially or fully transparent pixels, so that it needs blending. */
+		virtual bool IsTranslucent() const = 0;
+
+		/** Two textures are considered equal if they refer to the same GPU resource. */
+		virtual bool operator==(const Texture& other) const = 0;
 	};
 
 	class Texture2D : public Texture
 	{
 	public:
+		virtual ~Texture2D();
+
+		/** Replace contents with a newly decoded image, used for hot-reloading. */
+		virtual void Reload(const ImageData& image) = 0;
+
 		/** Used for constructing a texture from memory. */
 		static Ref<Texture2D> Create(uint32_t width, uint32_t height);
 		/** Used for loading a texture from disk. */
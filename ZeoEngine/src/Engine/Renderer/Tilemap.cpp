@@ -0,0 +1,144 @@
+#include "ZEpch.h"
+#include "Engine/Renderer/Tilemap.h"
+
+#include "Engine/Renderer/Renderer.h"
+#include "Engine/Core/FrameAllocator.h"
+
+namespace ZeoEngine {
+
+	// Corners are stored as unsigned shorts
+	static constexpr uint32_t s_MaxTilemapSize = 65535;
+
+	static uint32_t PackUShort2(uint32_t x, uint32_t y)
+	{
+		return x | (y << 16);
+	}
+
+	/** Map [0, 1] to a normalized unsigned short. */
+	static uint32_t PackUnorm16(float value)
+	{
+		return static_cast<uint32_t>(glm::clamp(value, 0.0f, 1.0f) * 65535.0f + 0.5f);
+	}
+
+	Tilemap::Tilemap(uint32_t width, uint32_t height, const Ref<Texture2D>& tileset, const glm::vec2& cellSize)
+		: m_Width(width), m_Height(height)
+		, m_ChunkCountX((width + ChunkSize - 1) / ChunkSize), m_ChunkCountY((height + ChunkSize - 1) / ChunkSize)
+		, m_Tileset(tileset)
+	{
+		ZE_PROFILE_FUNCTION();
+		ZE_MEMORY_TAG(Renderer);
+
+		ZE_CORE_ASSERT(width > 0 && height > 0 && width <= s_MaxTilemapSize && height <= s_MaxTilemapSize, "Invalid tilemap size!");
+
+		m_Chunks.resize(m_ChunkCountX * m_ChunkCountY);
+		for (auto& chunk : m_Chunks)
+		{
+			chunk.Tiles.fill(EmptyTile);
+		}
+
+		const uint32_t columnCount = static_cast<uint32_t>(tileset->GetWidth() / cellSize.x);
+		const uint32_t rowCount = static_cast<uint32_t>(tileset->GetHeight() / cellSize.y);
+		ZE_CORE_ASSERT(columnCount * rowCount < EmptyTile, "Too many cells in tileset!");
+		m_TileTexCoords.reserve(columnCount * rowCount);
+		for (uint32_t row = 0; row < rowCount; ++row)
+		{
+			for (uint32_t column = 0; column < columnCount; ++column)
+			{
+				const uint32_t minU = PackUnorm16(column * cellSize.x / tileset->GetWidth());
+				const uint32_t maxU = PackUnorm16((column + 1) * cellSize.x / tileset->GetWidth());
+				const uint32_t minV = PackUnorm16(row * cellSize.y / tileset->GetHeight());
+				const uint32_t maxV = PackUnorm16((row + 1) * cellSize.y / tileset->GetHeight());
+				m_TileTexCoords.push_back({ PackUShort2(minU, minV), PackUShort2(maxU, minV), PackUShort2(maxU, maxV), PackUShort2(minU, maxV) });
+			}
+		}
+	}
+
+	Ref<Tilemap> Tilemap::Create(uint32_t width, uint32_t height, const Ref<Texture2D>& tileset, const glm::vec2& cellSize)
+	{
+		return CreateRef<Tilemap>(width, height, tileset, cellSize);
+	}
+
+	uint16_t Tilemap::GetTile(uint32_t x, uint32_t y) const
+	{
+		ZE_CORE_ASSERT(x < m_Width && y < m_Height, "Tile is out of the tilemap!");
+
+		const Chunk& chunk = m_Chunks[(y / ChunkSize) * m_ChunkCountX + x / ChunkSize];
+		return chunk.Tiles[(y % ChunkSize) * ChunkSize + x % ChunkSize];
+	}
+
+	void Tilemap::SetTile(uint32_t x, uint32_t y, uint16_t tile)
+	{
+		ZE_CORE_ASSERT(x < m_Width && y < m_Height, "Tile is out of the tilemap!");
+		ZE_CORE_ASSERT(tile == EmptyTile || tile < GetTileCount(), "Tile is out of the tileset!");
+
+		Chunk& chunk = m_Chunks[(y / ChunkSize) * m_ChunkCountX + x / ChunkSize];
+		uint16_t& storedTile = chunk.Tiles[(y % ChunkSize) * ChunkSize + x % ChunkSize];
+		if (storedTile != tile)
+		{
+			storedTile = tile;
+			chunk.bDirty = true;
+		}
+	}
+
+	void Tilemap::Fill(uint16_t tile)
+	{
+		ZE_PROFILE_FUNCTION();
+		ZE_CORE_ASSERT(tile == EmptyTile || tile < GetTileCount(), "Tile is out of the tileset!");
+
+		for (uint32_t y = 0; y < m_Height; ++y)
+		{
+			for (uint32_t x = 0; x < m_Width; ++x)
+			{
+				SetTile(x, y, tile);
+			}
+		}
+	}
+
+	void Tilemap::RebuildChunk(uint32_t chunkX, uint32_t chunkY, Chunk& chunk)
+	{
+		ZE_PROFILE_FUNCTION();
+		ZE_MEMORY_TAG(Renderer);
+
+		chunk.bDirty = false;
+
+		TileVertex* vertices = FrameAllocator::NewArray<TileVertex>(ChunkSize * ChunkSize * 4);
+		uint32_t quadCount = 0;
+		// Tiles of edge chunks beyond the map size always stay empty
+		for (uint32_t y = 0; y < ChunkSize; ++y)
+		{
+			for (uint32_t x = 0; x < ChunkSize; ++x)
+			{
+				const uint16_t tile = chunk.Tiles[y * ChunkSize + x];
+				if (tile == EmptyTile)
+					continue;
+
+				const uint32_t tileX = chunkX * ChunkSize + x;
+				const uint32_t tileY = chunkY * ChunkSize + y;
+				const uint32_t corners[4] = {
+					PackUShort2(tileX, tileY), PackUShort2(tileX + 1, tileY), PackUShort2(tileX + 1, tileY + 1), PackUShort2(tileX, tileY + 1)
+				};
+				const std::array<uint32_t, 4>& texCoords = m_TileTexCoords[tile];
+				for (uint32_t k = 0; k < 4; ++k)
+				{
+					vertices[quadCount * 4 + k] = { corners[k], texCoords[k] };
+				}
+				++quadCount;
+			}
+		}
+
+		chunk.QuadCount = quadCount;
+		if (quadCount == 0)
+		{
+			chunk.VAO.reset();
+			return;
+		}
+
+		// Tiles rarely change, so a new static buffer of the exact size is created instead of keeping a dynamic one large enough for a full chunk
+		Ref<VertexBuffer> vertexBuffer = VertexBuffer::Create(vertices, quadCount * 4 * sizeof(TileVertex));
+		vertexBuffer->SetLayout(StaticBufferLayout<TileVertex>());
+		chunk.VAO = VertexArray::Create();
+		chunk.VAO->AddVertexBuffer(vertexBuffer);
+		chunk.VAO->SetIndexBuffer(Renderer::GetQuadIndexBuffer());
+	}
+
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "Engine/Renderer/Texture.h"
+#include "Engine/Renderer/VertexArray.h"
+#include "Engine/Renderer/Culling2D.h"
+
+namespace ZeoEngine {
+
+	/** 8 bytes, positions and texture coordinates of tiles are exact in 16 bits. */
+	struct TileVertex
+	{
+		/** Two unsigned shorts, corner in tile units of the whole tilemap */
+		uint32_t Position;
+		/** Two normalized unsigned shorts */
+		uint32_t TexCoord;
+	};
+
+	template<>
+	struct VertexLayout<TileVertex>
+	{
+		static constexpr BufferElement Elements[] = {
+			ZE_VERTEX_ELEMENT(TileVertex, Position, UShort2, "a_Position", false),
+			ZE_VERTEX_ELEMENT(TileVertex, TexCoord, UShort2, "a_TexCoord", true),
+		};
+	};
+
+	/**
+	 * A grid of tiles picked from a tileset, stored in chunks of ChunkSize x ChunkSize tiles.
+	 * Vertices of a chunk are built into a static GPU buffer the first time it is drawn and rebuilt only after its tiles have changed,
+	 * so drawing costs one draw call per visible chunk and no per-tile work. Tile (x, y) covers [x, x + 1] x [y, y + 1] in local space.
+	 */
+	class Tilemap : public RefCounted
+	{
+	public:
+		static constexpr uint32_t ChunkSize = 32;
+		/** Tile index of cells which are not drawn */
+		static constexpr uint16_t EmptyTile = 0xffff;
+
+		/**
+		 * @param tileset - Sprite sheet of equally sized cells, tile indices count cells row by row from the bottom left corner
+		 * @param cellSize - Size of a single cell in pixels
+		 */
+		Tilemap(uint32_t width, uint32_t height, const Ref<Texture2D>& tileset, const glm::vec2& cellSize);
+
+		uint32_t GetWidth() const { return m_Width; }
+		uint32_t GetHeight() const { return m_Height; }
+		const Ref<Texture2D>& GetTileset() const { return m_Tileset; }
+		/** Number of cells in the tileset */
+		uint32_t GetTileCount() const { return static_cast<uint32_t>(m_TileTexCoords.size()); }
+
+		uint16_t GetTile(uint32_t x, uint32_t y) const;
+		/** The chunk holding the tile will be rebuilt before it is drawn next time. */
+		void SetTile(uint32_t x, uint32_t y, uint16_t tile);
+		void Fill(uint16_t tile);
+
+		/**
+		 * Call func(vertexArray, quadCount) for every chunk with tiles intersecting bounds given in local space.
+		 * Chunks whose tiles have changed are rebuilt before being visited. Must be called from the thread owning the graphics context.
+		 */
+		template<typename Func>
+		void ForEachVisibleChunk(const Bounds2D& localBounds, Func func)
+		{
+			const Bounds2D mapBounds = { glm::vec2(0.0f), glm::vec2(m_Width, m_Height) };
+			if (!localBounds.Intersects(mapBounds))
+				return;
+
+			const glm::uvec2 minChunk = glm::uvec2(glm::max(localBounds.Min, mapBounds.Min)) / ChunkSize;
+			const glm::uvec2 maxChunk = glm::min(glm::uvec2(glm::min(localBounds.Max, mapBounds.Max)) / ChunkSize, glm::uvec2(m_ChunkCountX - 1, m_ChunkCountY - 1));
+			for (uint32_t chunkY = minChunk.y; chunkY <= maxChunk.y; ++chunkY)
+			{
+				for (uint32_t chunkX = minChunk.x; chunkX <= maxChunk.x; ++chunkX)
+				{
+					Chunk& chunk = m_Chunks[chunkY * m_ChunkCountX + chunkX];
+					if (chunk.bDirty)
+					{
+						RebuildChunk(chunkX, chunkY, chunk);
+					}
+					if (chunk.QuadCount > 0)
+					{
+						func(chunk.VAO, chunk.QuadCount);
+					}
+				}
+			}
+		}
+
+		static Ref<Tilemap> Create(uint32_t width, uint32_t height, const Ref<Texture2D>& tileset, const glm::vec2& cellSize);
+
+	private:
+		struct Chunk
+		{
+			std::array<uint16_t, ChunkSize * ChunkSize> Tiles;
+			/** Null while the chunk is empty */
+			Ref<VertexArray> VAO;
+			uint32_t QuadCount = 0;
+			bool bDirty = true;
+		};
+
+		void RebuildChunk(uint32_t chunkX, uint32_t chunkY, Chunk& chunk);
+
+	private:
+		uint32_t m_Width, m_Height;
+		uint32_t m_ChunkCountX, m_ChunkCountY;
+		std::vector<Chunk> m_Chunks;
+
+		Ref<Texture2D> m_Tileset;
+		/** Packed texture coordinates of the four corners of each tileset cell, in the order of the quad index buffer */
+		std::vector<std::array<uint32_t, 4>> m_TileTexCoords;
+	};
+
+}
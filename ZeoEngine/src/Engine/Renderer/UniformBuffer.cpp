@@ -0,0 +1,198 @@
+#include "ZEpch.h"
+#include "Engine/Renderer/UniformBuffer.h"
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include "Engine/Renderer/Renderer.h"
+
+#include "Platform/OpenGL/OpenGLUniformBuffer.h"
+
+namespace ZeoEngine {
+
+	static uint32_t AlignUp(uint32_t value, uint32_t alignment)
+	{
+		return (value + alignment - 1) / alignment * alignment;
+	}
+
+	/** Returns base alignment and size of a single (non-array) member according to std140 rules. */
+	static void GetStd140AlignmentAndSize(ShaderDataType type, uint32_t& outAlignment, uint32_t& outSize)
+	{
+		switch (type)
+		{
+		case ShaderDataType::Float:
+		case ShaderDataType::Int:
+		// Booleans occupy a full machine word in uniform blocks
+		case ShaderDataType::Bool:
+			outAlignment = 4; outSize = 4;
+			return;
+		case ShaderDataType::Float2:
+		case ShaderDataType::Int2:
+			outAlignment = 8; outSize = 8;
+			return;
+		case ShaderDataType::Float3:
+		case ShaderDataType::Int3:
+			outAlignment = 16; outSize = 12;
+			return;
+		case ShaderDataType::Float4:
+		case ShaderDataType::Int4:
+			outAlignment = 16; outSize = 16;
+			return;
+		// Matrices are stored as arrays of column vectors, each padded to a vec4
+		case ShaderDataType::Mat3:
+			outAlignment = 16; outSize = 16 * 3;
+			return;
+		case ShaderDataType::Mat4:
+			outAlignment = 16; outSize = 16 * 4;
+			return;
+		// Packed formats only exist as vertex attributes
+		case ShaderDataType::UByte4:
+		case ShaderDataType::Half:
+		case ShaderDataType::Half2:
+		case ShaderDataType::Half4:
+		case ShaderDataType::Short2:
+		case ShaderDataType::UShort2:
+		case ShaderDataType::Int10_10_10_2:
+			ZE_CORE_ASSERT(false, "Packed ShaderDataType cannot be used in uniform blocks!");
+			outAlignment = 4; outSize = 0;
+			return;
+		default:
+			ZE_CORE_ASSERT(false, "Unknown ShaderDataType!");
+			outAlignment = 4; outSize = 0;
+			return;
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// UniformBufferLayout ///////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////////
+
+	void UniformBufferLayout::CalculateOffsetsAndSize()
+	{
+		uint32_t offset = 0;
+		for (auto& element : m_Elements)
+		{
+			uint32_t alignment, size;
+			GetStd140AlignmentAndSize(element.Type, alignment, size);
+			if (element.Count > 1)
+			{
+				// Array elements are aligned to vec4, which makes their stride a multiple of 16 bytes
+				alignment = 16;
+				size = AlignUp(size, 16) * element.Count;
+			}
+
+			element.Offset = AlignUp(offset, alignment);
+			element.Size = size;
+			offset = element.Offset + size;
+		}
+		m_Size = AlignUp(offset, 16);
+	}
+
+	const UniformElement* UniformBufferLayout::FindElement(const std::string& name) const
+	{
+		for (const auto& element : m_Elements)
+		{
+			if (element.Name == name)
+				return &element;
+		}
+		return nullptr;
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// UniformBlock //////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////////
+
+	UniformBlock::UniformBlock(const UniformBufferLayout& layout)
+		: m_Layout(layout)
+		, m_Data(layout.GetSize(), 0)
+	{
+	}
+
+	void UniformBlock::SetInt(const std::string& name, int32_t value)
+	{
+		Write(name, ShaderDataType::Int, &value, sizeof(value));
+	}
+
+	void UniformBlock::SetFloat(const std::string& name, float value)
+	{
+		Write(name, ShaderDataType::Float, &value, sizeof(value));
+	}
+
+	void UniformBlock::SetFloat2(const std::string& name, const glm::vec2& value)
+	{
+		Write(name, ShaderDataType::Float2, glm::value_ptr(value), sizeof(float) * 2);
+	}
+
+	void UniformBlock::SetFloat3(const std::string& name, const glm::vec3& value)
+	{
+		Write(name, ShaderDataType::Float3, glm::value_ptr(value), sizeof(float) * 3);
+	}
+
+	void UniformBlock::SetFloat4(const std::string& name, const glm::vec4& value)
+	{
+		Write(name, ShaderDataType::Float4, glm::value_ptr(value), sizeof(float) * 4);
+	}
+
+	void UniformBlock::SetMat4(const std::string& name, const glm::mat4& value)
+	{
+		Write(name, ShaderDataType::Mat4, glm::value_ptr(value), sizeof(float) * 16);
+	}
+
+	void UniformBlock::Write(const std::string& name, ShaderDataType type, const void* data, uint32_t size)
+	{
+		const UniformElement* element = m_Layout.FindElement(name);
+		if (!element)
+		{
+			ZE_CORE_WARN("Uniform '{0}' does not exist in block!", name);
+			return;
+		}
+
+		ZE_CORE_ASSERT(element->Type == type, "Uniform type mismatch!");
+		memcpy(m_Data.data() + element->Offset, data, size);
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// UniformBuffer /////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////////
+
+	Ref<UniformBuffer> UniformBuffer::Create(uint32_t size, UniformBufferBinding binding)
+	{
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::None:
+			ZE_CORE_ASSERT(false, "RendererAPI is currently not supported!");
+			return nullptr;
+		case RendererAPI::API::OpenGL:
+			return CreateRef<OpenGLUniformBuffer>(size, binding);
+		default:
+			ZE_CORE_ASSERT(false, "Unknown RendererAPI!");
+			return nullptr;
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// UniformBufferRing /////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////////
+
+	UniformBufferRing::UniformBufferRing(uint32_t size)
+		: m_Size(size)
+		, m_Alignment(RenderCommand::GetUniformBufferOffsetAlignment())
+	{
+		// Ranges are bound explicitly, so the buffer's own binding point is never used
+		m_Buffer = UniformBuffer::Create(size, UniformBufferBinding::Draw);
+	}
+
+	void UniformBufferRing::Push(UniformBufferBinding binding, const void* data, uint32_t size)
+	{
+		ZE_CORE_ASSERT(size <= m_Size, "Data does not fit into uniform buffer ring!");
+
+		if (m_Head + size > m_Size)
+		{
+			m_Head = 0;
+		}
+
+		m_Buffer->SetData(data, size, m_Head);
+		m_Buffer->BindRange(binding, m_Head, size);
+		m_Head = AlignUp(m_Head + size, m_Alignment);
+	}
+
+}
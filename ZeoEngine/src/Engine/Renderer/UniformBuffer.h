@@ -0,0 +1,127 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "Engine/Renderer/Buffer.h"
+
+namespace ZeoEngine {
+
+	/** Binding points of uniform blocks shared between the engine and shaders. These must match the ones declared in assets/shaders/include. */
+	enum class UniformBufferBinding : uint32_t
+	{
+		Camera = 0,
+		Draw = 1,
+		Material = 2,
+	};
+
+	struct UniformElement
+	{
+		std::string Name;
+		ShaderDataType Type;
+		/** Number of array elements, 1 for non-array members */
+		uint32_t Count;
+		uint32_t Offset;
+		/** Size including std140 padding */
+		uint32_t Size;
+
+		UniformElement(ShaderDataType type, const std::string& name, uint32_t count = 1)
+			: Name(name), Type(type), Count(count), Offset(0), Size(0)
+		{
+		}
+
+	};
+
+	/** Computes member offsets of a uniform block following std140 rules, so that data written on CPU matches what shaders read. */
+	class UniformBufferLayout
+	{
+	public:
+		UniformBufferLayout() = default;
+		UniformBufferLayout(const std::initializer_list<UniformElement>& elements)
+			: m_Elements(elements)
+		{
+			CalculateOffsetsAndSize();
+		}
+
+		inline const std::vector<UniformElement>& GetElements() const { return m_Elements; }
+		/** Size of the whole block, rounded up to a multiple of 16 bytes. */
+		inline uint32_t GetSize() const { return m_Size; }
+
+		const UniformElement* FindElement(const std::string& name) const;
+
+	private:
+		void CalculateOffsetsAndSize();
+
+	private:
+		std::vector<UniformElement> m_Elements;
+		uint32_t m_Size = 0;
+
+	};
+
+	/** CPU copy of a uniform block laid out in std140, e.g. material parameters which are pushed along with a draw call. */
+	class UniformBlock
+	{
+	public:
+		UniformBlock() = default;
+		UniformBlock(const UniformBufferLayout& layout);
+
+		void SetInt(const std::string& name, int32_t value);
+		void SetFloat(const std::string& name, float value);
+		void SetFloat2(const std::string& name, const glm::vec2& value);
+		void SetFloat3(const std::string& name, const glm::vec3& value);
+		void SetFloat4(const std::string& name, const glm::vec4& value);
+		void SetMat4(const std::string& name, const glm::mat4& value);
+
+		inline const UniformBufferLayout& GetLayout() const { return m_Layout; }
+		inline const void* GetData() const { return m_Data.data(); }
+		inline uint32_t GetSize() const { return static_cast<uint32_t>(m_Data.size()); }
+
+	private:
+		void Write(const std::string& name, ShaderDataType type, const void* data, uint32_t size);
+
+	private:
+		UniformBufferLayout m_Layout;
+		std::vector<uint8_t> m_Data;
+
+	};
+
+	/** Uniform buffers are only referenced by renderers on the thread owning the graphics context, so a non-atomic counter is used. */
+	class UniformBuffer : public LocalRefCounted
+	{
+	public:
+		virtual ~UniformBuffer() = default;
+
+		/** Upload data to the given byte offset of the buffer. */
+		virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) = 0;
+
+		/** Bind the whole buffer to the binding point specified on creation. */
+		virtual void Bind() const = 0;
+		/** Bind a range of the buffer to a binding point. Offset must be a multiple of RenderCommand::GetUniformBufferOffsetAlignment(). */
+		virtual void BindRange(UniformBufferBinding binding, uint32_t offset, uint32_t size) const = 0;
+
+		virtual uint32_t GetSize() const = 0;
+
+		static Ref<UniformBuffer> Create(uint32_t size, UniformBufferBinding binding);
+	};
+
+	/**
+	 * A large uniform buffer which hands out consecutive ranges for data that changes every draw call.
+	 * Writes go to a fresh range instead of overwriting the one the previous draw call reads from,
+	 * which lets the driver keep pipelining, and wrap around to the beginning once the end is reached.
+	 */
+	class UniformBufferRing
+	{
+	public:
+		UniformBufferRing(uint32_t size);
+
+		/** Copy data into the next free range and bind that range to the binding point. */
+		void Push(UniformBufferBinding binding, const void* data, uint32_t size);
+
+	private:
+		Ref<UniformBuffer> m_Buffer;
+		uint32_t m_Size;
+		uint32_t m_Alignment;
+		uint32_t m_Head = 0;
+
+	};
+
+}
@@ -4,7 +4,7 @@
 
 namespace ZeoEngine {
 
-	class VertexArray
+	class VertexArray : public RefCounted
 	{
 	public:
 		virtual ~VertexArray() = default;
@@ -0,0 +1,161 @@
+#include "ZEpch.h"
+#include "Engine/Renderer/VertexPacking.h"
+
+#ifdef ZE_SIMD_SSE
+	#include <immintrin.h>
+#endif // ZE_SIMD_SSE
+
+namespace ZeoEngine {
+
+	static uint32_t FloatBits(float value)
+	{
+		uint32_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+		return bits;
+	}
+
+	static float BitsToFloat(uint32_t bits)
+	{
+		float value;
+		memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+
+	// Half conversions are done in the integer domain, see "Branch-free float to half conversion" by Fabian Giesen.
+	// Constants are shared by the scalar and SSE2 paths so that both give identical results
+
+	/** Smallest float magnitude which rounds to infinity */
+	static constexpr uint32_t s_HalfOverflow = (127 + 16) << 23;
+	/** Smallest float magnitude which converts to a normalized half */
+	static constexpr uint32_t s_HalfMinNormal = (127 - 14) << 23;
+	/** Adding this as a float shifts the mantissa of small values into place for a denormalized half, rounding in hardware */
+	static constexpr uint32_t s_HalfDenormMagic = ((127 - 15) + (23 - 10) + 1) << 23;
+	/** Rebias the exponent and add rounding for the 13 mantissa bits being dropped */
+	static constexpr uint32_t s_HalfNormalBias = 0xfff - ((127 - 15) << 23);
+
+	uint16_t VertexPacking::FloatToHalf(float value)
+	{
+		uint32_t bits = FloatBits(value);
+		const uint32_t sign = bits & 0x80000000u;
+		bits ^= sign;
+
+		uint32_t half;
+		if (bits >= s_HalfOverflow)
+		{
+			// Infinity or quiet NaN
+			half = bits > 0x7f800000u ? 0x7e00 : 0x7c00;
+		}
+		else if (bits < s_HalfMinNormal)
+		{
+			half = FloatBits(BitsToFloat(bits) + BitsToFloat(s_HalfDenormMagic)) - s_HalfDenormMagic;
+		}
+		else
+		{
+			// Ties go to the even mantissa
+			const uint32_t mantissaOdd = (bits >> 13) & 1;
+			half = (bits + s_HalfNormalBias + mantissaOdd) >> 13;
+		}
+		return static_cast<uint16_t>(half | (sign >> 16));
+	}
+
+	float VertexPacking::HalfToFloat(uint16_t value)
+	{
+		constexpr uint32_t shiftedExponent = 0x7c00 << 13;
+
+		uint32_t bits = (value & 0x7fffu) << 13;
+		const uint32_t exponent = bits & shiftedExponent;
+		bits += (127 - 15) << 23;
+
+		if (exponent == shiftedExponent)
+		{
+			// Infinity or NaN
+			bits += (128 - 16) << 23;
+		}
+		else if (exponent == 0)
+		{
+			// Zero or denormalized, renormalize in floating point
+			bits += 1 << 23;
+			bits = FloatBits(BitsToFloat(bits) - BitsToFloat(113 << 23));
+		}
+		return BitsToFloat(bits | (static_cast<uint32_t>(value & 0x8000u) << 16));
+	}
+
+#if defined(ZE_SIMD_SSE) && !defined(ZE_SIMD_F16C)
+	/** Same as FloatToHalf() for four values, returned in the low 16 bits of each 32-bit lane with the sign extended. */
+	static __m128i FloatToHalfSSE2(__m128 values)
+	{
+		const __m128 sign = _mm_and_ps(values, _mm_castsi128_ps(_mm_set1_epi32(static_cast<int32_t>(0x80000000u))));
+		const __m128 absValues = _mm_xor_ps(values, sign);
+		const __m128i bits = _mm_castps_si128(absValues);
+
+		const __m128i bNaN = _mm_castps_si128(_mm_cmpunord_ps(absValues, absValues));
+		const __m128i bRegular = _mm_cmpgt_epi32(_mm_set1_epi32(s_HalfOverflow), bits);
+		const __m128i bDenormal = _mm_cmpgt_epi32(_mm_set1_epi32(s_HalfMinNormal), bits);
+		const __m128i infOrNaN = _mm_or_si128(_mm_and_si128(bNaN, _mm_set1_epi32(0x200)), _mm_set1_epi32(0x7c00));
+
+		const __m128i denormMagic = _mm_set1_epi32(s_HalfDenormMagic);
+		const __m128i denormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(absValues, _mm_castsi128_ps(denormMagic))), denormMagic);
+
+		// Move the lowest kept mantissa bit into the sign bit and smear it to get -1 for odd mantissas
+		const __m128i mantissaOdd = _mm_srai_epi32(_mm_slli_epi32(bits, 31 - 13), 31);
+		const __m128i normal = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(bits, _mm_set1_epi32(s_HalfNormalBias)), mantissaOdd), 13);
+
+		const __m128i finite = _mm_or_si128(_mm_and_si128(bDenormal, denormal), _mm_andnot_si128(bDenormal, normal));
+		const __m128i half = _mm_or_si128(_mm_and_si128(bRegular, finite), _mm_andnot_si128(bRegular, infOrNaN));
+		// Arithmetic shift keeps negative results negative so that signed saturation while packing preserves their low 16 bits
+		return _mm_or_si128(half, _mm_srai_epi32(_mm_castps_si128(sign), 16));
+	}
+#endif
+
+	void VertexPacking::FloatsToHalves(const float* values, uint32_t count, uint16_t* outHalves)
+	{
+		uint32_t i = 0;
+#if defined(ZE_SIMD_F16C)
+		for (; i + 8 <= count; i += 8)
+		{
+			const __m128i halves = _mm256_cvtps_ph(_mm256_loadu_ps(values + i), _MM_FROUND_TO_NEAREST_INT);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(outHalves + i), halves);
+		}
+#elif defined(ZE_SIMD_SSE)
+		for (; i + 8 <= count; i += 8)
+		{
+			const __m128i low = FloatToHalfSSE2(_mm_loadu_ps(values + i));
+			const __m128i high = FloatToHalfSSE2(_mm_loadu_ps(values + i + 4));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(outHalves + i), _mm_packs_epi32(low, high));
+		}
+#endif
+		for (; i < count; ++i)
+		{
+			outHalves[i] = FloatToHalf(values[i]);
+		}
+	}
+
+	void VertexPacking::HalvesToFloats(const uint16_t* halves, uint32_t count, float* outValues)
+	{
+		uint32_t i = 0;
+#if defined(ZE_SIMD_F16C)
+		for (; i + 8 <= count; i += 8)
+		{
+			const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(halves + i));
+			_mm256_storeu_ps(outValues + i, _mm256_cvtph_ps(packed));
+		}
+#endif
+		for (; i < count; ++i)
+		{
+			outValues[i] = HalfToFloat(halves[i]);
+		}
+	}
+
+	uint32_t VertexPacking::PackSnorm10_10_10_2(const glm::vec4& value)
+	{
+		const glm::vec4 clamped = glm::clamp(value, -1.0f, 1.0f);
+		const int32_t x = static_cast<int32_t>(std::round(clamped.x * 511.0f));
+		const int32_t y = static_cast<int32_t>(std::round(clamped.y * 511.0f));
+		const int32_t z = static_cast<int32_t>(std::round(clamped.z * 511.0f));
+		const int32_t w = static_cast<int32_t>(std::round(clamped.w));
+		// Two's complement fields from the lowest bit up, as read by GL_INT_2_10_10_10_REV
+		return (static_cast<uint32_t>(x) & 0x3ffu) | ((static_cast<uint32_t>(y) & 0x3ffu) << 10) |
+			((static_cast<uint32_t>(z) & 0x3ffu) << 20) | ((static_cast<uint32_t>(w) & 0x3u) << 30);
+	}
+
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace ZeoEngine {
+
+	/** Conversions into the compact vertex attribute formats of ShaderDataType. */
+	class VertexPacking
+	{
+	public:
+		/** Convert to IEEE 754 half precision, rounding to nearest even. Values too large become infinity. */
+		static uint16_t FloatToHalf(float value);
+		static float HalfToFloat(uint16_t value);
+
+		/** Convert many values at once, using F16C or SSE2 if available. */
+		static void FloatsToHalves(const float* values, uint32_t count, uint16_t* outHalves);
+		static void HalvesToFloats(const uint16_t* halves, uint32_t count, float* outValues);
+
+		/** Two halves packed in memory order, matching ShaderDataType::Half2. */
+		static uint32_t PackHalf2(const glm::vec2& value)
+		{
+			return static_cast<uint32_t>(FloatToHalf(value.x)) | (static_cast<uint32_t>(FloatToHalf(value.y)) << 16);
+		}
+
+		/** Clamp to [0, 1] and pack as RGBA8 in memory order, matching a normalized ShaderDataType::UByte4. */
+		static uint32_t PackColor(const glm::vec4& color)
+		{
+			const glm::vec4 scaled = glm::clamp(color, 0.0f, 1.0f) * 255.0f + 0.5f;
+			return static_cast<uint32_t>(scaled.r) | (static_cast<uint32_t>(scaled.g) << 8) |
+				(static_cast<uint32_t>(scaled.b) << 16) | (static_cast<uint32_t>(scaled.a) << 24);
+		}
+
+		/** Clamp to [-1, 1] and pack xyz into 10 bits each and w into 2 bits, matching a normalized ShaderDataType::Int10_10_10_2. */
+		static uint32_t PackSnorm10_10_10_2(const glm::vec4& value);
+	};
+
+}
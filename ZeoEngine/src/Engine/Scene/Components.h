@@ -0,0 +1,159 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "Engine/Renderer/OrthographicCamera.h"
+#include "Engine/Renderer/Texture.h"
+#include "Engine/Renderer/SubTexture2D.h"
+#include "Engine/Renderer/Tilemap.h"
+#include "Engine/Scene/Registry.h"
+#include "Engine/Physics/PhysicsWorld2D.h"
+
+namespace ZeoEngine {
+
+	struct TagComponent
+	{
+		std::string Name;
+	};
+
+	/**
+	 * Local translation/rotation/scale of an entity relative to its parent, together with cached matrices.
+	 * Setters mark the transform dirty and Scene recomputes matrices only for dirty transforms and the subtrees below them.
+	 * Hierarchy links are managed through Scene::SetParent().
+	 */
+	class TransformComponent
+	{
+		friend class Scene;
+
+	public:
+		TransformComponent() = default;
+		TransformComponent(const glm::vec3& translation, float rotation = 0.0f, const glm::vec2& scale = glm::vec2(1.0f))
+			: m_Translation(translation), m_Rotation(rotation), m_Scale(scale)
+		{
+		}
+
+		const glm::vec3& GetTranslation() const { return m_Translation; }
+		void SetTranslation(const glm::vec3& translation) { m_Translation = translation; m_bLocalDirty = true; }
+		/** In radians, in the anti-clockwise direction */
+		float GetRotation() const { return m_Rotation; }
+		void SetRotation(float rotation) { m_Rotation = rotation; m_bLocalDirty = true; }
+		const glm::vec2& GetScale() const { return m_Scale; }
+		void SetScale(const glm::vec2& scale) { m_Scale = scale; m_bLocalDirty = true; }
+
+		/** Cached matrices are updated once per frame by Scene before rendering. */
+		const glm::mat4& GetLocalTransform() const { return m_LocalTransform; }
+		const glm::mat4& GetWorldTransform() const { return m_WorldTransform; }
+		/** Returns true if the world transform has been recomputed during the last update. */
+		bool HasWorldTransformChanged() const { return m_bWorldChanged; }
+
+		EntityId GetParent() const { return m_Parent; }
+		/** Returns 0 for root entities. */
+		uint32_t GetDepth() const { return m_Depth; }
+
+		/** Equivalent to translate * rotate(z) * scale, composed directly instead of multiplying three matrices. */
+		static glm::mat4 ComposeTransform(const glm::vec3& translation, float rotation, const glm::vec2& scale)
+		{
+			const float c = glm::cos(rotation);
+			const float s = glm::sin(rotation);
+			return glm::mat4(
+				glm::vec4(c * scale.x, s * scale.x, 0.0f, 0.0f),
+				glm::vec4(-s * scale.y, c * scale.y, 0.0f, 0.0f),
+				glm::vec4(0.0f, 0.0f, 1.0f, 0.0f),
+				glm::vec4(translation, 1.0f));
+		}
+
+	private:
+		glm::vec3 m_Translation{ 0.0f };
+		float m_Rotation = 0.0f;
+		glm::vec2 m_Scale{ 1.0f };
+
+		glm::mat4 m_LocalTransform{ 1.0f };
+		glm::mat4 m_WorldTransform{ 1.0f };
+
+		EntityId m_Parent = NullEntityId;
+		EntityId m_FirstChild = NullEntityId;
+		EntityId m_PrevSibling = NullEntityId;
+		EntityId m_NextSibling = NullEntityId;
+		uint32_t m_Depth = 0;
+		/** Position of the parent in the transform pool, cached while the pool layout stays the same */
+		uint32_t m_ParentIndex = NullEntityId;
+
+		bool m_bLocalDirty = true;
+		bool m_bWorldChanged = false;
+	};
+
+	struct SpriteRendererComponent
+	{
+		glm::vec4 Color{ 1.0f };
+		/** If SubTexture is set, it takes precedence over Texture */
+		Ref<Texture2D> Texture;
+		Ref<SubTexture2D> SubTexture;
+		float TilingFactor = 1.0f;
+	};
+
+	/** Tiles are one unit in size before the entity transform is applied, with the origin at the bottom left corner of the map. */
+	struct TilemapComponent
+	{
+		Ref<Tilemap> Map;
+		glm::vec4 TintColor{ 1.0f };
+	};
+
+	/**
+	 * Simulated by the physics world of the scene together with a BoxCollider2DComponent or CircleCollider2DComponent on the same entity.
+	 * The body drives the translation and rotation of the entity, which should be a root entity.
+	 * Component values and the transform are read when the body is created, remove and add the component again to apply changes.
+	 */
+	struct Rigidbody2DComponent
+	{
+		BodyType2D Type = BodyType2D::Static;
+		bool bFixedRotation = false;
+
+		BodyId2D RuntimeBody = NullBodyId2D;
+		/** Collider offset scaled by the entity, kept to map the body position back to the entity */
+		glm::vec2 RuntimeShapeOffset{ 0.0f };
+	};
+
+	/** Sizes are in local units and scaled by the entity, the defaults fit a sprite. */
+	struct BoxCollider2DComponent
+	{
+		glm::vec2 Offset{ 0.0f };
+		/** Half extents */
+		glm::vec2 Size{ 0.5f };
+
+		float Density = 1.0f;
+		float Friction = 0.5f;
+		float Restitution = 0.0f;
+	};
+
+	/** Used if the entity has no BoxCollider2DComponent, the radius is scaled by the larger scale of the entity. */
+	struct CircleCollider2DComponent
+	{
+		glm::vec2 Offset{ 0.0f };
+		float Radius = 0.5f;
+
+		float Density = 1.0f;
+		float Friction = 0.5f;
+		float Restitution = 0.0f;
+	};
+
+	struct CameraComponent
+	{
+		OrthographicCamera Camera{ -1.0f, 1.0f, -1.0f, 1.0f };
+		/** Half of the vertical extent of the view in world units */
+		float ZoomLevel = 1.0f;
+		/** Only the primary camera is used to render the scene */
+		bool bPrimary = true;
+		/** If true, the projection is not updated on viewport resize */
+		bool bFixedAspectRatio = false;
+
+		void SetViewportSize(uint32_t width, uint32_t height)
+		{
+			if (width == 0 || height == 0)
+				return;
+
+			const float aspectRatio = static_cast<float>(width) / static_cast<float>(height);
+			Camera.SetProjection(-aspectRatio * ZoomLevel, aspectRatio * ZoomLevel, -ZoomLevel, ZoomLevel);
+		}
+	};
+
+}
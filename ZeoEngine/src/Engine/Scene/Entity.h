@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Engine/Scene/Scene.h"
+
+namespace ZeoEngine {
+
+	/** Lightweight handle pairing an EntityId with the Scene it lives in. It is meant to be passed by value. */
+	class Entity
+	{
+	public:
+		Entity() = default;
+		Entity(EntityId entityId, Scene* scene)
+			: m_EntityId(entityId), m_Scene(scene)
+		{
+		}
+
+		template<typename T, typename... Args>
+		T& AddComponent(Args&&... args)
+		{
+			ZE_CORE_ASSERT(!HasComponent<T>(), "Entity already has component!");
+			return m_Scene->m_Registry.AddComponent<T>(m_EntityId, std::forward<Args>(args)...);
+		}
+
+		template<typename T>
+		T& GetComponent()
+		{
+			ZE_CORE_ASSERT(HasComponent<T>(), "Entity does not have component!");
+			return m_Scene->m_Registry.GetComponent<T>(m_EntityId);
+		}
+
+		template<typename T>
+		bool HasComponent()
+		{
+			return m_Scene->m_Registry.HasComponents<T>(m_EntityId);
+		}
+
+		template<typename T>
+		void RemoveComponent()
+		{
+			ZE_CORE_ASSERT(HasComponent<T>(), "Entity does not have component!");
+			m_Scene->m_Registry.RemoveComponent<T>(m_EntityId);
+		}
+
+		EntityId GetId() const { return m_EntityId; }
+		Scene* GetScene() const { return m_Scene; }
+
+		/** Returns false for null entities and entities which have been destroyed. */
+		bool IsValid() const { return m_Scene && m_Scene->m_Registry.IsValid(m_EntityId); }
+		operator bool() const { return IsValid(); }
+
+		bool operator==(const Entity& other) const { return m_EntityId == other.m_EntityId && m_Scene == other.m_Scene; }
+		bool operator!=(const Entity& other) const { return !(*this == other); }
+
+	private:
+		EntityId m_EntityId = NullEntityId;
+		Scene* m_Scene = nullptr;
+	};
+
+}
@@ -0,0 +1,145 @@
+#include "ZEpch.h"
+#include "Engine/Scene/LooseQuadtree.h"
+
+namespace ZeoEngine {
+
+	LooseQuadtree::LooseQuadtree(const Bounds2D& worldBounds, uint32_t maxDepth)
+		: m_WorldBounds(worldBounds), m_MaxDepth(maxDepth)
+	{
+		// Query() uses a fixed size traversal stack
+		ZE_CORE_ASSERT(maxDepth <= 16, "Quadtree is too deep!");
+
+		Clear();
+	}
+
+	void LooseQuadtree::Clear()
+	{
+		m_Nodes.clear();
+		m_Items.clear();
+		m_FreeSlots.clear();
+		m_Slots.clear();
+
+		Node root;
+		root.Center = 0.5f * (m_WorldBounds.Min + m_WorldBounds.Max);
+		const glm::vec2 halfExtent = 0.5f * (m_WorldBounds.Max - m_WorldBounds.Min);
+		root.HalfSize = glm::max(halfExtent.x, halfExtent.y);
+		m_Nodes.push_back(std::move(root));
+	}
+
+	uint32_t LooseQuadtree::FindNode(const Bounds2D& bounds)
+	{
+		const glm::vec2 center = 0.5f * (bounds.Min + bounds.Max);
+		const glm::vec2 halfExtent = 0.5f * (bounds.Max - bounds.Min);
+		const float radius = glm::max(halfExtent.x, halfExtent.y);
+
+		const Node& root = m_Nodes[0];
+		if (glm::abs(center.x - root.Center.x) > root.HalfSize || glm::abs(center.y - root.Center.y) > root.HalfSize)
+			return 0;
+
+		uint32_t nodeIndex = 0;
+		for (uint32_t depth = 0; depth < m_MaxDepth; ++depth)
+		{
+			const float childHalfSize = 0.5f * m_Nodes[nodeIndex].HalfSize;
+			// A child can hold the object only if it does not stick out of the loose bounds of the child
+			if (radius > childHalfSize)
+				break;
+
+			const glm::vec2 nodeCenter = m_Nodes[nodeIndex].Center;
+			const uint32_t quadrant = (center.x >= nodeCenter.x ? 1 : 0) | (center.y >= nodeCenter.y ? 2 : 0);
+			uint32_t childIndex = m_Nodes[nodeIndex].Children[quadrant];
+			if (childIndex == InvalidNode)
+			{
+				Node child;
+				child.Center = nodeCenter + glm::vec2(quadrant & 1 ? childHalfSize : -childHalfSize, quadrant & 2 ? childHalfSize : -childHalfSize);
+				child.HalfSize = childHalfSize;
+				child.Parent = nodeIndex;
+				childIndex = static_cast<uint32_t>(m_Nodes.size());
+				// Taking references into m_Nodes is not safe across this push_back
+				m_Nodes.push_back(std::move(child));
+				m_Nodes[nodeIndex].Children[quadrant] = childIndex;
+			}
+			nodeIndex = childIndex;
+		}
+		return nodeIndex;
+	}
+
+	void LooseQuadtree::AddToNode(uint32_t slot, uint32_t nodeIndex)
+	{
+		Item& item = m_Items[slot];
+		Node& node = m_Nodes[nodeIndex];
+		item.Node = nodeIndex;
+		item.IndexInNode = static_cast<uint32_t>(node.Items.size());
+		node.Items.push_back(slot);
+
+		for (uint32_t index = nodeIndex; index != InvalidNode; index = m_Nodes[index].Parent)
+		{
+			++m_Nodes[index].SubtreeCount;
+		}
+	}
+
+	void LooseQuadtree::RemoveFromNode(uint32_t slot)
+	{
+		const Item& item = m_Items[slot];
+		Node& node = m_Nodes[item.Node];
+		const uint32_t lastSlot = node.Items.back();
+		node.Items[item.IndexInNode] = lastSlot;
+		m_Items[lastSlot].IndexInNode = item.IndexInNode;
+		node.Items.pop_back();
+
+		for (uint32_t index = item.Node; index != InvalidNode; index = m_Nodes[index].Parent)
+		{
+			--m_Nodes[index].SubtreeCount;
+		}
+	}
+
+	void LooseQuadtree::Insert(EntityId entity, const Bounds2D& bounds)
+	{
+		ZE_CORE_ASSERT(!Contains(entity), "Entity already exists in quadtree!");
+
+		uint32_t slot;
+		if (!m_FreeSlots.empty())
+		{
+			slot = m_FreeSlots.back();
+			m_FreeSlots.pop_back();
+		}
+		else
+		{
+			slot = static_cast<uint32_t>(m_Items.size());
+			m_Items.emplace_back();
+		}
+
+		m_Items[slot].Entity = entity;
+		m_Items[slot].Bounds = bounds;
+		m_Slots[entity] = slot;
+		AddToNode(slot, FindNode(bounds));
+	}
+
+	void LooseQuadtree::Update(EntityId entity, const Bounds2D& bounds)
+	{
+		auto it = m_Slots.find(entity);
+		ZE_CORE_ASSERT(it != m_Slots.end(), "Entity does not exist in quadtree!");
+
+		const uint32_t slot = it->second;
+		m_Items[slot].Bounds = bounds;
+		const uint32_t nodeIndex = FindNode(bounds);
+		if (nodeIndex == m_Items[slot].Node)
+			return;
+
+		RemoveFromNode(slot);
+		AddToNode(slot, nodeIndex);
+	}
+
+	void LooseQuadtree::Remove(EntityId entity)
+	{
+		auto it = m_Slots.find(entity);
+		ZE_CORE_ASSERT(it != m_Slots.end(), "Entity does not exist in quadtree!");
+
+		const uint32_t slot = it->second;
+		RemoveFromNode(slot);
+		m_Items[slot].Entity = NullEntityId;
+		m_Items[slot].Node = InvalidNode;
+		m_FreeSlots.push_back(slot);
+		m_Slots.erase(it);
+	}
+
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "Engine/Renderer/Culling2D.h"
+#include "Engine/Scene/Registry.h"
+
+namespace ZeoEngine {
+
+	/**
+	 * Quadtree whose nodes accept objects overlapping up to half of their size beyond their borders,
+	 * so that every object is stored in exactly one node chosen from its center and size, suited for sparse static objects.
+	 * Objects whose center lies outside the world bounds are kept in the root.
+	 */
+	class LooseQuadtree
+	{
+	public:
+		explicit LooseQuadtree(const Bounds2D& worldBounds, uint32_t maxDepth = 8);
+
+		void Insert(EntityId entity, const Bounds2D& bounds);
+		void Update(EntityId entity, const Bounds2D& bounds);
+		void Remove(EntityId entity);
+		bool Contains(EntityId entity) const { return m_Slots.find(entity) != m_Slots.end(); }
+
+		uint32_t GetCount() const { return static_cast<uint32_t>(m_Slots.size()); }
+		uint32_t GetNodeCount() const { return static_cast<uint32_t>(m_Nodes.size()); }
+
+		void Clear();
+
+		/** Calls func(EntityId, const Bounds2D&) once for every object intersecting area. */
+		template<typename Func>
+		void Query(const Bounds2D& area, Func&& func) const
+		{
+			uint32_t stack[64];
+			uint32_t stackSize = 0;
+			stack[stackSize++] = 0;
+			while (stackSize > 0)
+			{
+				const Node& node = m_Nodes[stack[--stackSize]];
+				if (node.SubtreeCount == 0)
+					continue;
+
+				// Root holds objects outside the world bounds so it is always visited
+				if (&node != &m_Nodes[0] && !node.GetLooseBounds().Intersects(area))
+					continue;
+
+				for (uint32_t slot : node.Items)
+				{
+					const Item& item = m_Items[slot];
+					if (item.Bounds.Intersects(area))
+					{
+						func(item.Entity, item.Bounds);
+					}
+				}
+
+				for (uint32_t child : node.Children)
+				{
+					if (child != InvalidNode)
+					{
+						stack[stackSize++] = child;
+					}
+				}
+			}
+		}
+
+	private:
+		static constexpr uint32_t InvalidNode = std::numeric_limits<uint32_t>::max();
+
+		struct Node
+		{
+			glm::vec2 Center;
+			float HalfSize;
+			uint32_t Parent = InvalidNode;
+			uint32_t Children[4] = { InvalidNode, InvalidNode, InvalidNode, InvalidNode };
+			/** Objects stored in this node and all nodes below it, used to skip empty subtrees */
+			uint32_t SubtreeCount = 0;
+			std::vector<uint32_t> Items;
+
+			/** Twice as large as the node itself */
+			Bounds2D GetLooseBounds() const
+			{
+				return { Center - glm::vec2(2.0f * HalfSize), Center + glm::vec2(2.0f * HalfSize) };
+			}
+		};
+
+		struct Item
+		{
+			EntityId Entity = NullEntityId;
+			Bounds2D Bounds;
+			uint32_t Node = InvalidNode;
+			/** Position in the item list of the node */
+			uint32_t IndexInNode = 0;
+		};
+
+		/** Returns the deepest node which can hold the bounds, creating nodes on the way if necessary. */
+		uint32_t FindNode(const Bounds2D& bounds);
+		void AddToNode(uint32_t slot, uint32_t nodeIndex);
+		void RemoveFromNode(uint32_t slot);
+
+	private:
+		Bounds2D m_WorldBounds;
+		uint32_t m_MaxDepth;
+
+		std::vector<Node> m_Nodes;
+		std::vector<Item> m_Items;
+		std::vector<uint32_t> m_FreeSlots;
+		std::unordered_map<EntityId, uint32_t> m_Slots;
+	};
+
+}
@@ -0,0 +1,65 @@
+#include "ZEpch.h"
+#include "Engine/Scene/Registry.h"
+
+namespace ZeoEngine {
+
+	uint32_t ComponentTypeIndex::Next()
+	{
+		static std::atomic<uint32_t> s_NextIndex{ 0 };
+		return s_NextIndex++;
+	}
+
+	EntityId Registry::CreateEntity()
+	{
+		++m_AliveCount;
+
+		// Recycle the most recently destroyed slot
+		if (m_FreeListHead != EntityTraits::IndexMask)
+		{
+			const uint32_t index = m_FreeListHead;
+			const EntityId slot = m_Entities[index];
+			m_FreeListHead = EntityTraits::GetIndex(slot);
+			m_Entities[index] = EntityTraits::MakeId(index, EntityTraits::GetVersion(slot));
+			return m_Entities[index];
+		}
+
+		const uint32_t index = static_cast<uint32_t>(m_Entities.size());
+		ZE_CORE_ASSERT(index < EntityTraits::MaxEntities, "Too many entities!");
+		m_Entities.push_back(EntityTraits::MakeId(index, 0));
+		return m_Entities.back();
+	}
+
+	void Registry::DestroyEntity(EntityId entity)
+	{
+		ZE_CORE_ASSERT(IsValid(entity), "Invalid entity!");
+
+		for (auto& pool : m_Pools)
+		{
+			if (pool)
+			{
+				pool->TryRemove(entity);
+			}
+		}
+
+		const uint32_t index = EntityTraits::GetIndex(entity);
+		// Bump the version so that existing ids of this entity become invalid
+		m_Entities[index] = EntityTraits::MakeId(m_FreeListHead, EntityTraits::GetVersion(entity) + 1);
+		m_FreeListHead = index;
+		--m_AliveCount;
+	}
+
+	void Registry::Clear()
+	{
+		for (auto& pool : m_Pools)
+		{
+			if (pool)
+			{
+				pool->Clear();
+			}
+		}
+		m_Entities.clear();
+		m_FreeListHead = EntityTraits::IndexMask;
+		m_AliveCount = 0;
+	}
+
+}
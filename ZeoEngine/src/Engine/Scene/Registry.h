@@ -0,0 +1,416 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "Engine/Core/Core.h"
+#include "Engine/Core/FrameAllocator.h"
+
+namespace ZeoEngine {
+
+	/**
+	 * Identifies an entity inside a Registry.
+	 * The lower bits hold the index of the entity and the upper bits hold a version which is bumped every time the index is recycled,
+	 * so that stale ids of destroyed entities are never mistaken for new ones.
+	 */
+	using EntityId = uint32_t;
+
+	static constexpr EntityId NullEntityId = std::numeric_limits<EntityId>::max();
+
+	namespace EntityTraits {
+
+		static constexpr uint32_t IndexBits = 20;
+		static constexpr uint32_t IndexMask = (1u << IndexBits) - 1;
+		static constexpr uint32_t VersionMask = ~IndexMask >> IndexBits;
+		/** Maximum number of entities alive at the same time */
+		static constexpr uint32_t MaxEntities = IndexMask;
+
+		inline uint32_t GetIndex(EntityId id) { return id & IndexMask; }
+		inline uint32_t GetVersion(EntityId id) { return id >> IndexBits; }
+		inline EntityId MakeId(uint32_t index, uint32_t version) { return (index & IndexMask) | ((version & VersionMask) << IndexBits); }
+
+	}
+
+	/** Assigns a unique index to every component type on first use. */
+	class ComponentTypeIndex
+	{
+	public:
+		template<typename T>
+		static uint32_t Get()
+		{
+			static const uint32_t index = Next();
+			return index;
+		}
+
+	private:
+		static uint32_t Next();
+	};
+
+	/**
+	 * Maps entities to densely packed indices.
+	 * Entities are stored contiguously in insertion order (modulo removals), which makes iteration a linear walk,
+	 * while lookups from an entity go through the sparse array indexed by entity index.
+	 */
+	class SparseSet
+	{
+	public:
+		virtual ~SparseSet() = default;
+
+		bool Contains(EntityId entity) const
+		{
+			const uint32_t index = EntityTraits::GetIndex(entity);
+			return index < m_Sparse.size() && m_Sparse[index] != InvalidIndex && m_Dense[m_Sparse[index]] == entity;
+		}
+
+		/** Returns the position of the entity in the packed array, entity must be contained in this set. */
+		uint32_t IndexOf(EntityId entity) const
+		{
+			ZE_CORE_ASSERT(Contains(entity), "Entity is not contained in this set!");
+			return m_Sparse[EntityTraits::GetIndex(entity)];
+		}
+
+		uint32_t Size() const { return static_cast<uint32_t>(m_Dense.size()); }
+		bool IsEmpty() const { return m_Dense.empty(); }
+		const EntityId* GetEntities() const { return m_Dense.data(); }
+
+		/** Incremented whenever entities are added, removed or reordered, which invalidates cached packed indices. */
+		uint32_t GetLayoutVersion() const { return m_LayoutVersion; }
+
+		/** Remove the entity if it is contained in this set. */
+		void TryRemove(EntityId entity)
+		{
+			if (Contains(entity))
+			{
+				Remove(entity);
+			}
+		}
+
+		virtual void Remove(EntityId entity) = 0;
+		virtual void Clear() = 0;
+
+	protected:
+		/** Append the entity to the packed array and returns its position. */
+		uint32_t Insert(EntityId entity)
+		{
+			ZE_CORE_ASSERT(!Contains(entity), "Entity already exists in this set!");
+
+			const uint32_t index = EntityTraits::GetIndex(entity);
+			if (index >= m_Sparse.size())
+			{
+				m_Sparse.resize(static_cast<size_t>(index) + 1, InvalidIndex);
+			}
+			const uint32_t denseIndex = static_cast<uint32_t>(m_Dense.size());
+			m_Sparse[index] = denseIndex;
+			m_Dense.push_back(entity);
+			++m_LayoutVersion;
+			return denseIndex;
+		}
+
+		/** Move the last element into the slot of the removed one, returns the position the entity used to occupy. */
+		uint32_t SwapAndPop(EntityId entity)
+		{
+			const uint32_t denseIndex = IndexOf(entity);
+			const EntityId last = m_Dense.back();
+			m_Dense[denseIndex] = last;
+			m_Sparse[EntityTraits::GetIndex(last)] = denseIndex;
+			m_Sparse[EntityTraits::GetIndex(entity)] = InvalidIndex;
+			m_Dense.pop_back();
+			++m_LayoutVersion;
+			return denseIndex;
+		}
+
+		/** Reorder the packed array so that the n-th entity becomes the one previously at order[n]. */
+		void PermuteEntities(const FrameVector<uint32_t>& order)
+		{
+			FrameVector<EntityId> dense(m_Dense.size());
+			for (uint32_t i = 0; i < order.size(); ++i)
+			{
+				dense[i] = m_Dense[order[i]];
+				m_Sparse[EntityTraits::GetIndex(dense[i])] = i;
+			}
+			// Copy back instead of swapping, the packed array must not end up in frame memory
+			std::copy(dense.begin(), dense.end(), m_Dense.begin());
+			++m_LayoutVersion;
+		}
+
+		void ClearEntities()
+		{
+			m_Sparse.clear();
+			m_Dense.clear();
+			++m_LayoutVersion;
+		}
+
+	private:
+		static constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+		std::vector<uint32_t> m_Sparse;
+		std::vector<EntityId> m_Dense;
+		uint32_t m_LayoutVersion = 0;
+	};
+
+	/**
+	 * Stores all components of one type in a contiguous array.
+	 * The n-th component belongs to the n-th entity of the underlying SparseSet,
+	 * so that each component type forms its own tightly packed stream (SoA across component types).
+	 */
+	template<typename T>
+	class ComponentPool : public SparseSet
+	{
+	public:
+		template<typename... Args>
+		T& Emplace(EntityId entity, Args&&... args)
+		{
+			Insert(entity);
+			// Allows aggregate components to be initialized with braces
+			if constexpr (std::is_aggregate_v<T>)
+			{
+				m_Components.push_back(T{ std::forward<Args>(args)... });
+			}
+			else
+			{
+				m_Components.emplace_back(std::forward<Args>(args)...);
+			}
+			return m_Components.back();
+		}
+
+		virtual void Remove(EntityId entity) override
+		{
+			const uint32_t denseIndex = SwapAndPop(entity);
+			if (denseIndex != m_Components.size() - 1)
+			{
+				m_Components[denseIndex] = std::move(m_Components.back());
+			}
+			m_Components.pop_back();
+		}
+
+		virtual void Clear() override
+		{
+			ClearEntities();
+			m_Components.clear();
+		}
+
+		T& Get(EntityId entity) { return m_Components[IndexOf(entity)]; }
+		const T& Get(EntityId entity) const { return m_Components[IndexOf(entity)]; }
+
+		T* TryGet(EntityId entity) { return Contains(entity) ? &m_Components[IndexOf(entity)] : nullptr; }
+		const T* TryGet(EntityId entity) const { return Contains(entity) ? &m_Components[IndexOf(entity)] : nullptr; }
+
+		/** Components in the same order as GetEntities(). */
+		T* GetComponents() { return m_Components.data(); }
+		const T* GetComponents() const { return m_Components.data(); }
+
+		void Reserve(uint32_t capacity)
+		{
+			m_Components.reserve(capacity);
+		}
+
+		/**
+		 * Stable sort of the packed arrays with compare(const T&, const T&).
+		 * Nothing is moved if the components are already in order.
+		 */
+		template<typename Compare>
+		void Sort(Compare compare)
+		{
+			if (std::is_sorted(m_Components.begin(), m_Components.end(), compare))
+				return;
+
+			// Scratch arrays come from frame memory, the packed arrays keep their own buffers
+			FrameVector<uint32_t> order(m_Components.size());
+			for (uint32_t i = 0; i < order.size(); ++i)
+			{
+				order[i] = i;
+			}
+			std::stable_sort(order.begin(), order.end(), [this, &compare](uint32_t a, uint32_t b)
+			{
+				return compare(m_Components[a], m_Components[b]);
+			});
+
+			FrameVector<T> components;
+			components.reserve(m_Components.size());
+			for (uint32_t index : order)
+			{
+				components.push_back(std::move(m_Components[index]));
+			}
+			std::move(components.begin(), components.end(), m_Components.begin());
+			PermuteEntities(order);
+		}
+
+	private:
+		std::vector<T> m_Components;
+	};
+
+	/**
+	 * Iterates all entities owning every one of the given components.
+	 * The smallest pool drives the iteration and the others are probed through their sparse arrays.
+	 * Adding or removing viewed components while iterating is not allowed.
+	 */
+	template<typename... Components>
+	class View
+	{
+		static_assert(sizeof...(Components) > 0, "View requires at least one component type!");
+
+	public:
+		View(ComponentPool<std::remove_const_t<Components>>*... pools)
+			: m_Pools(pools...)
+		{
+			m_Lead = GetSmallestPool(pools...);
+		}
+
+		/** Returns an upper bound of the number of entities visited. */
+		uint32_t GetSizeHint() const { return m_Lead ? m_Lead->Size() : 0; }
+
+		bool Contains(EntityId entity) const
+		{
+			return (std::get<ComponentPool<std::remove_const_t<Components>>*>(m_Pools)->Contains(entity) && ...);
+		}
+
+		template<typename T>
+		T& Get(EntityId entity) const
+		{
+			return std::get<ComponentPool<std::remove_const_t<T>>*>(m_Pools)->Get(entity);
+		}
+
+		/** Calls func(EntityId, Components&...) for every matching entity. */
+		template<typename Func>
+		void Each(Func&& func) const
+		{
+			EachInRange(0, GetSizeHint(), std::forward<Func>(func));
+		}
+
+		/**
+		 * Visit matching entities among [begin, end) of the driving pool.
+		 * Disjoint ranges can be processed on different threads as long as the systems touch different components.
+		 */
+		template<typename Func>
+		void EachInRange(uint32_t begin, uint32_t end, Func&& func) const
+		{
+			if (!m_Lead)
+				return;
+
+			const EntityId* entities = m_Lead->GetEntities();
+			if constexpr (sizeof...(Components) == 1)
+			{
+				// Single component views walk the packed arrays directly
+				auto* components = std::get<0>(m_Pools)->GetComponents();
+				for (uint32_t i = begin; i < end; ++i)
+				{
+					func(entities[i], components[i]);
+				}
+			}
+			else
+			{
+				for (uint32_t i = begin; i < end; ++i)
+				{
+					const EntityId entity = entities[i];
+					if (Contains(entity))
+					{
+						func(entity, Get<Components>(entity)...);
+					}
+				}
+			}
+		}
+
+	private:
+		template<typename... Pools>
+		static const SparseSet* GetSmallestPool(const Pools*... pools)
+		{
+			const SparseSet* smallest = nullptr;
+			((smallest = !smallest || pools->Size() < smallest->Size() ? static_cast<const SparseSet*>(pools) : smallest), ...);
+			return smallest;
+		}
+
+	private:
+		std::tuple<ComponentPool<std::remove_const_t<Components>>*...> m_Pools;
+		const SparseSet* m_Lead = nullptr;
+	};
+
+	/** Owns entities and their components. */
+	class Registry
+	{
+	public:
+		Registry() = default;
+		Registry(const Registry&) = delete;
+		Registry& operator=(const Registry&) = delete;
+
+		EntityId CreateEntity();
+		/** Destroy the entity and all of its components. */
+		void DestroyEntity(EntityId entity);
+		bool IsValid(EntityId entity) const
+		{
+			const uint32_t index = EntityTraits::GetIndex(entity);
+			return entity != NullEntityId && index < m_Entities.size() && m_Entities[index] == entity;
+		}
+		uint32_t GetAliveCount() const { return m_AliveCount; }
+
+		/** Destroy all entities. */
+		void Clear();
+
+		template<typename T, typename... Args>
+		T& AddComponent(EntityId entity, Args&&... args)
+		{
+			ZE_CORE_ASSERT(IsValid(entity), "Invalid entity!");
+			return GetPool<T>().Emplace(entity, std::forward<Args>(args)...);
+		}
+
+		template<typename T>
+		void RemoveComponent(EntityId entity)
+		{
+			ZE_CORE_ASSERT(IsValid(entity), "Invalid entity!");
+			GetPool<T>().Remove(entity);
+		}
+
+		template<typename T>
+		T& GetComponent(EntityId entity)
+		{
+			ZE_CORE_ASSERT(IsValid(entity), "Invalid entity!");
+			return GetPool<T>().Get(entity);
+		}
+
+		template<typename T>
+		T* TryGetComponent(EntityId entity)
+		{
+			return IsValid(entity) ? GetPool<T>().TryGet(entity) : nullptr;
+		}
+
+		template<typename... Components>
+		bool HasComponents(EntityId entity)
+		{
+			return IsValid(entity) && (GetPool<Components>().Contains(entity) && ...);
+		}
+
+		template<typename... Components>
+		ZeoEngine::View<Components...> View()
+		{
+			return ZeoEngine::View<Components...>(&GetPool<std::remove_const_t<Components>>()...);
+		}
+
+		template<typename T>
+		ComponentPool<T>& GetPool()
+		{
+			static_assert(std::is_same_v<T, std::decay_t<T>>, "Component type must not be qualified!");
+
+			const uint32_t typeIndex = ComponentTypeIndex::Get<T>();
+			if (typeIndex >= m_Pools.size())
+			{
+				m_Pools.resize(static_cast<size_t>(typeIndex) + 1);
+			}
+			if (!m_Pools[typeIndex])
+			{
+				m_Pools[typeIndex] = CreateScope<ComponentPool<T>>();
+			}
+			return static_cast<ComponentPool<T>&>(*m_Pools[typeIndex]);
+		}
+
+	private:
+		/** Alive entities store their own id, destroyed ones store the index of the next free slot and their next version */
+		std::vector<EntityId> m_Entities;
+		uint32_t m_FreeListHead = EntityTraits::IndexMask;
+		uint32_t m_AliveCount = 0;
+		/** Indexed by ComponentTypeIndex */
+		std::vector<Scope<SparseSet>> m_Pools;
+	};
+
+}
@@ -0,0 +1,469 @@
+#include "ZEpch.h"
+#include "Engine/Scene/Scene.h"
+
+#include "Engine/Scene/Entity.h"
+#include "Engine/Scene/Components.h"
+#include "Engine/Core/FrameAllocator.h"
+#include "Engine/Renderer/Renderer2D.h"
+
+namespace ZeoEngine {
+
+	Entity Scene::CreateEntity(const std::string& name)
+	{
+		Entity entity(m_Registry.CreateEntity(), this);
+		entity.AddComponent<TagComponent>(name);
+		entity.AddComponent<TransformComponent>();
+		return entity;
+	}
+
+	void Scene::DestroyEntity(Entity entity)
+	{
+		ZE_CORE_ASSERT(entity.GetScene() == this, "Entity does not belong to this scene!");
+
+		const EntityId entityId = entity.GetId();
+		if (auto* transform = m_Registry.TryGetComponent<TransformComponent>(entityId))
+		{
+			DetachFromParent(*transform, entityId);
+		}
+
+		// Destroying a child detaches it, so keep taking the first one.
+		// The transform is fetched again every time as removing components moves others around
+		while (true)
+		{
+			auto* transform = m_Registry.TryGetComponent<TransformComponent>(entityId);
+			if (!transform || transform->m_FirstChild == NullEntityId)
+				break;
+
+			DestroyEntity(Entity(transform->m_FirstChild, this));
+		}
+
+		m_Registry.DestroyEntity(entityId);
+	}
+
+	void Scene::SetParent(Entity child, Entity parent)
+	{
+		ZE_PROFILE_FUNCTION();
+
+		ZE_CORE_ASSERT(child.GetScene() == this, "Entity does not belong to this scene!");
+
+		const EntityId childId = child.GetId();
+		const EntityId parentId = parent ? parent.GetId() : NullEntityId;
+		auto& childTransform = m_Registry.GetComponent<TransformComponent>(childId);
+		if (childTransform.m_Parent == parentId)
+			return;
+
+		// Reject cycles by walking up from the new parent
+		for (EntityId ancestor = parentId; ancestor != NullEntityId; ancestor = m_Registry.GetComponent<TransformComponent>(ancestor).m_Parent)
+		{
+			if (ancestor == childId)
+			{
+				ZE_CORE_WARN("Failed to set parent of {0}: the new parent is a descendant of it!", child.GetComponent<TagComponent>().Name);
+				return;
+			}
+		}
+
+		DetachFromParent(childTransform, childId);
+
+		uint32_t depth = 0;
+		if (parentId != NullEntityId)
+		{
+			auto& parentTransform = m_Registry.GetComponent<TransformComponent>(parentId);
+			childTransform.m_Parent = parentId;
+			childTransform.m_NextSibling = parentTransform.m_FirstChild;
+			if (parentTransform.m_FirstChild != NullEntityId)
+			{
+				m_Registry.GetComponent<TransformComponent>(parentTransform.m_FirstChild).m_PrevSibling = childId;
+			}
+			parentTransform.m_FirstChild = childId;
+			depth = parentTransform.m_Depth + 1;
+		}
+		SetDepthRecursively(childId, depth);
+
+		// World transform of the whole subtree has to be recomputed
+		childTransform.m_bLocalDirty = true;
+		m_bHierarchyDirty = true;
+	}
+
+	void Scene::DetachFromParent(TransformComponent& transform, EntityId entity)
+	{
+		if (transform.m_Parent == NullEntityId)
+			return;
+
+		if (transform.m_PrevSibling != NullEntityId)
+		{
+			m_Registry.GetComponent<TransformComponent>(transform.m_PrevSibling).m_NextSibling = transform.m_NextSibling;
+		}
+		else
+		{
+			m_Registry.GetComponent<TransformComponent>(transform.m_Parent).m_FirstChild = transform.m_NextSibling;
+		}
+		if (transform.m_NextSibling != NullEntityId)
+		{
+			m_Registry.GetComponent<TransformComponent>(transform.m_NextSibling).m_PrevSibling = transform.m_PrevSibling;
+		}
+
+		transform.m_Parent = NullEntityId;
+		transform.m_PrevSibling = NullEntityId;
+		transform.m_NextSibling = NullEntityId;
+		transform.m_bLocalDirty = true;
+		m_bHierarchyDirty = true;
+	}
+
+	void Scene::SetDepthRecursively(EntityId entity, uint32_t depth)
+	{
+		auto& transform = m_Registry.GetComponent<TransformComponent>(entity);
+		transform.m_Depth = depth;
+		for (EntityId child = transform.m_FirstChild; child != NullEntityId; child = m_Registry.GetComponent<TransformComponent>(child).m_NextSibling)
+		{
+			SetDepthRecursively(child, depth + 1);
+		}
+	}
+
+	void Scene::OnUpdate(DeltaTime dt)
+	{
+		ZE_PROFILE_FUNCTION();
+
+		m_Scheduler.Run(m_Registry, dt);
+		UpdatePhysics(dt);
+		UpdateSpatialIndex(UpdateTransforms());
+
+		Entity cameraEntity = GetPrimaryCameraEntity();
+		if (!cameraEntity)
+			return;
+
+		// Sync camera view with its entity
+		const glm::mat4& transform = cameraEntity.GetComponent<TransformComponent>().GetWorldTransform();
+		auto& camera = cameraEntity.GetComponent<CameraComponent>().Camera;
+		const glm::vec3 position = glm::vec3(transform[3]);
+		if (camera.GetPosition() != position)
+		{
+			camera.SetPosition(position);
+		}
+		const float rotationDegrees = glm::degrees(glm::atan(transform[0][1], transform[0][0]));
+		if (camera.GetRotation() != rotationDegrees)
+		{
+			camera.SetRotation(rotationDegrees);
+		}
+
+		Renderer2D::BeginScene(camera);
+		RenderTilemaps();
+		RenderSprites();
+		Renderer2D::EndScene();
+	}
+
+	void Scene::OnUpdate(DeltaTime dt, const OrthographicCamera& camera)
+	{
+		ZE_PROFILE_FUNCTION();
+
+		m_Scheduler.Run(m_Registry, dt);
+		UpdatePhysics(dt);
+		UpdateSpatialIndex(UpdateTransforms());
+
+		Renderer2D::BeginScene(camera);
+		RenderTilemaps();
+		RenderSprites();
+		Renderer2D::EndScene();
+	}
+
+	void Scene::UpdatePhysics(DeltaTime dt)
+	{
+		ZE_PROFILE_FUNCTION();
+
+		// Same as the spatial index, bodies can only become stale when pool layouts change
+		const uint32_t transformLayoutVersion = m_Registry.GetPool<TransformComponent>().GetLayoutVersion();
+		const uint32_t rigidbodyLayoutVersion = m_Registry.GetPool<Rigidbody2DComponent>().GetLayoutVersion();
+		if (transformLayoutVersion != m_PhysicsTransformLayoutVersion || rigidbodyLayoutVersion != m_PhysicsRigidbodyLayoutVersion)
+		{
+			ZE_PROFILE_SCOPE("Sweep Bodies");
+
+			// A component added again, or an entity id reused, comes with no body so the old one is stale
+			m_PhysicsWorld.DestroyBodiesIf([this](BodyId2D body, uint32_t entity)
+			{
+				if (!m_Registry.HasComponents<TransformComponent, Rigidbody2DComponent>(entity))
+					return true;
+
+				return m_Registry.GetComponent<Rigidbody2DComponent>(entity).RuntimeBody != body;
+			});
+			m_PhysicsTransformLayoutVersion = transformLayoutVersion;
+			m_PhysicsRigidbodyLayoutVersion = rigidbodyLayoutVersion;
+		}
+
+		m_Registry.View<const TransformComponent, Rigidbody2DComponent>().Each([this](EntityId entity, const TransformComponent& transform, Rigidbody2DComponent& rigidbody)
+		{
+			if (rigidbody.RuntimeBody != NullBodyId2D)
+				return;
+
+			BodyDef2D def;
+			glm::vec2 offset;
+			const glm::vec2& scale = transform.GetScale();
+			if (const auto* box = m_Registry.TryGetComponent<BoxCollider2DComponent>(entity))
+			{
+				def.Shape.Type = ShapeType2D::Box;
+				def.Shape.HalfExtents = box->Size * glm::abs(scale);
+				def.Density = box->Density;
+				def.Friction = box->Friction;
+				def.Restitution = box->Restitution;
+				offset = box->Offset * scale;
+			}
+			else if (const auto* circle = m_Registry.TryGetComponent<CircleCollider2DComponent>(entity))
+			{
+				def.Shape.Type = ShapeType2D::Circle;
+				def.Shape.Radius = circle->Radius * glm::max(glm::abs(scale.x), glm::abs(scale.y));
+				def.Density = circle->Density;
+				def.Friction = circle->Friction;
+				def.Restitution = circle->Restitution;
+				offset = circle->Offset * scale;
+			}
+			else
+			{
+				return;
+			}
+
+			const Transform2D entityTransform(glm::vec2(transform.GetTranslation()), transform.GetRotation());
+			def.Type = rigidbody.Type;
+			def.Position = entityTransform.Apply(offset);
+			def.Rotation = transform.GetRotation();
+			def.bFixedRotation = rigidbody.bFixedRotation;
+			def.UserData = entity;
+			rigidbody.RuntimeBody = m_PhysicsWorld.CreateBody(def);
+			rigidbody.RuntimeShapeOffset = offset;
+		});
+
+		m_PhysicsWorld.Step(dt);
+
+		m_PhysicsWorld.ForEachMovedBody([this](BodyId2D, uint32_t entity, const glm::vec2& position, float rotation)
+		{
+			auto& transform = m_Registry.GetComponent<TransformComponent>(entity);
+			const glm::vec2& offset = m_Registry.GetComponent<Rigidbody2DComponent>(entity).RuntimeShapeOffset;
+			const glm::vec2 translation = position - Transform2D(glm::vec2(0.0f), rotation).Rotate(offset);
+			transform.SetTranslation({ translation, transform.GetTranslation().z });
+			transform.SetRotation(rotation);
+		});
+	}
+
+	FrameVector<EntityId> Scene::UpdateTransforms()
+	{
+		ZE_PROFILE_FUNCTION();
+
+		auto& pool = m_Registry.GetPool<TransformComponent>();
+		if (m_bHierarchyDirty || pool.GetLayoutVersion() != m_SortedTransformLayoutVersion)
+		{
+			ZE_PROFILE_SCOPE("Sort Transforms");
+
+			// Breadth-first order: all roots, then all entities of depth 1 and so on
+			pool.Sort([](const TransformComponent& lhs, const TransformComponent& rhs) { return lhs.m_Depth < rhs.m_Depth; });
+
+			TransformComponent* transforms = pool.GetComponents();
+			for (uint32_t i = 0; i < pool.Size(); ++i)
+			{
+				transforms[i].m_ParentIndex = transforms[i].m_Parent != NullEntityId ? pool.IndexOf(transforms[i].m_Parent) : NullEntityId;
+			}
+
+			m_SortedTransformLayoutVersion = pool.GetLayoutVersion();
+			m_bHierarchyDirty = false;
+		}
+
+		FrameVector<EntityId> changedEntities;
+		TransformComponent* transforms = pool.GetComponents();
+		const EntityId* entities = pool.GetEntities();
+		for (uint32_t i = 0; i < pool.Size(); ++i)
+		{
+			TransformComponent& transform = transforms[i];
+			// Parents precede their children so their flags are already up to date for this frame
+			const TransformComponent* parent = transform.m_ParentIndex != NullEntityId ? &transforms[transform.m_ParentIndex] : nullptr;
+			const bool bParentChanged = parent && parent->m_bWorldChanged;
+			if (transform.m_bLocalDirty)
+			{
+				transform.m_LocalTransform = TransformComponent::ComposeTransform(transform.m_Translation, transform.m_Rotation, transform.m_Scale);
+			}
+			transform.m_bWorldChanged = transform.m_bLocalDirty || bParentChanged;
+			if (transform.m_bWorldChanged)
+			{
+				transform.m_WorldTransform = parent ? parent->m_WorldTransform * transform.m_LocalTransform : transform.m_LocalTransform;
+				changedEntities.push_back(entities[i]);
+			}
+			transform.m_bLocalDirty = false;
+		}
+		return changedEntities;
+	}
+
+	void Scene::UpdateSpatialIndex(const FrameVector<EntityId>& changedEntities)
+	{
+		ZE_PROFILE_FUNCTION();
+
+		auto& transforms = m_Registry.GetPool<TransformComponent>();
+		auto& sprites = m_Registry.GetPool<SpriteRendererComponent>();
+		// Entities can only join or leave the index by gaining or losing a component or being destroyed, all of which change pool layouts
+		const bool bLayoutChanged = transforms.GetLayoutVersion() != m_IndexedTransformLayoutVersion || sprites.GetLayoutVersion() != m_IndexedSpriteLayoutVersion;
+		if (bLayoutChanged)
+		{
+			ZE_PROFILE_SCOPE("Sweep Spatial Index");
+
+			m_SpatialIndex.RemoveIf([this](EntityId entity)
+			{
+				return !m_Registry.HasComponents<TransformComponent, SpriteRendererComponent>(entity);
+			});
+		}
+
+		// Entities which are not indexed yet are skipped, inserting them below keeps them in the static part of the index
+		for (EntityId entity : changedEntities)
+		{
+			if (sprites.Contains(entity) && m_SpatialIndex.Contains(entity))
+			{
+				m_SpatialIndex.Update(entity, Culling2D::ComputeQuadBounds(transforms.Get(entity).GetWorldTransform()));
+			}
+		}
+
+		if (bLayoutChanged)
+		{
+			ZE_PROFILE_SCOPE("Insert Into Spatial Index");
+
+			m_Registry.View<const TransformComponent, const SpriteRendererComponent>().Each([this](EntityId entity, const TransformComponent& transform, const SpriteRendererComponent&)
+			{
+				if (!m_SpatialIndex.Contains(entity))
+				{
+					m_SpatialIndex.Insert(entity, Culling2D::ComputeQuadBounds(transform.GetWorldTransform()));
+				}
+			});
+			m_IndexedTransformLayoutVersion = transforms.GetLayoutVersion();
+			m_IndexedSpriteLayoutVersion = sprites.GetLayoutVersion();
+		}
+	}
+
+	static void DrawSprite(const glm::mat4& transform, const SpriteRendererComponent& sprite)
+	{
+		if (sprite.SubTexture)
+		{
+			Renderer2D::DrawQuad(transform, sprite.SubTexture, sprite.TilingFactor, sprite.Color);
+		}
+		else if (sprite.Texture)
+		{
+			Renderer2D::DrawQuad(transform, sprite.Texture, sprite.TilingFactor, sprite.Color);
+		}
+		else
+		{
+			Renderer2D::DrawQuad(transform, sprite.Color);
+		}
+	}
+
+	void Scene::RenderTilemaps()
+	{
+		ZE_PROFILE_FUNCTION();
+
+		m_Registry.View<const TransformComponent, const TilemapComponent>().Each([](EntityId entity, const TransformComponent& transform, const TilemapComponent& tilemap)
+		{
+			if (tilemap.Map)
+			{
+				Renderer2D::DrawTilemap(*tilemap.Map, transform.GetWorldTransform(), tilemap.TintColor);
+			}
+		});
+	}
+
+	void Scene::RenderSprites()
+	{
+		ZE_PROFILE_FUNCTION();
+
+		if (m_bSpatialIndexEnabled)
+		{
+			auto& transforms = m_Registry.GetPool<TransformComponent>();
+			auto& sprites = m_Registry.GetPool<SpriteRendererComponent>();
+			uint32_t visibleCount = 0;
+			m_SpatialIndex.Query(Renderer2D::GetViewBounds(), [&](EntityId entity, const Bounds2D&)
+			{
+				DrawSprite(transforms.Get(entity).GetWorldTransform(), sprites.Get(entity));
+				++visibleCount;
+			});
+			// Sprites never visited by the query are culled as well
+			Renderer2D::ReportCulledQuads(m_SpatialIndex.GetCount() - visibleCount);
+			return;
+		}
+
+		auto view = m_Registry.View<const TransformComponent, const SpriteRendererComponent>();
+		const uint32_t maxCount = view.GetSizeHint();
+		if (maxCount == 0)
+			return;
+
+		// Gather world-space bounds into SoA arrays so that they can be culled several at a time
+		const TransformComponent** transforms = FrameAllocator::NewArray<const TransformComponent*>(maxCount);
+		const SpriteRendererComponent** sprites = FrameAllocator::NewArray<const SpriteRendererComponent*>(maxCount);
+		float* centerX = FrameAllocator::NewArray<float>(maxCount);
+		float* centerY = FrameAllocator::NewArray<float>(maxCount);
+		float* extentX = FrameAllocator::NewArray<float>(maxCount);
+		float* extentY = FrameAllocator::NewArray<float>(maxCount);
+		uint32_t count = 0;
+		view.Each([&](EntityId entity, const TransformComponent& transform, const SpriteRendererComponent& sprite)
+		{
+			const Bounds2D bounds = Culling2D::ComputeQuadBounds(transform.GetWorldTransform());
+			transforms[count] = &transform;
+			sprites[count] = &sprite;
+			centerX[count] = 0.5f * (bounds.Min.x + bounds.Max.x);
+			centerY[count] = 0.5f * (bounds.Min.y + bounds.Max.y);
+			extentX[count] = 0.5f * (bounds.Max.x - bounds.Min.x);
+			extentY[count] = 0.5f * (bounds.Max.y - bounds.Min.y);
+			++count;
+		});
+
+		uint8_t* visibility = FrameAllocator::NewArray<uint8_t>(count);
+		Renderer2D::CullQuads(centerX, centerY, extentX, extentY, count, visibility);
+
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			if (!visibility[i])
+				continue;
+
+			DrawSprite(transforms[i]->GetWorldTransform(), *sprites[i]);
+		}
+	}
+
+	void Scene::OnViewportResize(uint32_t width, uint32_t height)
+	{
+		m_ViewportWidth = width;
+		m_ViewportHeight = height;
+
+		m_Registry.View<CameraComponent>().Each([width, height](EntityId entity, CameraComponent& camera)
+		{
+			if (!camera.bFixedAspectRatio)
+			{
+				camera.SetViewportSize(width, height);
+			}
+		});
+	}
+
+	Entity Scene::PickEntity(const glm::vec2& worldPosition)
+	{
+		ZE_PROFILE_FUNCTION();
+
+		Entity pickedEntity;
+		float pickedZ = -std::numeric_limits<float>::max();
+		m_SpatialIndex.Query({ worldPosition, worldPosition }, [&](EntityId entity, const Bounds2D&)
+		{
+			// Bounds are axis-aligned so test against the actual quad in its local space
+			const glm::mat4& transform = m_Registry.GetComponent<TransformComponent>(entity).GetWorldTransform();
+			const glm::vec4 localPosition = glm::inverse(transform) * glm::vec4(worldPosition, 0.0f, 1.0f);
+			if (glm::abs(localPosition.x) > 0.5f || glm::abs(localPosition.y) > 0.5f)
+				return;
+
+			const float z = transform[3].z;
+			if (!pickedEntity || z > pickedZ)
+			{
+				pickedEntity = Entity(entity, this);
+				pickedZ = z;
+			}
+		});
+		return pickedEntity;
+	}
+
+	Entity Scene::GetPrimaryCameraEntity()
+	{
+		Entity primaryCamera;
+		m_Registry.View<const TransformComponent, const CameraComponent>().Each([this, &primaryCamera](EntityId entity, const TransformComponent&, const CameraComponent& camera)
+		{
+			if (camera.bPrimary && !primaryCamera)
+			{
+				primaryCamera = Entity(entity, this);
+			}
+		});
+		return primaryCamera;
+	}
+
+}
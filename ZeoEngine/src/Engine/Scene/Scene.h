@@ -0,0 +1,126 @@
+#pragma once
+
+#include "Engine/Core/DeltaTime.h"
+#include "Engine/Scene/Registry.h"
+#include "Engine/Scene/SystemScheduler.h"
+#include "Engine/Scene/SpatialIndex.h"
+#include "Engine/Physics/PhysicsWorld2D.h"
+
+namespace ZeoEngine {
+
+	class Entity;
+	class OrthographicCamera;
+	class TransformComponent;
+
+	class Scene
+	{
+		friend class Entity;
+
+	public:
+		Scene() = default;
+		~Scene() = default;
+
+		/** Create an entity with TagComponent and TransformComponent attached. */
+		Entity CreateEntity(const std::string& name = "Entity");
+		/** Destroy the entity together with all of its descendants. */
+		void DestroyEntity(Entity entity);
+
+		/**
+		 * Attach child to parent, or detach it if parent is a null entity.
+		 * The local transform of the child is kept, so its world transform becomes relative to the new parent.
+		 */
+		void SetParent(Entity child, Entity parent);
+
+		/** Register a system to be run by the scheduler at the start of every OnUpdate(). */
+		void AddSystem(const std::string& name, const SystemAccess& access, SystemScheduler::SystemFunc func)
+		{
+			m_Scheduler.AddSystem(name, access, std::move(func));
+		}
+
+		/** Update the scene and render it from the primary camera entity. */
+		void OnUpdate(DeltaTime dt);
+		/** Update the scene and render it from an external camera, e.g. the one of an OrthographicCameraController. */
+		void OnUpdate(DeltaTime dt, const OrthographicCamera& camera);
+
+		/** Update projections of all cameras which do not have a fixed aspect ratio. */
+		void OnViewportResize(uint32_t width, uint32_t height);
+
+		/** Returns a null entity if there is no primary camera. */
+		Entity GetPrimaryCameraEntity();
+
+		/**
+		 * Calls func(Entity) for every sprite entity whose world-space bounds intersect area.
+		 * Bounds are those computed during the last OnUpdate().
+		 */
+		template<typename Func>
+		void QueryEntities(const Bounds2D& area, Func&& func)
+		{
+			// Generic lambda defers the use of Entity, which is incomplete here, until instantiation
+			m_SpatialIndex.Query(area, [this, &func](auto entity, const Bounds2D&)
+			{
+				func(Entity(entity, this));
+			});
+		}
+		/** Returns the topmost sprite entity under worldPosition or a null entity if there is none. */
+		Entity PickEntity(const glm::vec2& worldPosition);
+
+		/** If disabled, sprites are culled by testing all of them against the view every frame. */
+		void SetSpatialIndexEnabled(bool bEnabled) { m_bSpatialIndexEnabled = bEnabled; }
+		bool IsSpatialIndexEnabled() const { return m_bSpatialIndexEnabled; }
+		const SpatialIndex& GetSpatialIndex() const { return m_SpatialIndex; }
+
+		/** Bodies of Rigidbody2DComponent entities live here, it can also be used directly for bodies without entities. */
+		PhysicsWorld2D& GetPhysicsWorld() { return m_PhysicsWorld; }
+
+		uint32_t GetEntityCount() const { return m_Registry.GetAliveCount(); }
+		Registry& GetRegistry() { return m_Registry; }
+		SystemScheduler& GetScheduler() { return m_Scheduler; }
+
+	private:
+		/**
+		 * Recompute matrices of dirty transforms and everything below them.
+		 * Transforms are kept sorted by depth so that parents are always updated before their children in a single linear walk.
+		 * Returns the entities whose world transform has changed, allocated from frame memory.
+		 */
+		FrameVector<EntityId> UpdateTransforms();
+		void DetachFromParent(TransformComponent& transform, EntityId entity);
+		void SetDepthRecursively(EntityId entity, uint32_t depth);
+		/**
+		 * Create bodies for new Rigidbody2DComponent entities, destroy those of removed ones, step the physics world
+		 * and copy positions of bodies which have moved back to their transforms. Sleeping bodies cost nothing here.
+		 */
+		void UpdatePhysics(DeltaTime dt);
+		/**
+		 * Keep bounds of sprite entities in the spatial index in sync with their world transforms.
+		 * Only entities returned by UpdateTransforms() are updated, all sprites are only visited when the pool layouts have changed.
+		 */
+		void UpdateSpatialIndex(const FrameVector<EntityId>& changedEntities);
+
+		/**
+		 * Cull sprites against the view using the spatial index or in batches, and submit visible ones to Renderer2D.
+		 * Must be called between Renderer2D::BeginScene() and Renderer2D::EndScene().
+		 */
+		void RenderSprites();
+		/** Submit tilemaps to Renderer2D, which draws them when the scene ends. Must be called between Renderer2D::BeginScene() and Renderer2D::EndScene(). */
+		void RenderTilemaps();
+
+	private:
+		Registry m_Registry;
+		SystemScheduler m_Scheduler;
+		uint32_t m_ViewportWidth = 0, m_ViewportHeight = 0;
+
+		/** Layout version of the transform pool when it was last sorted */
+		uint32_t m_SortedTransformLayoutVersion = 0;
+		bool m_bHierarchyDirty = true;
+
+		SpatialIndex m_SpatialIndex;
+		/** Layout versions of the transform and sprite pools when the spatial index was last swept for stale entities */
+		uint32_t m_IndexedTransformLayoutVersion = 0, m_IndexedSpriteLayoutVersion = 0;
+		bool m_bSpatialIndexEnabled = true;
+
+		PhysicsWorld2D m_PhysicsWorld;
+		/** Layout versions of the transform and rigidbody pools when bodies were last swept for stale entities */
+		uint32_t m_PhysicsTransformLayoutVersion = 0, m_PhysicsRigidbodyLayoutVersion = 0;
+	};
+
+}
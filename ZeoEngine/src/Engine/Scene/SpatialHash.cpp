@@ -0,0 +1,116 @@
+#include "ZEpch.h"
+#include "Engine/Scene/SpatialHash.h"
+
+namespace ZeoEngine {
+
+	SpatialHash::SpatialHash(float cellSize)
+		: m_CellSize(cellSize), m_InverseCellSize(1.0f / cellSize)
+	{
+		ZE_CORE_ASSERT(cellSize > 0.0f, "Cell size must be positive!");
+	}
+
+	SpatialHash::CellRange SpatialHash::ComputeCellRange(const Bounds2D& bounds) const
+	{
+		return {
+			static_cast<int32_t>(glm::floor(bounds.Min.x * m_InverseCellSize)),
+			static_cast<int32_t>(glm::floor(bounds.Min.y * m_InverseCellSize)),
+			static_cast<int32_t>(glm::floor(bounds.Max.x * m_InverseCellSize)),
+			static_cast<int32_t>(glm::floor(bounds.Max.y * m_InverseCellSize))
+		};
+	}
+
+	void SpatialHash::Insert(EntityId entity, const Bounds2D& bounds)
+	{
+		ZE_CORE_ASSERT(!Contains(entity), "Entity already exists in spatial hash!");
+
+		uint32_t slot;
+		if (!m_FreeSlots.empty())
+		{
+			slot = m_FreeSlots.back();
+			m_FreeSlots.pop_back();
+		}
+		else
+		{
+			slot = static_cast<uint32_t>(m_Items.size());
+			m_Items.emplace_back();
+		}
+
+		Item& item = m_Items[slot];
+		item.Entity = entity;
+		item.Bounds = bounds;
+		item.Cells = ComputeCellRange(bounds);
+		m_Slots[entity] = slot;
+		AddToCells(slot);
+	}
+
+	void SpatialHash::Update(EntityId entity, const Bounds2D& bounds)
+	{
+		auto it = m_Slots.find(entity);
+		ZE_CORE_ASSERT(it != m_Slots.end(), "Entity does not exist in spatial hash!");
+
+		Item& item = m_Items[it->second];
+		item.Bounds = bounds;
+		const CellRange cells = ComputeCellRange(bounds);
+		if (cells == item.Cells)
+			return;
+
+		RemoveFromCells(it->second);
+		item.Cells = cells;
+		AddToCells(it->second);
+	}
+
+	void SpatialHash::Remove(EntityId entity)
+	{
+		auto it = m_Slots.find(entity);
+		ZE_CORE_ASSERT(it != m_Slots.end(), "Entity does not exist in spatial hash!");
+
+		const uint32_t slot = it->second;
+		RemoveFromCells(slot);
+		m_Items[slot].Entity = NullEntityId;
+		m_FreeSlots.push_back(slot);
+		m_Slots.erase(it);
+	}
+
+	void SpatialHash::Clear()
+	{
+		m_Items.clear();
+		m_FreeSlots.clear();
+		m_Slots.clear();
+		m_Cells.clear();
+	}
+
+	void SpatialHash::AddToCells(uint32_t slot)
+	{
+		const CellRange& range = m_Items[slot].Cells;
+		for (int32_t y = range.MinY; y <= range.MaxY; ++y)
+		{
+			for (int32_t x = range.MinX; x <= range.MaxX; ++x)
+			{
+				m_Cells[GetCellKey(x, y)].push_back(slot);
+			}
+		}
+	}
+
+	void SpatialHash::RemoveFromCells(uint32_t slot)
+	{
+		const CellRange& range = m_Items[slot].Cells;
+		for (int32_t y = range.MinY; y <= range.MaxY; ++y)
+		{
+			for (int32_t x = range.MinX; x <= range.MaxX; ++x)
+			{
+				auto it = m_Cells.find(GetCellKey(x, y));
+				ZE_CORE_ASSERT(it != m_Cells.end(), "Spatial hash cell is missing!");
+
+				auto& slots = it->second;
+				auto slotIt = std::find(slots.begin(), slots.end(), slot);
+				*slotIt = slots.back();
+				slots.pop_back();
+				if (slots.empty())
+				{
+					m_Cells.erase(it);
+				}
+			}
+		}
+	}
+
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "Engine/Renderer/Culling2D.h"
+#include "Engine/Scene/Registry.h"
+
+namespace ZeoEngine {
+
+	/**
+	 * Uniform grid of square cells hashed by their coordinates, suited for many small moving objects.
+	 * An object is stored in every cell its bounds overlap, and moving it only touches the cell lists if the set of overlapped cells changes.
+	 */
+	class SpatialHash
+	{
+	public:
+		explicit SpatialHash(float cellSize = 2.0f);
+
+		void Insert(EntityId entity, const Bounds2D& bounds);
+		void Update(EntityId entity, const Bounds2D& bounds);
+		void Remove(EntityId entity);
+		bool Contains(EntityId entity) const { return m_Slots.find(entity) != m_Slots.end(); }
+
+		uint32_t GetCount() const { return static_cast<uint32_t>(m_Slots.size()); }
+		float GetCellSize() const { return m_CellSize; }
+
+		void Clear();
+
+		/** Calls func(EntityId, const Bounds2D&) once for every object intersecting area. */
+		template<typename Func>
+		void Query(const Bounds2D& area, Func&& func) const
+		{
+			const CellRange range = ComputeCellRange(area);
+			const uint64_t cellCount = static_cast<uint64_t>(range.MaxX - range.MinX + 1) * static_cast<uint64_t>(range.MaxY - range.MinY + 1);
+			// Probing more cells than there are objects is slower than testing all objects
+			if (cellCount > m_Slots.size())
+			{
+				for (const Item& item : m_Items)
+				{
+					if (item.Entity != NullEntityId && item.Bounds.Intersects(area))
+					{
+						func(item.Entity, item.Bounds);
+					}
+				}
+				return;
+			}
+
+			for (int32_t y = range.MinY; y <= range.MaxY; ++y)
+			{
+				for (int32_t x = range.MinX; x <= range.MaxX; ++x)
+				{
+					auto it = m_Cells.find(GetCellKey(x, y));
+					if (it == m_Cells.end())
+						continue;
+
+					for (uint32_t slot : it->second)
+					{
+						const Item& item = m_Items[slot];
+						// Objects spanning several cells are only reported from the first cell they share with the area
+						if (x != std::max(item.Cells.MinX, range.MinX) || y != std::max(item.Cells.MinY, range.MinY))
+							continue;
+
+						if (item.Bounds.Intersects(area))
+						{
+							func(item.Entity, item.Bounds);
+						}
+					}
+				}
+			}
+		}
+
+	private:
+		struct CellRange
+		{
+			int32_t MinX, MinY, MaxX, MaxY;
+
+			bool operator==(const CellRange& other) const
+			{
+				return MinX == other.MinX && MinY == other.MinY && MaxX == other.MaxX && MaxY == other.MaxY;
+			}
+		};
+
+		struct Item
+		{
+			EntityId Entity = NullEntityId;
+			Bounds2D Bounds;
+			CellRange Cells;
+		};
+
+		CellRange ComputeCellRange(const Bounds2D& bounds) const;
+		static uint64_t GetCellKey(int32_t x, int32_t y)
+		{
+			return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+		}
+
+		void AddToCells(uint32_t slot);
+		void RemoveFromCells(uint32_t slot);
+
+	private:
+		float m_CellSize;
+		float m_InverseCellSize;
+
+		/** Slots of removed objects are recycled so that cell lists can refer to stable indices */
+		std::vector<Item> m_Items;
+		std::vector<uint32_t> m_FreeSlots;
+		std::unordered_map<EntityId, uint32_t> m_Slots;
+		std::unordered_map<uint64_t, std::vector<uint32_t>> m_Cells;
+	};
+
+}
@@ -0,0 +1,108 @@
+#include "ZEpch.h"
+#include "Engine/Scene/SpatialIndex.h"
+
+namespace ZeoEngine {
+
+	/** Objects covering more cells than this in either direction are kept in the quadtree */
+	static constexpr float s_MaxCellsPerObject = 4.0f;
+
+	SpatialIndex::SpatialIndex(const Bounds2D& staticWorldBounds, float dynamicCellSize)
+		: m_StaticObjects(staticWorldBounds), m_DynamicObjects(dynamicCellSize)
+	{
+	}
+
+	SpatialIndex::Location SpatialIndex::GetLocation(EntityId entity) const
+	{
+		const uint32_t index = EntityTraits::GetIndex(entity);
+		return index < m_Entities.size() && m_Entities[index] == entity ? m_Locations[index] : Location::None;
+	}
+
+	bool SpatialIndex::FitsSpatialHash(const Bounds2D& bounds) const
+	{
+		const glm::vec2 size = bounds.Max - bounds.Min;
+		return glm::max(size.x, size.y) <= s_MaxCellsPerObject * m_DynamicObjects.GetCellSize();
+	}
+
+	bool SpatialIndex::Contains(EntityId entity) const
+	{
+		return GetLocation(entity) != Location::None;
+	}
+
+	void SpatialIndex::Insert(EntityId entity, const Bounds2D& bounds)
+	{
+		ZE_CORE_ASSERT(!Contains(entity), "Entity already exists in spatial index!");
+
+		const uint32_t index = EntityTraits::GetIndex(entity);
+		if (index >= m_Entities.size())
+		{
+			m_Entities.resize(static_cast<size_t>(index) + 1, NullEntityId);
+			m_Locations.resize(static_cast<size_t>(index) + 1, Location::None);
+		}
+		m_Entities[index] = entity;
+		m_Locations[index] = Location::Static;
+		m_StaticObjects.Insert(entity, bounds);
+	}
+
+	void SpatialIndex::Update(EntityId entity, const Bounds2D& bounds)
+	{
+		const uint32_t index = EntityTraits::GetIndex(entity);
+		switch (GetLocation(entity))
+		{
+		case Location::Static:
+			if (FitsSpatialHash(bounds))
+			{
+				m_StaticObjects.Remove(entity);
+				m_DynamicObjects.Insert(entity, bounds);
+				m_Locations[index] = Location::Dynamic;
+			}
+			else
+			{
+				m_StaticObjects.Update(entity, bounds);
+			}
+			break;
+		case Location::Dynamic:
+			if (FitsSpatialHash(bounds))
+			{
+				m_DynamicObjects.Update(entity, bounds);
+			}
+			else
+			{
+				m_DynamicObjects.Remove(entity);
+				m_StaticObjects.Insert(entity, bounds);
+				m_Locations[index] = Location::Static;
+			}
+			break;
+		default:
+			ZE_CORE_ASSERT(false, "Entity does not exist in spatial index!");
+			break;
+		}
+	}
+
+	void SpatialIndex::Remove(EntityId entity)
+	{
+		const uint32_t index = EntityTraits::GetIndex(entity);
+		switch (GetLocation(entity))
+		{
+		case Location::Static:
+			m_StaticObjects.Remove(entity);
+			break;
+		case Location::Dynamic:
+			m_DynamicObjects.Remove(entity);
+			break;
+		default:
+			ZE_CORE_ASSERT(false, "Entity does not exist in spatial index!");
+			return;
+		}
+		m_Entities[index] = NullEntityId;
+		m_Locations[index] = Location::None;
+	}
+
+	void SpatialIndex::Clear()
+	{
+		m_StaticObjects.Clear();
+		m_DynamicObjects.Clear();
+		m_Entities.clear();
+		m_Locations.clear();
+	}
+
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Engine/Scene/SpatialHash.h"
+#include "Engine/Scene/LooseQuadtree.h"
+
+namespace ZeoEngine {
+
+	/**
+	 * Answers "which entities overlap this rectangle" for a scene.
+	 *
+	 * Entities start in a loose quadtree as most of the world never moves.
+	 * The first time an entity moves after being inserted it is migrated to a spatial hash,
+	 * which handles frequent updates of small objects better. Objects too large for the hash cells stay in the quadtree.
+	 */
+	class SpatialIndex
+	{
+	public:
+		explicit SpatialIndex(const Bounds2D& staticWorldBounds = { glm::vec2(-1024.0f), glm::vec2(1024.0f) }, float dynamicCellSize = 2.0f);
+
+		void Insert(EntityId entity, const Bounds2D& bounds);
+		void Update(EntityId entity, const Bounds2D& bounds);
+		void Remove(EntityId entity);
+		bool Contains(EntityId entity) const;
+
+		/** Remove all entities for which predicate(EntityId) returns true. */
+		template<typename Predicate>
+		void RemoveIf(Predicate&& predicate)
+		{
+			for (EntityId entity : m_Entities)
+			{
+				if (entity != NullEntityId && predicate(entity))
+				{
+					Remove(entity);
+				}
+			}
+		}
+
+		uint32_t GetCount() const { return m_StaticObjects.GetCount() + m_DynamicObjects.GetCount(); }
+		uint32_t GetStaticCount() const { return m_StaticObjects.GetCount(); }
+		uint32_t GetDynamicCount() const { return m_DynamicObjects.GetCount(); }
+
+		void Clear();
+
+		/** Calls func(EntityId, const Bounds2D&) once for every entity intersecting area. */
+		template<typename Func>
+		void Query(const Bounds2D& area, Func&& func) const
+		{
+			m_StaticObjects.Query(area, func);
+			m_DynamicObjects.Query(area, func);
+		}
+
+	private:
+		enum class Location : uint8_t
+		{
+			None = 0, Static, Dynamic
+		};
+
+		Location GetLocation(EntityId entity) const;
+		bool FitsSpatialHash(const Bounds2D& bounds) const;
+
+	private:
+		LooseQuadtree m_StaticObjects;
+		SpatialHash m_DynamicObjects;
+
+		/** Indexed by entity index */
+		std::vector<EntityId> m_Entities;
+		std::vector<Location> m_Locations;
+	};
+
+}
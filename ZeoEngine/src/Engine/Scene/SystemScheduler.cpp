@@ -0,0 +1,131 @@
+#include "ZEpch.h"
+#include "Engine/Scene/SystemScheduler.h"
+
+namespace ZeoEngine {
+
+	static bool ContainsAny(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b)
+	{
+		for (uint32_t type : a)
+		{
+			if (std::find(b.begin(), b.end(), type) != b.end())
+				return true;
+		}
+		return false;
+	}
+
+	bool SystemAccess::ConflictsWith(const SystemAccess& other) const
+	{
+		if (m_bExclusive && other.m_bExclusive)
+			return true;
+
+		return ContainsAny(m_Writes, other.m_Writes) ||
+			ContainsAny(m_Writes, other.m_Reads) ||
+			ContainsAny(m_Reads, other.m_Writes);
+	}
+
+	void SystemScheduler::AddSystem(const std::string& name, const SystemAccess& access, SystemFunc func)
+	{
+		m_Systems.push_back({ name, access, std::move(func) });
+		m_bGraphDirty = true;
+	}
+
+	void SystemScheduler::RemoveSystem(const std::string& name)
+	{
+		auto it = std::find_if(m_Systems.begin(), m_Systems.end(), [&name](const SystemNode& system) { return system.Name == name; });
+		if (it == m_Systems.end())
+		{
+			ZE_CORE_WARN("Failed to remove system {0}: system not found!", name);
+			return;
+		}
+
+		m_Systems.erase(it);
+		m_bGraphDirty = true;
+	}
+
+	void SystemScheduler::BuildGraph()
+	{
+		ZE_PROFILE_FUNCTION();
+
+		const uint32_t systemCount = static_cast<uint32_t>(m_Systems.size());
+		for (auto& system : m_Systems)
+		{
+			system.Dependents.clear();
+			system.DependencyCount = 0;
+		}
+
+		// Edges only go from earlier to later systems so the graph is acyclic and registration order stays a valid execution order
+		for (uint32_t i = 0; i < systemCount; ++i)
+		{
+			for (uint32_t j = i + 1; j < systemCount; ++j)
+			{
+				if (m_Systems[i].Access.ConflictsWith(m_Systems[j].Access))
+				{
+					m_Systems[i].Dependents.push_back(j);
+					++m_Systems[j].DependencyCount;
+				}
+			}
+		}
+
+		m_PendingDependencies = std::make_unique<std::atomic<uint32_t>[]>(systemCount);
+		m_bGraphDirty = false;
+	}
+
+	void SystemScheduler::Run(Registry& registry, DeltaTime dt)
+	{
+		ZE_PROFILE_FUNCTION();
+
+		if (m_Systems.empty())
+			return;
+
+		if (m_bGraphDirty)
+		{
+			BuildGraph();
+		}
+
+		for (const auto& system : m_Systems)
+		{
+			for (auto createPool : system.Access.m_PoolCreators)
+			{
+				createPool(registry);
+			}
+		}
+
+		for (uint32_t i = 0; i < m_Systems.size(); ++i)
+		{
+			m_PendingDependencies[i].store(m_Systems[i].DependencyCount, std::memory_order_relaxed);
+		}
+
+		JobCounter counter;
+		for (uint32_t i = 0; i < m_Systems.size(); ++i)
+		{
+			if (m_Systems[i].DependencyCount == 0)
+			{
+				ScheduleSystem(i, registry, dt, counter);
+			}
+		}
+		JobSystem::Wait(counter);
+	}
+
+	void SystemScheduler::ScheduleSystem(uint32_t index, Registry& registry, DeltaTime dt, JobCounter& counter)
+	{
+		JobSystem::Execute([this, index, &registry, dt, &counter]()
+		{
+			const SystemNode& system = m_Systems[index];
+			{
+				ZE_PROFILE_SCOPE(system.Name.c_str());
+
+				system.Func(registry, dt);
+			}
+
+			// The last completed dependency releases the dependent system
+			for (uint32_t dependent : system.Dependents)
+			{
+				if (m_PendingDependencies[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+				{
+					ScheduleSystem(dependent, registry, dt, counter);
+				}
+			}
+		}, &counter);
+	}
+
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+#include "Engine/Core/DeltaTime.h"
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Scene/Registry.h"
+
+namespace ZeoEngine {
+
+	/**
+	 * Declares which component types a system reads and writes.
+	 * Two systems conflict if one of them writes a component type the other one reads or writes.
+	 */
+	class SystemAccess
+	{
+		friend class SystemScheduler;
+
+	public:
+		template<typename... Components>
+		SystemAccess& Read()
+		{
+			(Add<Components>(m_Reads), ...);
+			return *this;
+		}
+
+		template<typename... Components>
+		SystemAccess& Write()
+		{
+			(Add<Components>(m_Writes), ...);
+			return *this;
+		}
+
+		/** Systems touching data outside the registry (e.g. Renderer2D) can be serialized against each other this way. */
+		SystemAccess& Exclusive()
+		{
+			m_bExclusive = true;
+			return *this;
+		}
+
+		bool ConflictsWith(const SystemAccess& other) const;
+
+	private:
+		template<typename T>
+		void Add(std::vector<uint32_t>& types)
+		{
+			types.push_back(ComponentTypeIndex::Get<T>());
+			// Pools must exist before systems run, as creating them from worker threads would modify the registry concurrently
+			m_PoolCreators.push_back([](Registry& registry) { registry.GetPool<T>(); });
+		}
+
+	private:
+		std::vector<uint32_t> m_Reads;
+		std::vector<uint32_t> m_Writes;
+		std::vector<void(*)(Registry&)> m_PoolCreators;
+		bool m_bExclusive = false;
+	};
+
+	/**
+	 * Runs systems every frame, concurrently whenever their declared component access allows it.
+	 *
+	 * A system depends on every earlier registered system it conflicts with, so the result is the same as running them in registration order.
+	 * Systems must not create or destroy entities, nor add or remove components, while the scheduler is running.
+	 */
+	class SystemScheduler
+	{
+	public:
+		using SystemFunc = std::function<void(Registry&, DeltaTime)>;
+
+		void AddSystem(const std::string& name, const SystemAccess& access, SystemFunc func);
+		void RemoveSystem(const std::string& name);
+
+		/** Returns after all systems have completed. */
+		void Run(Registry& registry, DeltaTime dt);
+
+		uint32_t GetSystemCount() const { return static_cast<uint32_t>(m_Systems.size()); }
+
+	private:
+		void BuildGraph();
+		void ScheduleSystem(uint32_t index, Registry& registry, DeltaTime dt, JobCounter& counter);
+
+	private:
+		struct SystemNode
+		{
+			std::string Name;
+			SystemAccess Access;
+			SystemFunc Func;
+			/** Systems which cannot start before this one completes */
+			std::vector<uint32_t> Dependents;
+			uint32_t DependencyCount = 0;
+		};
+
+		std::vector<SystemNode> m_Systems;
+		/** Dependencies not yet completed in current run, indexed like m_Systems */
+		std::unique_ptr<std::atomic<uint32_t>[]> m_PendingDependencies;
+		bool m_bGraphDirty = false;
+	};
+
+	/**
+	 * Split the view into chunks and process them on the job system, returns after all chunks are done.
+	 * func must only touch components of the visited entity.
+	 */
+	template<typename... Components, typename Func>
+	void ParallelEach(const View<Components...>& view, Func&& func, uint32_t minChunkSize = 1024)
+	{
+		JobSystem::ParallelFor(view.GetSizeHint(), minChunkSize, [&view, &func](uint32_t begin, uint32_t end)
+		{
+			view.EachInRange(begin, end, func);
+		});
+	}
+
+}
@@ -9,14 +9,22 @@ namespace ZeoEngine {
 	// VertexBuffer //////////////////////////////////////////////////////////
 	//////////////////////////////////////////////////////////////////////////
 
-	OpenGLVertexBuffer::OpenGLVertexBuffer(float* vertices, uint32_t size)
+	OpenGLVertexBuffer::OpenGLVertexBuffer(uint32_t size)
 	{
 		ZE_PROFILE_FUNCTION();
 
-		// Call glCreateBuffers() instead of glGenBuffers() just for consistency
+		// Buffers are filled through their names so that creating one never changes the bindings of the current vertex array
 		glCreateBuffers(1, &m_RendererID);
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
-		glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
+		// Only allocate the storage here, data will be streamed in every frame
+		glNamedBufferData(m_RendererID, size, nullptr, GL_DYNAMIC_DRAW);
+	}
+
+	OpenGLVertexBuffer::OpenGLVertexBuffer(const void* vertices, uint32_t size)
+	{
+		ZE_PROFILE_FUNCTION();
+
+		glCreateBuffers(1, &m_RendererID);
+		glNamedBufferData(m_RendererID, size, vertices, GL_STATIC_DRAW);
 	}
 
 	OpenGLVertexBuffer::~OpenGLVertexBuffer()
@@ -40,18 +48,25 @@ namespace ZeoEngine {
 		glBindBuffer(GL_ARRAY_BUFFER, 0);
 	}
 
+	void OpenGLVertexBuffer::SetData(const void* data, uint32_t size)
+	{
+		ZE_PROFILE_FUNCTION();
+
+		glNamedBufferSubData(m_RendererID, 0, size, data);
+	}
+
 	//////////////////////////////////////////////////////////////////////////
 	// IndexBuffer ///////////////////////////////////////////////////////////
 	//////////////////////////////////////////////////////////////////////////
 
-	OpenGLIndexBuffer::OpenGLIndexBuffer(uint32_t* indices, uint32_t count)
-		: m_Count(count)
+	OpenGLIndexBuffer::OpenGLIndexBuffer(const void* indices, uint32_t count, IndexType indexType)
+		: m_Count(count), m_IndexType(indexType)
 	{
 		ZE_PROFILE_FUNCTION();
 
+		// Binding GL_ELEMENT_ARRAY_BUFFER here would attach the buffer to whichever vertex array is currently bound
 		glCreateBuffers(1, &m_RendererID);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(uint32_t), indices, GL_STATIC_DRAW);
+		glNamedBufferData(m_RendererID, count * IndexTypeSize(indexType), indices, GL_STATIC_DRAW);
 	}
 
 	OpenGLIndexBuffer::~OpenGLIndexBuffer()
@@ -7,12 +7,15 @@ namespace ZeoEngine {
 	class OpenGLVertexBuffer : public VertexBuffer
 	{
 	public:
-		OpenGLVertexBuffer(float* vertices, uint32_t size);
+		OpenGLVertexBuffer(uint32_t size);
+		OpenGLVertexBuffer(const void* vertices, uint32_t size);
 		virtual ~OpenGLVertexBuffer();
 
 		virtual void Bind() const override;
 		virtual void Unbind() const override;
 
+		virtual void SetData(const void* data, uint32_t size) override;
+
 		virtual const BufferLayout& GetLayout() const override { return m_Layout; }
 		virtual void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
 
@@ -25,17 +28,19 @@ namespace ZeoEngine {
 	class OpenGLIndexBuffer : public IndexBuffer
 	{
 	public:
-		OpenGLIndexBuffer(uint32_t* indices, uint32_t count);
+		OpenGLIndexBuffer(const void* indices, uint32_t count, IndexType indexType);
 		virtual ~OpenGLIndexBuffer();
 
 		virtual void Bind() const override;
 		virtual void Unbind() const override;
 
 		virtual uint32_t GetCount() const override { return m_Count; }
+		virtual IndexType GetIndexType() const override { return m_IndexType; }
 
 	private:
 		uint32_t m_RendererID;
 		uint32_t m_Count;
+		IndexType m_IndexType;
 
 	};
 
@@ -23,6 +23,32 @@ namespace ZeoEngine {
 		ZE_CORE_INFO("Vendor: {0}", glGetString(GL_VENDOR));
 		ZE_CORE_INFO("Renderer: {0}", glGetString(GL_RENDERER));
 		ZE_CORE_INFO("Version: {0}", glGetString(GL_VERSION));
+
+		EnableParallelShaderCompile();
+	}
+
+	void OpenGLContext::EnableParallelShaderCompile()
+	{
+		ZE_PROFILE_FUNCTION();
+
+		// Glad is generated without extensions, so load the entry point manually
+		typedef void (APIENTRYP PFNGLMAXSHADERCOMPILERTHREADSPROC)(GLuint count);
+		PFNGLMAXSHADERCOMPILERTHREADSPROC maxShaderCompilerThreads = nullptr;
+		if (glfwExtensionSupported("GL_KHR_parallel_shader_compile"))
+		{
+			maxShaderCompilerThreads = (PFNGLMAXSHADERCOMPILERTHREADSPROC)glfwGetProcAddress("glMaxShaderCompilerThreadsKHR");
+		}
+		else if (glfwExtensionSupported("GL_ARB_parallel_shader_compile"))
+		{
+			maxShaderCompilerThreads = (PFNGLMAXSHADERCOMPILERTHREADSPROC)glfwGetProcAddress("glMaxShaderCompilerThreadsARB");
+		}
+
+		if (maxShaderCompilerThreads)
+		{
+			// 0xFFFFFFFF lets the driver decide the number of threads
+			maxShaderCompilerThreads(0xFFFFFFFF);
+			ZE_CORE_INFO("Parallel shader compilation enabled");
+		}
 	}
 
 	void OpenGLContext::SwapBuffers()
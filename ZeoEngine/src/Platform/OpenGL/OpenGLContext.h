@@ -14,6 +14,10 @@ namespace ZeoEngine {
 		virtual void Init() override;
 		virtual void SwapBuffers() override;
 
+	private:
+		/** Let the driver compile shaders on its own threads if GL_KHR_parallel_shader_compile is available. */
+		void EnableParallelShaderCompile();
+
 	private:
 		GLFWwindow* m_WindowHandle;
 
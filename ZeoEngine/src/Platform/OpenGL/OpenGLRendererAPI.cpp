@@ -3,22 +3,32 @@
 
 #include <glad/glad.h>
 
+#include "Platform/OpenGL/OpenGLStateCache.h"
+
 namespace ZeoEngine {
 
 	void OpenGLRendererAPI::Init()
 	{
 		ZE_PROFILE_FUNCTION();
 
-		glEnable(GL_BLEND);
-		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		OpenGLStateCache::SetBlendEnabled(true);
+		OpenGLStateCache::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+		OpenGLStateCache::SetDepthTestEnabled(true);
+		OpenGLStateCache::SetDepthWriteEnabled(true);
 
-		glEnable(GL_DEPTH_TEST);
+		GLint uniformBufferOffsetAlignment;
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformBufferOffsetAlignment);
+		m_UniformBufferOffsetAlignment = static_cast<uint32_t>(uniformBufferOffsetAlignment);
 
+		GLint maxTextureImageUnits;
+		glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &maxTextureImageUnits);
+		m_MaxTextureSlots = static_cast<uint32_t>(maxTextureImageUnits);
 	}
 
 	void OpenGLRendererAPI::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
 	{
-		glViewport(x, y, width, height);
+		OpenGLStateCache::SetViewport(x, y, width, height);
 	}
 
 	void OpenGLRendererAPI::SetClearColor(const glm::vec4& color)
@@ -31,11 +41,54 @@ namespace ZeoEngine {
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 	}
 
-	void OpenGLRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray)
+	void OpenGLRendererAPI::SetBlendEnabled(bool bEnabled)
+	{
+		OpenGLStateCache::SetBlendEnabled(bEnabled);
+	}
+
+	void OpenGLRendererAPI::SetDepthTestEnabled(bool bEnabled)
+	{
+		OpenGLStateCache::SetDepthTestEnabled(bEnabled);
+	}
+
+	void OpenGLRendererAPI::SetDepthWriteEnabled(bool bEnabled)
+	{
+		OpenGLStateCache::SetDepthWriteEnabled(bEnabled);
+	}
+
+	void OpenGLRendererAPI::SetLineWidth(float width)
+	{
+		OpenGLStateCache::SetLineWidth(width);
+	}
+
+	void OpenGLRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t baseVertex)
+	{
+		const Ref<IndexBuffer>& indexBuffer = vertexArray->GetIndexBuffer();
+		uint32_t count = indexCount ? indexCount : indexBuffer->GetCount();
+		GLenum indexType = indexBuffer->GetIndexType() == IndexType::UInt16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+		if (baseVertex == 0)
+		{
+			glDrawElements(GL_TRIANGLES, count, indexType, nullptr);
+		}
+		else
+		{
+			glDrawElementsBaseVertex(GL_TRIANGLES, count, indexType, nullptr, static_cast<GLint>(baseVertex));
+		}
+	}
+
+	void OpenGLRendererAPI::DrawLines(const Ref<VertexArray>& vertexArray, uint32_t vertexCount)
+	{
+		glDrawArrays(GL_LINES, 0, vertexCount);
+	}
+
+	OpenGLRendererAPI::StateStatistics OpenGLRendererAPI::GetStateStats() const
+	{
+		return OpenGLStateCache::GetStats();
+	}
+
+	void OpenGLRendererAPI::ResetStateStats()
 	{
-		glDrawElements(GL_TRIANGLES, vertexArray->GetIndexBuffer()->GetCount(), GL_UNSIGNED_INT, nullptr);
-		// Unbind texture slot
-		glBindTexture(GL_TEXTURE_2D, 0);
+		OpenGLStateCache::ResetStats();
 	}
 
 }
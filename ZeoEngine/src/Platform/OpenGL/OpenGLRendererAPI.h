@@ -14,7 +14,24 @@ namespace ZeoEngine {
 		virtual void SetClearColor(const glm::vec4& color) override;
 		virtual void Clear() override;
 
-		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray) override;
+		virtual void SetBlendEnabled(bool bEnabled) override;
+		virtual void SetDepthTestEnabled(bool bEnabled) override;
+		virtual void SetDepthWriteEnabled(bool bEnabled) override;
+		virtual void SetLineWidth(float width) override;
+
+		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0, uint32_t baseVertex = 0) override;
+		virtual void DrawLines(const Ref<VertexArray>& vertexArray, uint32_t vertexCount) override;
+
+		virtual uint32_t GetUniformBufferOffsetAlignment() const override { return m_UniformBufferOffsetAlignment; }
+		virtual uint32_t GetMaxTextureSlots() const override { return m_MaxTextureSlots; }
+
+		virtual StateStatistics GetStateStats() const override;
+		virtual void ResetStateStats() override;
+
+	private:
+		uint32_t m_UniformBufferOffsetAlignment = 256;
+		/** Minimum guaranteed by OpenGL until queried */
+		uint32_t m_MaxTextureSlots = 16;
 
 	};
 
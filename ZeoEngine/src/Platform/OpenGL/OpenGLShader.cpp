@@ -2,9 +2,13 @@
 #include "Platform/OpenGL/OpenGLShader.h"
 
 #include <fstream>
+#include <filesystem>
 
 #include <glad/glad.h>
 
+#include "Engine/Core/JobSystem.h"
+#include "Platform/OpenGL/OpenGLStateCache.h"
+
 #include <glm/gtc/type_ptr.hpp>
 
 namespace ZeoEngine {
@@ -15,26 +19,86 @@ namespace ZeoEngine {
 			return GL_VERTEX_SHADER;
 		if (type == "fragment" || type == "pixel")
 			return GL_FRAGMENT_SHADER;
+		if (type == "geometry")
+			return GL_GEOMETRY_SHADER;
+		if (type == "compute")
+			return GL_COMPUTE_SHADER;
 
 		ZE_CORE_ASSERT(false, "Unknown shader type '{0}'!", type);
 		return 0;
 	}
 
-	OpenGLShader::OpenGLShader(const std::string& filePath)
+	static const char* s_CacheDirectory = "assets/cache/shader/opengl";
+	/** Used to reject cache files written by an incompatible version of the engine */
+	static const uint32_t s_CacheMagic = 0x5A455342; // "ZESB"
+
+	struct ShaderCacheHeader
+	{
+		uint32_t Magic;
+		uint32_t BinaryFormat;
+		uint64_t CacheKey;
+		uint32_t BinaryLength;
+	};
+
+	/** FNV-1a, which is stable across runs unlike std::hash. */
+	static uint64_t HashString(const std::string& str, uint64_t hash = 14695981039346656037ull)
+	{
+		for (char c : str)
+		{
+			hash ^= static_cast<uint8_t>(c);
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	/** Program binaries are only valid for the exact driver they were created with. */
+	static const std::string& GetDriverString()
+	{
+		static std::string driverString = std::string((const char*)glGetString(GL_VENDOR)) + "|" +
+			(const char*)glGetString(GL_RENDERER) + "|" +
+			(const char*)glGetString(GL_VERSION);
+		return driverString;
+	}
+
+	static uint64_t GetCacheKey(const std::unordered_map<GLenum, std::string>& shaderSrcs)
+	{
+		// Iteration order of std::unordered_map is unspecified, so hash stages in a fixed order
+		std::vector<GLenum> types;
+		types.reserve(shaderSrcs.size());
+		for (auto& pair : shaderSrcs)
+		{
+			types.push_back(pair.first);
+		}
+		std::sort(types.begin(), types.end());
+
+		uint64_t hash = HashString(GetDriverString());
+		for (GLenum type : types)
+		{
+			hash = HashString(std::to_string(type), hash);
+			hash = HashString(shaderSrcs.at(type), hash);
+		}
+		return hash;
+	}
+
+	OpenGLShader::OpenGLShader(const std::string& filePath, const ShaderDefines& defines)
+		: m_VariantKey(ShaderPreprocessor::GetDefinesKey(defines))
 	{
 		ZE_PROFILE_FUNCTION();
 
-		std::string src = ReadFile(filePath);
-		auto shaderSrcs = PreProcess(src);
+		// Name is required before compiling as it is used to locate the cache file
+		m_Name = GetNameFromFilePath(filePath);
+
+		auto shaderSrcs = PreProcess(ShaderPreprocessor::Process(filePath, defines));
 		Compile(shaderSrcs);
+	}
+
+	OpenGLShader::OpenGLShader(const std::string& name, const ShaderSources& shaderSrcs)
+		: m_Name(name)
+	{
+		ZE_PROFILE_FUNCTION();
 
-		// Extract name from file path
-		// "assets/shaders/Texture.glsl" -> "Texture"
-		auto lastSlash = filePath.find_last_of("/\\"); // find_last_of() will find ANY of the provided characters
-		lastSlash = lastSlash == std::string::npos ? 0 : lastSlash + 1;
-		auto lastDot = filePath.rfind("."); // rfind() will find EXACTLY the provided characters
-		auto count = lastDot == std::string::npos ? filePath.size() - lastSlash /** File without extension */ : lastDot - lastSlash;
-		m_Name = filePath.substr(lastSlash, count);
+		// Results are checked by FinishCompile() so that other shaders can be compiled in the meantime
+		IssueCompile(PreProcess(shaderSrcs));
 	}
 
 	OpenGLShader::OpenGLShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc)
@@ -53,81 +117,69 @@ namespace ZeoEngine {
 		ZE_PROFILE_FUNCTION();
 
 		glDeleteProgram(m_RendererID);
+		OpenGLStateCache::OnProgramDeleted(m_RendererID);
 	}
 
-	std::string OpenGLShader::ReadFile(const std::string& filePath)
+	std::unordered_map<GLenum, std::string> OpenGLShader::PreProcess(const ShaderSources& srcs)
 	{
 		ZE_PROFILE_FUNCTION();
 
-		std::string result;
-		std::ifstream in(filePath, std::ios::in | std::ios::binary);
-		if (in)
-		{
-			in.seekg(0, std::ios::end);
-			size_t size = in.tellg();
-			if (size == -1)
-			{
-				ZE_CORE_ERROR("Could not read from file '{0}'!", filePath);
-			}
-			else
-			{
-				result.resize(size);
-				in.seekg(0, std::ios::beg);
-				in.read(&result[0], size);
-				in.close();
-			}
-		}
-		else
+		std::unordered_map<GLenum, std::string> shaderSrcs;
+		for (auto& pair : srcs)
 		{
-			ZE_CORE_ERROR("Could not open file: '{0}'", filePath);
+			GLenum type = ShaderTypeFromString(pair.first);
+			ZE_CORE_ASSERT(type, "Invalid shader type token!");
+			shaderSrcs[type] = pair.second;
 		}
 
-		return result;
+		return shaderSrcs;
 	}
 
-	std::unordered_map<GLenum, std::string> OpenGLShader::PreProcess(const std::string& src)
+	void OpenGLShader::Compile(const std::unordered_map<GLenum, std::string>& shaderSrcs)
 	{
 		ZE_PROFILE_FUNCTION();
 
-		std::unordered_map<GLenum, std::string> shaderSrcs;
+		IssueCompile(shaderSrcs);
+		bool bLinked = FinishCompile();
+		ZE_CORE_ASSERT(bLinked, "Failed to link shader program!");
+	}
+
+	bool OpenGLShader::Reload(const ShaderSources& shaderSrcs)
+	{
+		ZE_PROFILE_FUNCTION();
 
-		const char* typeToken = "#type";
-		size_t typeTokenLength = strlen(typeToken);
-		// Location of shader type
-		size_t typeTokenPos = src.find(typeToken, 0);
-		while (typeTokenPos != std::string::npos)
+		// Make sure the current program is complete so that we can fall back to it
+		FinishCompile();
+		uint32_t oldProgram = m_RendererID;
+
+		IssueCompile(PreProcess(shaderSrcs));
+		if (!FinishCompile())
 		{
-			// End of line
-			size_t eol = src.find_first_of("\r\n", typeTokenPos);
-			ZE_CORE_ASSERT(eol != std::string::npos, "Syntax error!");
-
-			size_t typePos = typeTokenPos + typeTokenLength + 1;
-			// Get shader type
-			std::string type = src.substr(typePos, eol - typePos);
-			ZE_CORE_ASSERT(ShaderTypeFromString(type), "Invalid shader type token!");
-
-			// Beginning of shader source: "#version..."
-			size_t shaderSrcPos = src.find_first_not_of("\r\n", eol);
-			// Locate the next shader type
-			typeTokenPos = src.find(typeToken, shaderSrcPos);
-			// Get shader source code
-			shaderSrcs[ShaderTypeFromString(type)]
-				= src.substr(shaderSrcPos, typeTokenPos - (shaderSrcPos == std::string::npos ? src.size() - 1 : shaderSrcPos));
+			ZE_CORE_ERROR("Failed to reload shader '{0}', the previous version will be kept", m_Name);
+			m_RendererID = oldProgram;
+			return false;
 		}
 
-		return shaderSrcs;
+		glDeleteProgram(oldProgram);
+		OpenGLStateCache::OnProgramDeleted(oldProgram);
+		ZE_CORE_INFO("Reloaded shader '{0}'", m_Name);
+		return true;
 	}
 
-	void OpenGLShader::Compile(const std::unordered_map<GLenum, std::string>& shaderSrcs)
+	void OpenGLShader::IssueCompile(const std::unordered_map<GLenum, std::string>& shaderSrcs)
 	{
 		ZE_PROFILE_FUNCTION();
 
+		m_CacheKey = GetCacheKey(shaderSrcs);
+		if (LoadProgramBinary(m_CacheKey))
+			return;
+
 		GLuint program = glCreateProgram();
-		// Since std::vector is a heap-allocated array, it is not efficient enough for a game engine
-		// We prefer to use stack-allocated array like std::array
-		ZE_CORE_ASSERT(shaderSrcs.size() <= 2, "Only up to two shaders are supported for now!");
-		std::array<GLuint, 2> glShaderIds;
-		int glShaderId = 0;
+		// Let the driver know we are going to retrieve the binary after linking
+		glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		ZE_CORE_ASSERT(shaderSrcs.size() <= m_PendingShaderIds.size(), "Only up to three shader stages are supported!");
+		ZE_CORE_ASSERT(shaderSrcs.find(GL_COMPUTE_SHADER) == shaderSrcs.end() || shaderSrcs.size() == 1, "Compute shader cannot be linked with other stages!");
+		m_PendingShaderCount = 0;
 		for (auto& pair : shaderSrcs)
 		{
 			GLenum type = pair.first;
@@ -139,38 +191,55 @@ namespace ZeoEngine {
 			const GLchar* srcChar = src.c_str();
 			glShaderSource(shader, 1, &srcChar, 0);
 
+			// Compile status is not queried here as that would stall until the driver finishes compiling,
+			// a failed stage will fail the link anyway
 			glCompileShader(shader);
 
-			GLint isCompiled = 0;
-			glGetShaderiv(shader, GL_COMPILE_STATUS, &isCompiled);
-			if (isCompiled == GL_FALSE)
-			{
-				GLint maxLength = 0;
-				glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &maxLength);
+			glAttachShader(program, shader);
+			m_PendingShaderIds[m_PendingShaderCount++] = shader;
+		}
 
-				// The maxLength includes the NULL character
-				std::vector<GLchar> infoLog(maxLength);
-				glGetShaderInfoLog(shader, maxLength, &maxLength, &infoLog[0]);
+		glLinkProgram(program);
 
-				// We don't need the shader anymore
-				glDeleteShader(shader);
+		m_RendererID = program;
+		m_bLinkPending = true;
+	}
 
-				ZE_CORE_ERROR("{0}", infoLog.data());
-				ZE_CORE_ASSERT(false, "Failed to compile shader!");
-				break;
-			}
+	bool OpenGLShader::FinishCompile()
+	{
+		if (!m_bLinkPending)
+			return m_RendererID != 0;
 
-			glAttachShader(program, shader);
-			glShaderIds[glShaderId++] = shader;
-		}
+		ZE_PROFILE_FUNCTION();
 
-		glLinkProgram(program);
+		m_bLinkPending = false;
+		GLuint program = m_RendererID;
 
 		// Note the different functions here: glGetProgram* instead of glGetShader*.
 		GLint isLinked = 0;
 		glGetProgramiv(program, GL_LINK_STATUS, (int*)&isLinked);
 		if (isLinked == GL_FALSE)
 		{
+			// Report the stage which failed to compile first as it is the actual cause
+			for (uint32_t i = 0; i < m_PendingShaderCount; ++i)
+			{
+				GLuint shader = m_PendingShaderIds[i];
+				GLint isCompiled = 0;
+				glGetShaderiv(shader, GL_COMPILE_STATUS, &isCompiled);
+				if (isCompiled == GL_FALSE)
+				{
+					GLint maxLength = 0;
+					glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &maxLength);
+
+					// The maxLength includes the NULL character
+					std::vector<GLchar> infoLog(maxLength);
+					glGetShaderInfoLog(shader, maxLength, &maxLength, &infoLog[0]);
+
+					ZE_CORE_ERROR("{0}", infoLog.data());
+					ZE_CORE_ERROR("Failed to compile shader '{0}'!", m_Name);
+				}
+			}
+
 			GLint maxLength = 0;
 			glGetProgramiv(program, GL_INFO_LOG_LENGTH, &maxLength);
 
@@ -180,41 +249,133 @@ namespace ZeoEngine {
 
 			// We don't need the program anymore
 			glDeleteProgram(program);
+			m_RendererID = 0;
 
-			for (auto id : glShaderIds)
+			for (uint32_t i = 0; i < m_PendingShaderCount; ++i)
 			{
 				// Don't leak shaders either
-				glDeleteShader(id);
+				glDeleteShader(m_PendingShaderIds[i]);
 			}
+			m_PendingShaderCount = 0;
 
 			ZE_CORE_ERROR("{0}", infoLog.data());
-			ZE_CORE_ASSERT(false, "Failed to link shader program!");
-			return;
+			ZE_CORE_ERROR("Failed to link shader program '{0}'!", m_Name);
+			return false;
 		}
 
-		for (auto id : glShaderIds)
+		for (uint32_t i = 0; i < m_PendingShaderCount; ++i)
 		{
 			// Always detach shaders after a successful link
-			glDetachShader(program, id);
-			glDeleteShader(id);
+			glDetachShader(program, m_PendingShaderIds[i]);
+			glDeleteShader(m_PendingShaderIds[i]);
+		}
+		m_PendingShaderCount = 0;
+
+		SaveProgramBinary(m_CacheKey);
+		return true;
+	}
+
+	std::string OpenGLShader::GetCacheFilePath() const
+	{
+		if (m_VariantKey.empty())
+			return std::string(s_CacheDirectory) + "/" + m_Name + ".glbin";
+
+		// Each variant has its own cache file so that variants do not keep invalidating each other
+		std::stringstream ss;
+		ss << s_CacheDirectory << "/" << m_Name << "_" << std::hex << HashString(m_VariantKey) << ".glbin";
+		return ss.str();
+	}
+
+	bool OpenGLShader::LoadProgramBinary(uint64_t cacheKey)
+	{
+		ZE_PROFILE_FUNCTION();
+
+		GLint formatCount = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+		if (formatCount == 0)
+			return false;
+
+		std::ifstream in(GetCacheFilePath(), std::ios::in | std::ios::binary);
+		if (!in)
+			return false;
+
+		ShaderCacheHeader header;
+		in.read(reinterpret_cast<char*>(&header), sizeof(ShaderCacheHeader));
+		// Sources or driver have changed since the cache was written
+		if (!in || header.Magic != s_CacheMagic || header.CacheKey != cacheKey)
+			return false;
+
+		std::vector<char> binary(header.BinaryLength);
+		in.read(binary.data(), header.BinaryLength);
+		if (!in)
+			return false;
+
+		GLuint program = glCreateProgram();
+		glProgramBinary(program, header.BinaryFormat, binary.data(), header.BinaryLength);
+
+		// The driver may still reject the binary e.g. after a silent driver update
+		GLint isLinked = 0;
+		glGetProgramiv(program, GL_LINK_STATUS, &isLinked);
+		if (isLinked == GL_FALSE)
+		{
+			ZE_CORE_WARN("Shader cache of '{0}' was rejected by the driver, recompiling...", m_Name);
+			glDeleteProgram(program);
+			return false;
 		}
 
-		// If everything works fine, assign the program id
 		m_RendererID = program;
+		return true;
+	}
+
+	void OpenGLShader::SaveProgramBinary(uint64_t cacheKey) const
+	{
+		ZE_PROFILE_FUNCTION();
+
+		GLint formatCount = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+		if (formatCount == 0)
+			return;
+
+		GLint binaryLength = 0;
+		glGetProgramiv(m_RendererID, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+		if (binaryLength == 0)
+			return;
+
+		std::vector<char> binary(binaryLength);
+		GLenum binaryFormat = 0;
+		glGetProgramBinary(m_RendererID, binaryLength, nullptr, &binaryFormat, binary.data());
+
+		// Only retrieving the binary needs the context, file IO is moved off the render thread
+		ShaderCacheHeader header = { s_CacheMagic, binaryFormat, cacheKey, static_cast<uint32_t>(binaryLength) };
+		JobSystem::ExecuteBackground([filePath = GetCacheFilePath(), header, binary = std::move(binary)]()
+		{
+			std::error_code error;
+			std::filesystem::create_directories(s_CacheDirectory, error);
+			std::ofstream out(filePath, std::ios::out | std::ios::binary);
+			if (!out)
+			{
+				ZE_CORE_WARN("Could not write shader cache: '{0}'", filePath);
+				return;
+			}
+
+			out.write(reinterpret_cast<const char*>(&header), sizeof(ShaderCacheHeader));
+			out.write(binary.data(), binary.size());
+		});
 	}
 
 	void OpenGLShader::Bind() const
 	{
 		ZE_PROFILE_FUNCTION();
 
-		glUseProgram(m_RendererID);
+		ZE_CORE_ASSERT(!m_bLinkPending, "FinishCompile() must be called before binding an asynchronously compiled shader!");
+		OpenGLStateCache::UseProgram(m_RendererID);
 	}
 
 	void OpenGLShader::Unbind() const
 	{
 		ZE_PROFILE_FUNCTION();
 
-		glUseProgram(0);
+		OpenGLStateCache::UseProgram(0);
 	}
 
 	void OpenGLShader::SetInt(const std::string& name, int value)
@@ -224,6 +385,13 @@ namespace ZeoEngine {
 		UploadUniformInt(name, value);
 	}
 
+	void OpenGLShader::SetIntArray(const std::string& name, int* values, uint32_t count)
+	{
+		ZE_PROFILE_FUNCTION();
+
+		UploadUniformIntArray(name, values, count);
+	}
+
 	void OpenGLShader::SetFloat(const std::string& name, float value)
 	{
 		ZE_PROFILE_FUNCTION();
@@ -258,6 +426,12 @@ namespace ZeoEngine {
 		glUniform1i(location, value);
 	}
 
+	void OpenGLShader::UploadUniformIntArray(const std::string& name, int* values, uint32_t count)
+	{
+		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		glUniform1iv(location, count, values);
+	}
+
 	void OpenGLShader::UploadUniformFloat(const std::string& name, float value)
 	{
 		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
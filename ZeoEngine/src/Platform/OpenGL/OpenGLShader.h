@@ -10,14 +10,17 @@ namespace ZeoEngine {
 	class OpenGLShader : public Shader
 	{
 	public:
-		OpenGLShader(const std::string& filePath);
+		OpenGLShader(const std::string& filePath, const ShaderDefines& defines = {});
 		OpenGLShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc);
+		/** Issue compiling and linking of already preprocessed sources without waiting for the results. */
+		OpenGLShader(const std::string& name, const ShaderSources& shaderSrcs);
 		virtual ~OpenGLShader();
 
 		virtual void Bind() const override;
 		virtual void Unbind() const override;
 
 		virtual void SetInt(const std::string& name, int value) override;
+		virtual void SetIntArray(const std::string& name, int* values, uint32_t count) override;
 		virtual void SetFloat(const std::string& name, float value) override;
 		virtual void SetFloat3(const std::string& name, const glm::vec3& value) override;
 		virtual void SetFloat4(const std::string& name, const glm::vec4& value) override;
@@ -25,7 +28,11 @@ namespace ZeoEngine {
 
 		virtual const std::string& GetName() const override { return m_Name; }
 
+		virtual bool Reload(const ShaderSources& shaderSrcs) override;
+		virtual bool FinishCompile() override;
+
 		void UploadUniformInt(const std::string& name, int value);
+		void UploadUniformIntArray(const std::string& name, int* values, uint32_t count);
 
 		void UploadUniformFloat(const std::string& name, float value);
 		void UploadUniformFloat2(const std::string& name, const glm::vec2& values);
@@ -36,13 +43,27 @@ namespace ZeoEngine {
 		void UploadUniformMat4(const std::string& name, const glm::mat4& matrix);
 
 	private:
-		std::string ReadFile(const std::string& filePath);
-		std::unordered_map<GLenum, std::string> PreProcess(const std::string& src);
+		/** Convert stage names to GL shader types. */
+		std::unordered_map<GLenum, std::string> PreProcess(const ShaderSources& srcs);
 		void Compile(const std::unordered_map<GLenum, std::string>& shaderSrcs);
+		/** Issue compile and link commands without querying their status which would force the driver to sync. */
+		void IssueCompile(const std::unordered_map<GLenum, std::string>& shaderSrcs);
+
+		/** Try to create the program from the cached binary, returns false if the cache is missing or out of date. */
+		bool LoadProgramBinary(uint64_t cacheKey);
+		/** Retrieve the binary of the linked program and write it to disk on a background job so that the next launch can skip compilation. */
+		void SaveProgramBinary(uint64_t cacheKey) const;
+		std::string GetCacheFilePath() const;
 
 	private:
-		uint32_t m_RendererID;
+		uint32_t m_RendererID = 0;
+		bool m_bLinkPending = false;
+		std::array<uint32_t, 3> m_PendingShaderIds;
+		uint32_t m_PendingShaderCount = 0;
+		uint64_t m_CacheKey = 0;
 		std::string m_Name;
+		/** Identifies the define set this variant is compiled with, empty for the default variant */
+		std::string m_VariantKey;
 
 	};
 
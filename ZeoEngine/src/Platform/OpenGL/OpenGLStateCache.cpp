@@ -0,0 +1,200 @@
+#include "ZEpch.h"
+#include "Platform/OpenGL/OpenGLStateCache.h"
+
+#include <glad/glad.h>
+
+namespace ZeoEngine {
+
+	/** Value of cached state which is not known, any call will be issued */
+	static constexpr uint32_t s_UnknownState = 0xFFFFFFFF;
+
+	struct OpenGLStateCacheData
+	{
+		/** Binding to units beyond this range is always issued */
+		static const uint32_t MaxCachedTextureUnits = 32;
+
+		uint32_t Program = s_UnknownState;
+		uint32_t VertexArray = s_UnknownState;
+		std::array<uint32_t, MaxCachedTextureUnits> TextureUnits;
+
+		uint32_t BlendEnabled = s_UnknownState;
+		uint32_t BlendSrcFactor = s_UnknownState;
+		uint32_t BlendDstFactor = s_UnknownState;
+		uint32_t DepthTestEnabled = s_UnknownState;
+		uint32_t DepthWriteEnabled = s_UnknownState;
+		/** Bits of the float value, NaN is never set as a width */
+		uint32_t LineWidth = s_UnknownState;
+		std::array<uint32_t, 4> Viewport;
+
+		RendererAPI::StateStatistics Stats;
+
+		OpenGLStateCacheData()
+		{
+			TextureUnits.fill(s_UnknownState);
+			Viewport.fill(s_UnknownState);
+		}
+	};
+
+	static OpenGLStateCacheData s_StateData;
+
+	/** Update cached value and return true if the call needs to be issued. */
+	static bool UpdateState(uint32_t& cachedValue, uint32_t newValue)
+	{
+		if (cachedValue == newValue)
+		{
+			++s_StateData.Stats.SkippedCalls;
+			return false;
+		}
+
+		cachedValue = newValue;
+		++s_StateData.Stats.IssuedCalls;
+		return true;
+	}
+
+	static void SetCapability(GLenum capability, uint32_t& cachedValue, bool bEnabled)
+	{
+		if (UpdateState(cachedValue, bEnabled ? 1 : 0))
+		{
+			if (bEnabled)
+			{
+				glEnable(capability);
+			}
+			else
+			{
+				glDisable(capability);
+			}
+		}
+	}
+
+	void OpenGLStateCache::UseProgram(uint32_t program)
+	{
+		if (UpdateState(s_StateData.Program, program))
+		{
+			glUseProgram(program);
+		}
+	}
+
+	void OpenGLStateCache::BindVertexArray(uint32_t vertexArray)
+	{
+		if (UpdateState(s_StateData.VertexArray, vertexArray))
+		{
+			glBindVertexArray(vertexArray);
+		}
+	}
+
+	void OpenGLStateCache::BindTextureUnit(uint32_t unit, uint32_t texture)
+	{
+		if (unit >= OpenGLStateCacheData::MaxCachedTextureUnits)
+		{
+			++s_StateData.Stats.IssuedCalls;
+			glBindTextureUnit(unit, texture);
+			return;
+		}
+
+		if (UpdateState(s_StateData.TextureUnits[unit], texture))
+		{
+			glBindTextureUnit(unit, texture);
+		}
+	}
+
+	void OpenGLStateCache::SetBlendEnabled(bool bEnabled)
+	{
+		SetCapability(GL_BLEND, s_StateData.BlendEnabled, bEnabled);
+	}
+
+	void OpenGLStateCache::SetBlendFunc(uint32_t srcFactor, uint32_t dstFactor)
+	{
+		if (s_StateData.BlendSrcFactor == srcFactor && s_StateData.BlendDstFactor == dstFactor)
+		{
+			++s_StateData.Stats.SkippedCalls;
+			return;
+		}
+
+		s_StateData.BlendSrcFactor = srcFactor;
+		s_StateData.BlendDstFactor = dstFactor;
+		++s_StateData.Stats.IssuedCalls;
+		glBlendFunc(srcFactor, dstFactor);
+	}
+
+	void OpenGLStateCache::SetDepthTestEnabled(bool bEnabled)
+	{
+		SetCapability(GL_DEPTH_TEST, s_StateData.DepthTestEnabled, bEnabled);
+	}
+
+	void OpenGLStateCache::SetDepthWriteEnabled(bool bEnabled)
+	{
+		if (UpdateState(s_StateData.DepthWriteEnabled, bEnabled ? 1 : 0))
+		{
+			glDepthMask(bEnabled ? GL_TRUE : GL_FALSE);
+		}
+	}
+
+	void OpenGLStateCache::SetLineWidth(float width)
+	{
+		uint32_t widthBits;
+		memcpy(&widthBits, &width, sizeof(widthBits));
+		if (UpdateState(s_StateData.LineWidth, widthBits))
+		{
+			glLineWidth(width);
+		}
+	}
+
+	void OpenGLStateCache::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+	{
+		std::array<uint32_t, 4> viewport = { x, y, width, height };
+		if (s_StateData.Viewport == viewport)
+		{
+			++s_StateData.Stats.SkippedCalls;
+			return;
+		}
+
+		s_StateData.Viewport = viewport;
+		++s_StateData.Stats.IssuedCalls;
+		glViewport(x, y, width, height);
+	}
+
+	void OpenGLStateCache::OnProgramDeleted(uint32_t program)
+	{
+		if (s_StateData.Program == program)
+		{
+			s_StateData.Program = s_UnknownState;
+		}
+	}
+
+	void OpenGLStateCache::OnVertexArrayDeleted(uint32_t vertexArray)
+	{
+		if (s_StateData.VertexArray == vertexArray)
+		{
+			s_StateData.VertexArray = s_UnknownState;
+		}
+	}
+
+	void OpenGLStateCache::OnTextureDeleted(uint32_t texture)
+	{
+		for (auto& unit : s_StateData.TextureUnits)
+		{
+			if (unit == texture)
+			{
+				unit = s_UnknownState;
+			}
+		}
+	}
+
+	void OpenGLStateCache::Invalidate()
+	{
+		RendererAPI::StateStatistics stats = s_StateData.Stats;
+		s_StateData = OpenGLStateCacheData();
+		s_StateData.Stats = stats;
+	}
+
+	RendererAPI::StateStatistics OpenGLStateCache::GetStats()
+	{
+		return s_StateData.Stats;
+	}
+
+	void OpenGLStateCache::ResetStats()
+	{
+		s_StateData.Stats = RendererAPI::StateStatistics();
+	}
+
+}
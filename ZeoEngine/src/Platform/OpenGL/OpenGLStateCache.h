@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Engine/Renderer/RendererAPI.h"
+
+namespace ZeoEngine {
+
+	/**
+	 * Shadows OpenGL state of the main context and filters out calls which would not change it.
+	 * All state changes of the OpenGL backend must go through this class, otherwise the cache gets out of sync.
+	 * Code outside the backend (e.g. ImGui) must restore the state it changes.
+	 */
+	class OpenGLStateCache
+	{
+	public:
+		static void UseProgram(uint32_t program);
+		static void BindVertexArray(uint32_t vertexArray);
+		static void BindTextureUnit(uint32_t unit, uint32_t texture);
+
+		static void SetBlendEnabled(bool bEnabled);
+		static void SetBlendFunc(uint32_t srcFactor, uint32_t dstFactor);
+		static void SetDepthTestEnabled(bool bEnabled);
+		static void SetDepthWriteEnabled(bool bEnabled);
+		static void SetLineWidth(float width);
+		static void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+
+		/** Must be called when an object is deleted, as its name may be reused by a new one. */
+		static void OnProgramDeleted(uint32_t program);
+		static void OnVertexArrayDeleted(uint32_t vertexArray);
+		static void OnTextureDeleted(uint32_t texture);
+
+		/** Forget all cached state, so that the next call of each kind always reaches the driver. */
+		static void Invalidate();
+
+		static RendererAPI::StateStatistics GetStats();
+		static void ResetStats();
+	};
+
+}
@@ -1,9 +1,42 @@
 #include "ZEpch.h"
 #include "Platform/OpenGL/OpenGLTexture.h"
 
-#include <stb_image.h>
+#include "Platform/OpenGL/OpenGLStateCache.h"
 
 namespace ZeoEngine {
+
+	/** Returns false if the number of channels is not supported. */
+	static bool GetTextureFormats(uint32_t channels, GLenum& outInternalFormat, GLenum& outDataFormat)
+	{
+		switch (channels)
+		{
+		case 3:
+			outInternalFormat = GL_RGB8;
+			outDataFormat = GL_RGB;
+			return true;
+		case 4:
+			outInternalFormat = GL_RGBA8;
+			outDataFormat = GL_RGBA;
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	static GLenum TextureFilterToOpenGLFilter(TextureFilter filter)
+	{
+		switch (filter)
+		{
+		case TextureFilter::Nearest:
+			return GL_NEAREST;
+		case TextureFilter::Linear:
+			return GL_LINEAR;
+		}
+
+		ZE_CORE_ASSERT(false, "Unknown TextureFilter!");
+		return GL_LINEAR;
+	}
+
 	OpenGLTexture2D::OpenGLTexture2D(uint32_t width, uint32_t height)
 		: m_Width(width), m_Height(height)
 	{
@@ -12,14 +45,7 @@ namespace ZeoEngine {
 		m_InternalFormat = GL_RGBA8;
 		m_DataFormat = GL_RGBA;
 
-		glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
-		// Allocate memory on the GPU to store the data
-		glTextureStorage2D(m_RendererID, 1, m_InternalFormat, m_Width, m_Height);
-
-		glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		CreateStorage();
 	}
 
 	OpenGLTexture2D::OpenGLTexture2D(const std::string& path)
@@ -27,48 +53,22 @@ namespace ZeoEngine {
 	{
 		ZE_PROFILE_FUNCTION();
 
-		stbi_set_flip_vertically_on_load(1);
-		int width, height, channels;
-		stbi_uc* data = nullptr;
-		{
-			ZE_PROFILE_SCOPE("stbi_load - OpenGLTexture2D::OpenGLTexture2D(const std::string&)");
-
-			data = stbi_load(path.c_str(), &width, &height, &channels, 0);
-		}
-		ZE_CORE_ASSERT(data, "Failed to load image!");
-		m_Width = width;
-		m_Height = height;
+		ImageData image = ImageData::Load(path);
+		ZE_CORE_ASSERT(image.IsValid(), "Failed to load image!");
+		m_Width = image.Width;
+		m_Height = image.Height;
 
 		GLenum internalFormat = 0, dataFormat = 0;
-		switch (channels)
-		{
-		case 3:
-			internalFormat = GL_RGB8;
-			dataFormat = GL_RGB;
-			break;
-		case 4:
-			internalFormat = GL_RGBA8;
-			dataFormat = GL_RGBA;
-			break;
-		default:
-			ZE_CORE_ASSERT(internalFormat & dataFormat, "Texture format not supported!");
-		}
+		bool bSupported = GetTextureFormats(image.Channels, internalFormat, dataFormat);
+		ZE_CORE_ASSERT(bSupported, "Texture format not supported!");
 
 		m_InternalFormat = internalFormat;
 		m_DataFormat = dataFormat;
+		m_bTranslucent = image.HasTranslucentPixels();
 
-		glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
-		// Allocate memory on the GPU to store the data
-		glTextureStorage2D(m_RendererID, 1, m_InternalFormat, m_Width, m_Height);
-		
-		glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		CreateStorage();
 
-		glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE, data);
-
-		stbi_image_free(data);
+		glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE, image.Pixels.data());
 	}
 
 	OpenGLTexture2D::~OpenGLTexture2D()
@@ -76,6 +76,19 @@ namespace ZeoEngine {
 		ZE_PROFILE_FUNCTION();
 
 		glDeleteTextures(1, &m_RendererID);
+		OpenGLStateCache::OnTextureDeleted(m_RendererID);
+	}
+
+	void OpenGLTexture2D::CreateStorage()
+	{
+		glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
+		// Allocate memory on the GPU to store the data
+		glTextureStorage2D(m_RendererID, 1, m_InternalFormat, m_Width, m_Height);
+
+		glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, m_MinFilter);
+		glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, m_MagFilter);
+		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
 	}
 
 	void OpenGLTexture2D::SetData(void* data, uint32_t size)
@@ -85,14 +98,50 @@ namespace ZeoEngine {
 		// Bytes per pixel
 		uint32_t bpp = m_DataFormat == GL_RGBA ? 4 : 3;
 		ZE_CORE_ASSERT(size == m_Width * m_Height * bpp, "Data must be entire texture!");
+		m_bTranslucent = ImageData::HasTranslucentPixels(static_cast<const uint8_t*>(data), m_Width * m_Height, bpp);
 		glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE, data);
 	}
 
+	void OpenGLTexture2D::Reload(const ImageData& image)
+	{
+		ZE_PROFILE_FUNCTION();
+
+		GLenum internalFormat = 0, dataFormat = 0;
+		if (!image.IsValid() || !GetTextureFormats(image.Channels, internalFormat, dataFormat))
+		{
+			ZE_CORE_ERROR("Failed to reload texture: '{0}'", m_Path);
+			return;
+		}
+
+		// Storage is immutable, so a new texture is required if size or format has changed
+		if (image.Width != m_Width || image.Height != m_Height || internalFormat != m_InternalFormat)
+		{
+			glDeleteTextures(1, &m_RendererID);
+			OpenGLStateCache::OnTextureDeleted(m_RendererID);
+			m_Width = image.Width;
+			m_Height = image.Height;
+			m_InternalFormat = internalFormat;
+			CreateStorage();
+		}
+		m_DataFormat = dataFormat;
+		m_bTranslucent = image.HasTranslucentPixels();
+
+		glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE, image.Pixels.data());
+	}
+
+	void OpenGLTexture2D::SetFilter(TextureFilter minFilter, TextureFilter magFilter)
+	{
+		m_MinFilter = TextureFilterToOpenGLFilter(minFilter);
+		m_MagFilter = TextureFilterToOpenGLFilter(magFilter);
+		glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, m_MinFilter);
+		glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, m_MagFilter);
+	}
+
 	void OpenGLTexture2D::Bind(uint32_t slot) const
 	{
 		ZE_PROFILE_FUNCTION();
 
-		glBindTextureUnit(slot, m_RendererID);
+		OpenGLStateCache::BindTextureUnit(slot, m_RendererID);
 	}
 
 }
@@ -20,12 +20,29 @@ namespace ZeoEngine {
 
 		virtual void Bind(uint32_t slot = 0) const override;
 
+		virtual void SetFilter(TextureFilter minFilter, TextureFilter magFilter) override;
+
+		virtual void Reload(const ImageData& image) override;
+
+		virtual bool IsTranslucent() const override { return m_bTranslucent; }
+
+		virtual bool operator==(const Texture& other) const override
+		{
+			return m_RendererID == ((OpenGLTexture2D&)other).m_RendererID;
+		}
+
+	private:
+		/** Create the GPU texture with current size and format. */
+		void CreateStorage();
+
 	private:
 		/** Intended for hot-reloading */
 		std::string m_Path;
 		uint32_t m_Width, m_Height;
 		uint32_t m_RendererID;
 		GLenum m_InternalFormat, m_DataFormat;
+		GLenum m_MinFilter = GL_LINEAR, m_MagFilter = GL_NEAREST;
+		bool m_bTranslucent = false;
 	};
 
 }
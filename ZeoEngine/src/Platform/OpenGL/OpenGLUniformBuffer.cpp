@@ -0,0 +1,44 @@
+#include "ZEpch.h"
+#include "Platform/OpenGL/OpenGLUniformBuffer.h"
+
+#include <glad/glad.h>
+
+namespace ZeoEngine {
+
+	OpenGLUniformBuffer::OpenGLUniformBuffer(uint32_t size, UniformBufferBinding binding)
+		: m_Size(size)
+		, m_Binding(binding)
+	{
+		ZE_PROFILE_FUNCTION();
+
+		glCreateBuffers(1, &m_RendererID);
+		glNamedBufferData(m_RendererID, size, nullptr, GL_DYNAMIC_DRAW);
+		Bind();
+	}
+
+	OpenGLUniformBuffer::~OpenGLUniformBuffer()
+	{
+		ZE_PROFILE_FUNCTION();
+
+		glDeleteBuffers(1, &m_RendererID);
+	}
+
+	void OpenGLUniformBuffer::SetData(const void* data, uint32_t size, uint32_t offset)
+	{
+		ZE_PROFILE_FUNCTION();
+
+		ZE_CORE_ASSERT(offset + size <= m_Size, "Data exceeds uniform buffer size!");
+		glNamedBufferSubData(m_RendererID, offset, size, data);
+	}
+
+	void OpenGLUniformBuffer::Bind() const
+	{
+		glBindBufferBase(GL_UNIFORM_BUFFER, static_cast<GLuint>(m_Binding), m_RendererID);
+	}
+
+	void OpenGLUniformBuffer::BindRange(UniformBufferBinding binding, uint32_t offset, uint32_t size) const
+	{
+		glBindBufferRange(GL_UNIFORM_BUFFER, static_cast<GLuint>(binding), m_RendererID, offset, size);
+	}
+
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Engine/Renderer/UniformBuffer.h"
+
+namespace ZeoEngine {
+
+	class OpenGLUniformBuffer : public UniformBuffer
+	{
+	public:
+		OpenGLUniformBuffer(uint32_t size, UniformBufferBinding binding);
+		virtual ~OpenGLUniformBuffer();
+
+		virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) override;
+
+		virtual void Bind() const override;
+		virtual void BindRange(UniformBufferBinding binding, uint32_t offset, uint32_t size) const override;
+
+		virtual uint32_t GetSize() const override { return m_Size; }
+
+	private:
+		uint32_t m_RendererID;
+		uint32_t m_Size;
+		UniformBufferBinding m_Binding;
+
+	};
+
+}
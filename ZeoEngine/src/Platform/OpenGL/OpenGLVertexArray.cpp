@@ -3,6 +3,8 @@
 
 #include <glad/glad.h>
 
+#include "Platform/OpenGL/OpenGLStateCache.h"
+
 namespace ZeoEngine {
 
 	static GLenum ShaderDataTypeToOpenGLBaseType(ShaderDataType type)
@@ -23,6 +25,18 @@ namespace ZeoEngine {
 			return GL_INT;
 		case ShaderDataType::Bool:
 			return GL_BOOL;
+		case ShaderDataType::UByte4:
+			return GL_UNSIGNED_BYTE;
+		case ShaderDataType::Half:
+		case ShaderDataType::Half2:
+		case ShaderDataType::Half4:
+			return GL_HALF_FLOAT;
+		case ShaderDataType::Short2:
+			return GL_SHORT;
+		case ShaderDataType::UShort2:
+			return GL_UNSIGNED_SHORT;
+		case ShaderDataType::Int10_10_10_2:
+			return GL_INT_2_10_10_10_REV;
 		default:
 			ZE_CORE_ASSERT(false, "Unknown ShaderDataType!");
 			return 0;
@@ -41,44 +55,45 @@ namespace ZeoEngine {
 		ZE_PROFILE_FUNCTION();
 
 		glDeleteVertexArrays(1, &m_RendererID);
+		OpenGLStateCache::OnVertexArrayDeleted(m_RendererID);
 	}
 
 	void OpenGLVertexArray::Bind() const
 	{
 		ZE_PROFILE_FUNCTION();
 
-		glBindVertexArray(m_RendererID);
+		OpenGLStateCache::BindVertexArray(m_RendererID);
 	}
 
 	void OpenGLVertexArray::Unbind() const
 	{
 		ZE_PROFILE_FUNCTION();
 
-		glBindVertexArray(0);
+		OpenGLStateCache::BindVertexArray(0);
 	}
 
 	void OpenGLVertexArray::AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer)
 	{
 		ZE_PROFILE_FUNCTION();
 
-		glBindVertexArray(m_RendererID);
+		OpenGLStateCache::BindVertexArray(m_RendererID);
 		vertexBuffer->Bind();
 
-		ZE_CORE_ASSERT(vertexBuffer->GetLayout().GetElements().size(), "Vertex Buffer has no layout!");
+		ZE_CORE_ASSERT(vertexBuffer->GetLayout().GetElementCount(), "Vertex Buffer has no layout!");
 
 		const auto& layout = vertexBuffer->GetLayout();
-		const auto& elements = layout.GetElements();
-		for (uint32_t i = 0; i < elements.size(); ++i)
+		uint32_t index = 0;
+		for (const auto& element : layout)
 		{
-			const auto& element = elements[i];
 			// TODO: There may be a issue when adding multiple VertexBuffers. It was all adding them on top of each other instead of after each other.
-			glEnableVertexAttribArray(i);
-			glVertexAttribPointer(i,
+			glEnableVertexAttribArray(index);
+			glVertexAttribPointer(index,
 				element.GetComponentCount(),
 				ShaderDataTypeToOpenGLBaseType(element.Type),
 				element.bNormalized ? GL_TRUE : GL_FALSE,
 				layout.GetStride(),
 				(const void*)element.Offset);
+			++index;
 		}
 
 		m_VBOs.push_back(vertexBuffer);
@@ -88,7 +103,7 @@ namespace ZeoEngine {
 	{
 		ZE_PROFILE_FUNCTION();
 
-		glBindVertexArray(m_RendererID);
+		OpenGLStateCache::BindVertexArray(m_RendererID);
 		indexBuffer->Bind();
 
 		m_IBO = indexBuffer;
@@ -0,0 +1,103 @@
+#include "ZEpch.h"
+#include "Platform/Windows/WindowsFileWatcher.h"
+
+#ifdef ZE_PLATFORM_WINDOWS
+
+namespace ZeoEngine {
+
+	WindowsFileWatcher::WindowsFileWatcher(const std::string& directory, const FileChangedCallback& callback)
+		: m_Directory(directory), m_Callback(callback)
+	{
+		ZE_PROFILE_FUNCTION();
+
+		m_DirectoryHandle = CreateFileA(directory.c_str(), FILE_LIST_DIRECTORY,
+			FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+			OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+		if (m_DirectoryHandle == INVALID_HANDLE_VALUE)
+		{
+			ZE_CORE_ERROR("Could not watch directory: '{0}'", directory);
+			m_StopEvent = nullptr;
+			return;
+		}
+
+		m_StopEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+		m_Thread = std::thread(&WindowsFileWatcher::WatchLoop, this);
+	}
+
+	WindowsFileWatcher::~WindowsFileWatcher()
+	{
+		ZE_PROFILE_FUNCTION();
+
+		if (m_DirectoryHandle == INVALID_HANDLE_VALUE)
+			return;
+
+		SetEvent(m_StopEvent);
+		m_Thread.join();
+		CloseHandle(m_StopEvent);
+		CloseHandle(m_DirectoryHandle);
+	}
+
+	void WindowsFileWatcher::WatchLoop()
+	{
+		// Notifications are DWORD aligned
+		alignas(DWORD) BYTE buffer[16 * 1024];
+		OVERLAPPED overlapped = {};
+		overlapped.hEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+
+		while (true)
+		{
+			ResetEvent(overlapped.hEvent);
+			if (!ReadDirectoryChangesW(m_DirectoryHandle, buffer, sizeof(buffer), TRUE,
+				FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE,
+				nullptr, &overlapped, nullptr))
+			{
+				ZE_CORE_ERROR("Failed to read directory changes of '{0}'!", m_Directory);
+				break;
+			}
+
+			HANDLE handles[2] = { overlapped.hEvent, m_StopEvent };
+			DWORD result = WaitForMultipleObjects(2, handles, FALSE, INFINITE);
+			if (result != WAIT_OBJECT_0)
+			{
+				// Wait for the cancelled request to complete before the buffer goes out of scope
+				CancelIoEx(m_DirectoryHandle, &overlapped);
+				DWORD ignored;
+				GetOverlappedResult(m_DirectoryHandle, &overlapped, &ignored, TRUE);
+				break;
+			}
+
+			DWORD bytesTransferred = 0;
+			GetOverlappedResult(m_DirectoryHandle, &overlapped, &bytesTransferred, FALSE);
+			// The buffer overflowed and changes are lost
+			if (bytesTransferred == 0)
+				continue;
+
+			const BYTE* entry = buffer;
+			while (true)
+			{
+				const FILE_NOTIFY_INFORMATION* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(entry);
+				if (info->Action == FILE_ACTION_MODIFIED || info->Action == FILE_ACTION_ADDED || info->Action == FILE_ACTION_RENAMED_NEW_NAME)
+				{
+					// FileNameLength is in bytes and the name is not NULL terminated
+					int nameLength = static_cast<int>(info->FileNameLength / sizeof(WCHAR));
+					int size = WideCharToMultiByte(CP_UTF8, 0, info->FileName, nameLength, nullptr, 0, nullptr, nullptr);
+					std::string relativePath(size, '\0');
+					WideCharToMultiByte(CP_UTF8, 0, info->FileName, nameLength, &relativePath[0], size, nullptr, nullptr);
+					std::replace(relativePath.begin(), relativePath.end(), '\\', '/');
+
+					m_Callback(m_Directory + "/" + relativePath);
+				}
+
+				if (info->NextEntryOffset == 0)
+					break;
+
+				entry += info->NextEntryOffset;
+			}
+		}
+
+		CloseHandle(overlapped.hEvent);
+	}
+
+}
+
+#endif // ZE_PLATFORM_WINDOWS
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Engine/Core/FileWatcher.h"
+
+namespace ZeoEngine {
+
+	class WindowsFileWatcher : public FileWatcher
+	{
+	public:
+		WindowsFileWatcher(const std::string& directory, const FileChangedCallback& callback);
+		virtual ~WindowsFileWatcher();
+
+	private:
+		void WatchLoop();
+
+	private:
+		std::string m_Directory;
+		FileChangedCallback m_Callback;
+
+		void* m_DirectoryHandle;
+		/** Signaled to wake up the watcher thread on destruction */
+		void* m_StopEvent;
+		std::thread m_Thread;
+
+	};
+
+}
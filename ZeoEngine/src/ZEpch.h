@@ -15,6 +15,7 @@
 
 #include "Engine/Core/Log.h"
 #include "Engine/Debug/Instrumentor.h"
+#include "Engine/Debug/MemoryTracker.h"
 
 #ifdef ZE_PLATFORM_WINDOWS
 	#include <Windows.h>
@@ -9,6 +9,7 @@
 #include "Engine/Core/Log.h"
 
 #include "Engine/Core/DeltaTime.h"
+#include "Engine/Core/FrameAllocator.h"
 
 #include "Engine/Core/Input.h"
 #include "Engine/Core/KeyCodes.h"
@@ -16,16 +17,33 @@
 #include "Engine/Renderer/OrthographicCameraController.h"
 
 #include "Engine/ImGui/ImGuiLayer.h"
+#include "Engine/ImGui/MemoryPanel.h"
+
+#include "Engine/Scene/Scene.h"
+#include "Engine/Scene/Entity.h"
+#include "Engine/Scene/Components.h"
+#include "Engine/Scene/SystemScheduler.h"
+#include "Engine/Scene/SpatialIndex.h"
 
 // ---Renderer-----------------------------------
 #include "Engine/Renderer/RenderCommand.h"
 #include "Engine/Renderer/Renderer.h"
 #include "Engine/Renderer/Renderer2D.h"
+#include "Engine/Renderer/Culling2D.h"
 
 #include "Engine/Renderer/Buffer.h"
 #include "Engine/Renderer/Shader.h"
 #include "Engine/Renderer/Texture.h"
+#include "Engine/Renderer/UniformBuffer.h"
+#include "Engine/Renderer/SubTexture2D.h"
+#include "Engine/Renderer/Font.h"
+#include "Engine/Renderer/Tilemap.h"
+#include "Engine/Renderer/ParticleSystem.h"
 #include "Engine/Renderer/VertexArray.h"
 
 #include "Engine/Renderer/OrthographicCamera.h"
 // ----------------------------------------------
+
+// ---Physics------------------------------------
+#include "Engine/Physics/PhysicsWorld2D.h"
+// ----------------------------------------------
@@ -1,3 +1,9 @@
+newoption
+{
+	trigger = "track-memory",
+	description = "Replace global operator new/delete to collect per-tag heap statistics"
+}
+
 workspace "ZeoEngine"
 	architecture "x64"
 	startproject "Sandbox"
@@ -14,6 +20,12 @@ workspace "ZeoEngine"
 		"MultiProcessorCompile"
 	}
 
+	-- Engine and application must agree on it as it changes what ZE_MEMORY_TAG expands to
+	filter "options:track-memory"
+		defines "ZE_TRACK_MEMORY"
+
+	filter {}
+
 -- Debug-Windows-x64
 outputdir = "%{cfg.buildcfg}-%{cfg.system}-%{cfg.architecture}"
 